@@ -0,0 +1,380 @@
+/** @file gismo_bench.cpp
+
+    @brief Micro- and macrobenchmarks of core kernels of G+Smo.
+
+    Run with -o <file> to write the timings as JSON, and with -f
+    <substring> to run only the benchmarks whose name contains the
+    substring (eg. -f micro).
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "gsBenchmark.h"
+#include <gsAssembler/gsAdaptiveRefUtils.h>
+
+using namespace gismo;
+
+namespace {
+
+// 5-point Laplacian on a n x n grid
+gsSparseMatrix<> laplacian2d(const index_t n)
+{
+    gsSparseEntries<> entries;
+    entries.reserve(5*n*n);
+    for (index_t j = 0; j != n; ++j)
+        for (index_t i = 0; i != n; ++i)
+        {
+            const index_t k = j*n + i;
+            entries.add(k, k, 4);
+            if (i > 0  ) entries.add(k, k-1, -1);
+            if (i < n-1) entries.add(k, k+1, -1);
+            if (j > 0  ) entries.add(k, k-n, -1);
+            if (j < n-1) entries.add(k, k+n, -1);
+        }
+    gsSparseMatrix<> A(n*n, n*n);
+    A.setFrom(entries);
+    A.makeCompressed();
+    return A;
+}
+
+// 1D stiffness matrix (tridiagonal) of size n
+gsSparseMatrix<> laplacian1d(const index_t n)
+{
+    gsSparseEntries<> entries;
+    entries.reserve(3*n);
+    for (index_t i = 0; i != n; ++i)
+    {
+        entries.add(i, i, 2);
+        if (i > 0  ) entries.add(i, i-1, -1);
+        if (i < n-1) entries.add(i, i+1, -1);
+    }
+    gsSparseMatrix<> A(n, n);
+    A.setFrom(entries);
+    A.makeCompressed();
+    return A;
+}
+
+std::string str(const index_t n) { return util::to_string(n); }
+
+void microBenchmarks(gsBenchmark & bench, const index_t scale)
+{
+    // gsBSplineBasis::evalAllDers_into
+    {
+        const index_t np = 10000 * scale;
+        gsKnotVector<> kv(0, 1, 100, 4, 1, 3);
+        gsBSplineBasis<> b(kv);
+        const gsMatrix<> u = gsPointGrid<real_t>(0, 1, np);
+        std::vector<gsMatrix<> > res;
+        bench.run("micro/evalAllDers", "p=3, n=2, pts=" + str(np), np,
+                  [&]() { b.evalAllDers_into(u, 2, res); });
+    }
+
+    // gsTHBSplineBasis::eval_into
+    {
+        gsKnotVector<> kv(0, 1, 15, 3, 1, 2);
+        gsTensorBSplineBasis<2> tb(kv, kv);
+        gsTHBSplineBasis<2> thb(tb);
+        gsMatrix<> boxes(2, 4);
+        boxes << 0, 0.5, 0.25, 0.5,
+                 0, 0.5, 0.25, 0.5;
+        thb.refine(boxes);
+        boxes << 0, 0.25, 0.125, 0.25,
+                 0, 0.25, 0.125, 0.25;
+        thb.refine(boxes);
+        const gsMatrix<> u = gsPointGrid<real_t>(thb.support(), 2000 * scale);
+        gsMatrix<> res;
+        bench.run("micro/thbEval", "p=2, levels=3, pts=" + str(u.cols()), u.cols(),
+                  [&]() { thb.eval_into(u, res); });
+    }
+
+    // gsSparseSystem::push
+    {
+        gsKnotVector<> kv(0, 1, 31 * scale, 3, 1, 2);
+        gsTensorBSplineBasis<2> tb(kv, kv);
+        gsDofMapper mapper(tb);
+        mapper.finalize();
+        gsSparseSystem<> sys(mapper);
+        sys.reserve(25, 1);
+
+        // active functions of every element, mapped to the system
+        std::vector<gsMatrix<index_t> > act;
+        typename gsBasis<>::domainIter domIt = tb.makeDomainIterator();
+        for (; domIt->good(); domIt->next())
+        {
+            act.push_back(gsMatrix<index_t>());
+            tb.active_into(domIt->centerPoint(), act.back());
+            sys.mapColIndices(act.back(), 0, act.back());
+        }
+        const index_t na = act.front().rows();
+        const gsMatrix<> localMat = gsMatrix<>::Random(na, na);
+        const gsMatrix<> localRhs = gsMatrix<>::Random(na, 1);
+        const gsMatrix<> eliminated(0, 1);
+        bench.run("micro/sparseSystemPush", "p=2, elements=" + str(act.size()), act.size(),
+                  [&]()
+                  {
+                      sys.setZero();
+                      for (size_t e = 0; e != act.size(); ++e)
+                          sys.push(localMat, localRhs, act[e], eliminated);
+                  });
+    }
+
+    // gsKroneckerOp::apply
+    {
+        const index_t n = 100 * scale;
+        gsLinearOperator<>::Ptr A = makeMatrixOp(laplacian1d(n).moveToPtr());
+        gsKroneckerOp<> K(A, A, A);
+        const gsMatrix<> x = gsMatrix<>::Random(n*n*n, 1);
+        gsMatrix<> y;
+        bench.run("micro/kroneckerApply", "3 x " + str(n), n*n*n,
+                  [&]() { K.apply(x, y); });
+    }
+
+    // Sparse matrix-vector product and Gauss-Seidel sweeps
+    {
+        const index_t n = 300 * scale;
+        const gsSparseMatrix<> A = laplacian2d(n);
+        const gsMatrix<> x = gsMatrix<>::Random(n*n, 1);
+        gsMatrix<> y;
+        bench.run("micro/spmv", "5-point, n=" + str(n*n), A.nonZeros(),
+                  [&]() { y.noalias() = A * x; });
+
+        gsPreconditionerOp<>::Ptr gs = makeGaussSeidelOp(A);
+        gsMatrix<> z = gsMatrix<>::Zero(n*n, 1);
+        bench.run("micro/gaussSeidelSweep", "5-point, n=" + str(n*n), A.nonZeros(),
+                  [&]() { gs->step(x, z); });
+    }
+}
+
+void macroBenchmarks(gsBenchmark & bench, const index_t scale)
+{
+    // Poisson with CG preconditioned by multigrid
+    {
+        gsMultiPatch<> mp;
+        gsReadFile<>("domain2d/yeti_mp2.xml", mp);
+        gsMultiBasis<> mb(mp);
+        const index_t levels = 3 + (scale > 1 ? 1 : 0);
+        for (index_t i = 0; i != levels; ++i)
+            mb.uniformRefine();
+
+        gsConstantFunction<> one(1.0, 2);
+        gsBoundaryConditions<> bc;
+        for (gsMultiPatch<>::const_biterator it = mp.bBegin(); it < mp.bEnd(); ++it)
+            bc.addCondition(*it, condition_type::dirichlet, &one);
+
+        gsPoissonAssembler<> assembler(mp, mb, bc, one, dirichlet::elimination, iFace::glue);
+        bench.run("macro/poissonAssemble", "yeti_mp2, dofs=" + str(assembler.numDofs()),
+                  assembler.numDofs(), [&]() { assembler.assemble(); });
+        if ( !bench.selected("macro/poissonAssemble") )
+            assembler.assemble();
+
+        gsOptionList opt = gsGridHierarchy<>::defaultOptions();
+        opt.setInt("Levels", levels);
+        std::vector< gsSparseMatrix<real_t,RowMajor> > transfer;
+        gsGridHierarchy<>::buildByCoarsening(mb, bc, opt)
+            .moveTransferMatricesTo(transfer).clear();
+        gsMultiGridOp<>::Ptr mg = gsMultiGridOp<>::make(assembler.matrix(), transfer);
+        for (index_t i = 1; i < mg->numLevels(); ++i)
+            mg->setSmoother(i, makeGaussSeidelOp(mg->matrix(i)));
+
+        gsMatrix<> x;
+        bench.run("macro/poissonCgMg", "yeti_mp2, dofs=" + str(assembler.numDofs()),
+                  assembler.numDofs(),
+                  [&]()
+                  {
+                      x.setZero(assembler.numDofs(), 1);
+                      gsConjugateGradient<> cg(assembler.matrix(), mg);
+                      cg.setTolerance(1e-8);
+                      cg.solve(assembler.rhs(), x);
+                  });
+
+        // The same, with the multigrid cycles in single precision
+        std::vector< gsSparseMatrix<float,RowMajor> > transferF;
+        for (size_t i = 0; i != transfer.size(); ++i)
+            transferF.push_back( transfer[i].cast<float>() );
+        gsMultiGridOp<float>::Ptr mgF = gsMultiGridOp<float>::make(
+            gsSparseMatrix<float>(assembler.matrix().cast<float>()), transferF);
+        for (index_t i = 1; i < mgF->numLevels(); ++i)
+            mgF->setSmoother(i, makeGaussSeidelOp(mgF->matrix(i)));
+        const gsLinearOperator<>::Ptr mgMixed = gsMixedPrecisionOp<real_t,float>::make(mgF);
+        bench.run("macro/poissonCgMgMixed", "yeti_mp2, dofs=" + str(assembler.numDofs()),
+                  assembler.numDofs(),
+                  [&]()
+                  {
+                      x.setZero(assembler.numDofs(), 1);
+                      gsConjugateGradient<> cg(assembler.matrix(), mgMixed);
+                      cg.setTolerance(1e-8);
+                      cg.solve(assembler.rhs(), x);
+                  });
+
+        // Sparse Cholesky, and iterative refinement of a Cholesky
+        // factorization in single precision, to the same accuracy
+        bench.run("macro/poissonCholesky", "yeti_mp2, dofs=" + str(assembler.numDofs()),
+                  assembler.numDofs(),
+                  [&]()
+                  {
+                      gsSparseSolver<>::SimplicialLDLT solver(assembler.matrix());
+                      x = solver.solve(assembler.rhs());
+                  });
+        bench.run("macro/poissonCholeskyMixed", "yeti_mp2, dofs=" + str(assembler.numDofs()),
+                  assembler.numDofs(),
+                  [&]()
+                  {
+                      x.setZero(assembler.numDofs(), 1);
+                      gsGradientMethod<> ir(assembler.matrix(),
+                          makeMixedPrecisionSparseCholeskySolver<float>(assembler.matrix()), 1);
+                      ir.setTolerance(1e-8);
+                      ir.solve(assembler.rhs(), x);
+                  });
+    }
+
+    // Orderings of the dofs: matrix-vector products, Gauss-Seidel
+    // sweeps and sparse LU on a 3D multi-patch
+    {
+        gsMultiPatch<> mp;
+        gsReadFile<>("volumes/fichera.xml", mp);
+        gsMultiBasis<> mb(mp);
+        for (index_t i = 0; i != 2 + scale; ++i)
+            mb.uniformRefine();
+
+        gsConstantFunction<> one(1.0, 3);
+        gsBoundaryConditions<> bc;
+        for (gsMultiPatch<>::const_biterator it = mp.bBegin(); it < mp.bEnd(); ++it)
+            bc.addCondition(*it, condition_type::dirichlet, &one);
+
+        const char * names[] = {"natural", "rcm", "sfc"};
+        for (index_t o = dofOrdering::natural; o <= dofOrdering::sfc; ++o)
+        {
+            gsPoissonAssembler<> assembler(mp, mb, bc, one, dirichlet::elimination, iFace::glue);
+            assembler.options().setInt("DofOrdering", o);
+            assembler.refresh();
+            assembler.assemble();
+            const gsSparseMatrix<> A = assembler.matrix().selfadjointView<Lower>();
+            const std::string info = "fichera, dofs=" + str(assembler.numDofs());
+            const gsMatrix<> b = assembler.rhs();
+            gsMatrix<> x, y;
+
+            bench.run("macro/orderSpmv_" + std::string(names[o]), info, A.nonZeros(),
+                      [&]() { y.noalias() = A * b; });
+            bench.run("macro/orderGS_" + std::string(names[o]), info, A.nonZeros(),
+                      [&]()
+                      {
+                          x.setZero(A.rows(), 1);
+                          for (index_t i = 0; i != 10; ++i)
+                              internal::gaussSeidelSweep<real_t>(A, x, b);
+                      });
+            bench.run("macro/orderLU_" + std::string(names[o]), info, A.rows(),
+                      [&]()
+                      {
+                          gsSparseSolver<>::LU solver(A);
+                          x = solver.solve(b);
+                      });
+        }
+    }
+
+    // THB adaptive cycles: solve, estimate the error, refine
+    {
+        gsMultiPatch<> mp;
+        gsReadFile<>("planar/lshape2d_3patches_thb.xml", mp);
+        mp.computeTopology();
+        gsFunctionExpr<> g("if( y>0, ( (x^2+y^2)^(1.0/3.0) )*sin( (2*atan2(y,x) - pi)/3.0 ),"
+                           " ( (x^2+y^2)^(1.0/3.0) )*sin( (2*atan2(y,x)+3*pi)/3.0 ) )", 2);
+        gsFunctionExpr<> f("0", 2);
+        gsBoundaryConditions<> bc;
+        for (gsMultiPatch<>::const_biterator it = mp.bBegin(); it != mp.bEnd(); ++it)
+            bc.addCondition(*it, condition_type::dirichlet, &g);
+
+        const index_t cycles = 3 + scale;
+        bench.run("macro/thbAdaptive", "lshape, cycles=" + str(cycles), cycles,
+                  [&]()
+                  {
+                      gsMultiBasis<> mb(mp);
+                      mb.uniformRefine();
+                      for (index_t c = 0; c != cycles; ++c)
+                      {
+                          gsPoissonAssembler<> A(mp, mb, bc, f);
+                          A.assemble();
+                          gsSparseSolver<>::CGDiagonal solver(A.matrix());
+                          const gsMatrix<> sol = solver.solve(A.rhs());
+                          gsMultiPatch<> uh;
+                          A.constructSolution(sol, uh);
+
+                          gsExprEvaluator<> ev;
+                          ev.setIntegrationElements(mb);
+                          gsExprEvaluator<>::geometryMap G = ev.getMap(mp);
+                          gsExprEvaluator<>::variable u = ev.getVariable(uh);
+                          gsExprEvaluator<>::variable ex = ev.getVariable(g, G);
+                          ev.integralElWise((igrad(u, G) - igrad(ex)).sqNorm() * meas(G));
+
+                          std::vector<bool> marked;
+                          gsMarkElementsForRef(ev.elementwise(), PUCA, 0.9, marked);
+                          gsRefineMarkedElements(mb, marked, 1);
+                          mb.repairInterfaces(mp.interfaces());
+                      }
+                  });
+    }
+
+    // XML write and read of a refined multi-patch
+    {
+        gsMultiPatch<> mp;
+        gsReadFile<>("domain2d/yeti_mp2.xml", mp);
+        for (index_t i = 0; i != 3 + scale; ++i)
+            mp.uniformRefine();
+        index_t nc = 0;
+        for (size_t i = 0; i != mp.nPatches(); ++i)
+            nc += mp.patch(i).coefs().rows();
+        const std::string fn = gsFileManager::getTempPath() + "gismo_bench_io";
+        bench.run("macro/xmlWrite", "yeti_mp2, coefs=" + str(nc), nc,
+                  [&]()
+                  {
+                      gsFileData<> fd;
+                      fd << mp;
+                      fd.save(fn);
+                  });
+        gsMultiPatch<> mp2;
+        bench.run("macro/xmlRead", "yeti_mp2, coefs=" + str(nc), nc,
+                  [&]()
+                  {
+                      gsFileData<> fd(fn + ".xml");
+                      fd.getFirst(mp2);
+                  });
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    index_t runs = 5;
+    index_t scale = 1;
+    std::string filter, output;
+
+    gsCmdLine cmd("Benchmarks of core kernels of G+Smo.");
+    cmd.addInt   ("r", "runs",   "Number of timed runs of every benchmark", runs);
+    cmd.addInt   ("s", "scale",  "Scaling factor of the problem sizes", scale);
+    cmd.addString("f", "filter", "Run only benchmarks whose name contains this string", filter);
+    cmd.addString("o", "output", "Write the results as JSON to this file", output);
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    GISMO_ENSURE(runs > 0 && scale > 0, "The runs and the scale must be positive.");
+
+    gsBenchmark bench(runs, filter);
+    gsInfo << "G+Smo " << GISMO_VERSION << " on " << gsBenchmark::cpuName() << ", "
+           << gsBenchmark::ompThreads() << " thread(s)\n";
+
+    microBenchmarks(bench, scale);
+    macroBenchmarks(bench, scale);
+
+    if (output.empty())
+        bench.printJson(gsInfo);
+    else
+    {
+        std::ofstream os(output.c_str());
+        bench.printJson(os);
+        gsInfo << "Results written to " << output << "\n";
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/** @file gsBenchmark.h
+
+    @brief Helpers for timing benchmark kernels and reporting the
+    results as JSON.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gismo.h>
+
+#include <fstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if __cplusplus >= 201103L || _MSC_VER >= 1600
+#include <thread>
+#endif
+
+namespace gismo
+{
+
+/// @brief Timings of one benchmark
+struct gsBenchmarkResult
+{
+    std::string name;  ///< Name of the benchmark, eg. "micro/spmv"
+    std::string label; ///< Problem size, as a human-readable string
+    index_t     size;  ///< Work per run (points, elements, dofs, ...)
+    index_t     runs;  ///< Number of timed runs
+    real_t      min, median, mean; ///< Wall time per run in seconds
+};
+
+/**
+   @brief Runs a set of benchmarks and collects their timings
+
+   Every kernel is called once to warm up and then \a runs times. The
+   wall time of every run is recorded, and the minimum, median and mean
+   are reported.
+
+   The report contains the version of G+Smo, the processor, the number
+   of hardware threads and the number of OpenMP threads.
+*/
+class gsBenchmark
+{
+public:
+
+    gsBenchmark(const index_t runs, const std::string & filter)
+    : m_runs(runs), m_filter(filter) { }
+
+    /// Returns true iff the benchmark \a name is selected by the filter
+    bool selected(const std::string & name) const
+    { return m_filter.empty() || name.find(m_filter) != std::string::npos; }
+
+    /// Times the kernel \a f, which performs \a size units of work
+    template<class F>
+    void run(const std::string & name, const std::string & label,
+             const index_t size, F f)
+    {
+        if (!selected(name)) return;
+
+        f(); // warm-up
+        std::vector<real_t> times(m_runs);
+        gsStopwatch sw;
+        for (index_t i = 0; i != m_runs; ++i)
+        {
+            sw.restart();
+            f();
+            times[i] = sw.stop();
+        }
+        std::sort(times.begin(), times.end());
+
+        gsBenchmarkResult r;
+        r.name   = name;
+        r.label  = label;
+        r.size   = size;
+        r.runs   = m_runs;
+        r.min    = times.front();
+        r.median = times[m_runs/2];
+        r.mean   = std::accumulate(times.begin(), times.end(), (real_t)0) / m_runs;
+        m_results.push_back(r);
+
+        gsInfo << std::left << std::setw(28) << name << std::setw(24) << label
+               << "min " << r.min << " s, median " << r.median << " s\n";
+    }
+
+    /// Writes the results as a JSON object to \a os
+    std::ostream & printJson(std::ostream & os) const
+    {
+        os << "{\n"
+           << "  \"gismo_version\": \"" << GISMO_VERSION << "\",\n"
+           << "  \"cpu\": \"" << cpuName() << "\",\n"
+           << "  \"hardware_threads\": " << hardwareThreads() << ",\n"
+           << "  \"omp_threads\": " << ompThreads() << ",\n"
+           << "  \"runs\": " << m_runs << ",\n"
+           << "  \"benchmarks\": [";
+        for (size_t i = 0; i != m_results.size(); ++i)
+        {
+            const gsBenchmarkResult & r = m_results[i];
+            os << (i ? ",\n" : "\n")
+               << "    {\"name\": \"" << r.name << "\", \"label\": \"" << r.label
+               << "\", \"size\": " << r.size << ", \"runs\": " << r.runs
+               << ", \"min\": " << r.min << ", \"median\": " << r.median
+               << ", \"mean\": " << r.mean << "}";
+        }
+        os << "\n  ]\n}\n";
+        return os;
+    }
+
+    const std::vector<gsBenchmarkResult> & results() const { return m_results; }
+
+    /// Returns the model name of the processor, if known
+    static std::string cpuName()
+    {
+        std::ifstream in("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(in, line))
+            if (0 == line.compare(0, 10, "model name"))
+            {
+                const size_t p = line.find(':');
+                if (p != std::string::npos && p + 2 <= line.size())
+                    return line.substr(p + 2);
+            }
+        return "unknown";
+    }
+
+    /// Returns the number of hardware threads, or 0 if unknown
+    static index_t hardwareThreads()
+    {
+#       if __cplusplus >= 201103L || _MSC_VER >= 1600
+        return std::thread::hardware_concurrency();
+#       else
+        return 0;
+#       endif
+    }
+
+    /// Returns the number of OpenMP threads used in parallel regions
+    static index_t ompThreads()
+    {
+#       ifdef _OPENMP
+        return omp_get_max_threads();
+#       else
+        return 1;
+#       endif
+    }
+
+private:
+    index_t m_runs;
+    std::string m_filter;
+    std::vector<gsBenchmarkResult> m_results;
+};
+
+} // namespace gismo
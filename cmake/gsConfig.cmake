@@ -44,6 +44,12 @@ endif()
 set_property(CACHE GISMO_COEFF_TYPE PROPERTY STRINGS
 "float" "double" "long double" "mpfr::mpreal" "mpq_class" "posit_32_2")
 
+# Single-precision instances of the solvers, used by mixed-precision
+# solves (see gsMixedPrecisionOp.h)
+if(NOT ${GISMO_COEFF_TYPE} STREQUAL "float")
+  set(GISMO_FLOAT_INSTANCES ON)
+endif()
+
 if(NOT GISMO_INDEX_TYPE)
    set (GISMO_INDEX_TYPE "int" CACHE STRING
    #math(EXPR BITSZ_VOID_P "8*${CMAKE_SIZEOF_VOID_P}")
@@ -74,6 +74,11 @@ if  (${GISMO_EXTRA_DEBUG})
 message ("  GISMO_EXTRA_DEBUG       ${GISMO_EXTRA_DEBUG}")
 endif()
 
+option(GISMO_WITH_PROFILING      "With profiling timers"     false  )
+if  (${GISMO_WITH_PROFILING})
+message ("  GISMO_WITH_PROFILING    ${GISMO_WITH_PROFILING}")
+endif()
+
 option(GISMO_WITH_ADIFF          "With auto-diff"            false  )
 if  (${GISMO_WITH_ADIFF})
 message ("  GISMO_WITH_ADIFF        ${GISMO_WITH_ADIFF}")
@@ -106,6 +106,8 @@ namespace internal
 #include <gsModeling/gsTrimSurface.h>
 #include <gsModeling/gsCurveLoop.h>
 #include <gsModeling/gsPlanarDomain.h>
+#include <gsModeling/gsConstrainedDelaunay.h>
+#include <gsModeling/gsPlanarDomainClassifier.h>
 #include <gsModeling/gsSolid.h> 
 #include <gsUtils/gsMesh/gsMesh.h>
 #include <gsUtils/gsMesh/gsHalfEdgeMesh.h>
@@ -143,6 +145,7 @@ namespace internal
 #include <gsAssembler/gsPoissonAssembler.h>
 #include <gsAssembler/gsCDRAssembler.h>
 #include <gsAssembler/gsHeatEquation.h>
+#include <gsAssembler/gsHeatTimeStepper.h>
 
 #include <gsAssembler/gsExprHelper.h>
 #include <gsAssembler/gsExprAssembler.h>
@@ -162,6 +165,7 @@ namespace internal
 #include <gsSolver/gsSimplePreconditioners.h>
 #include <gsSolver/gsSumOp.h>
 #include <gsSolver/gsKroneckerOp.h>
+#include <gsSolver/gsMixedPrecisionOp.h>
 #include <gsSolver/gsPatchPreconditionersCreator.h>
 #include <gsSolver/gsLanczosMatrix.h>
 
@@ -173,6 +177,7 @@ namespace internal
 #include <gsIO/gsWriteParaview.h>
 #include <gsIO/gsParaviewCollection.h>
 #include <gsIO/gsReadFile.h>
+#include <gsIO/gsPointCloudReader.h>
 #include <gsUtils/gsPointGrid.h>
 #include <gsIO/gsXmlUtils.h>
 
@@ -182,6 +187,7 @@ namespace internal
 /* ----------- Utilities ----------- */
 //#include <gsUtils/gsUtils.h> - in gsForwardDeclarations.h
 #include <gsUtils/gsStopwatch.h>
+#include <gsUtils/gsProfiler.h>
 #include <gsUtils/gsFunctionWithDerivatives.h>
 
 /* ----------- Extension ----------- */
@@ -25,24 +25,78 @@
 
 #include <gsPde/gsPde.h>
 #include <gsPde/gsBoundaryConditions.h>
+#include <gsPde/gsPointLoads.h>
 
 #include <gsAssembler/gsQuadRule.h>
 #include <gsAssembler/gsSparseSystem.h>
 #include <gsAssembler/gsRemapInterface.h>
 
+#include <gsUtils/gsProfiler.h>
+
 
 
 namespace gismo
 {
 
-template <class T>
-void transformGradients(const gsMapData<T> & md, index_t k, const gsMatrix<T>& allGrads, gsMatrix<T>& trfGradsK)
+namespace internal
+{
+
+/// Implementation of transformGradients for a map of fixed
+/// dimensions \a ParDim \f$\to\f$ \a GeoDim
+template <class T, short_t ParDim, short_t GeoDim, class Derived>
+void transformGradients_fixed(const gsMapData<T> & md, index_t k, const gsMatrix<T>& allGrads,
+                              Eigen::MatrixBase<Derived> & trfGradsK)
+{
+    const index_t numGrads = allGrads.rows() / ParDim;
+    const gsAsConstMatrix<T,ParDim,Dynamic> grads_k(allGrads.col(k).data(), ParDim, numGrads);
+
+    // The transformation matrices are already computed by computeMap
+    if (md.flags & NEED_GRAD_TRANSFORM)
+    {
+        trfGradsK.derived().noalias() = gsAsConstMatrix<T,GeoDim,ParDim>(
+            md.fundForms.col(k).data(), GeoDim, ParDim) * grads_k;
+        return;
+    }
+
+    const gsAsConstMatrix<T,ParDim,GeoDim> jacT(md.values[1].col(k).data(), ParDim, GeoDim);
+    if ( ParDim == GeoDim )
+        trfGradsK.derived().noalias() = jacT.inverse() * grads_k;
+    else // pseudo-inverse for maps of codimension one
+        trfGradsK.derived().noalias() =
+            jacT.transpose() * (jacT*jacT.transpose()).inverse() * grads_k;
+}
+
+} // namespace internal
+
+/// Computes the physical gradients at the point \a k. The result
+/// \a trfGradsK is either a gsMatrix, which is resized, or a view
+/// (eg. from a gsWorkspace) of the right size.
+///
+/// For the usual dimensions of curves, surfaces and volumes the
+/// computation uses fixed-size matrices, and the transformation
+/// matrices of \a md if these are computed already
+/// (NEED_GRAD_TRANSFORM).
+template <class T, class Derived>
+void transformGradients(const gsMapData<T> & md, index_t k, const gsMatrix<T>& allGrads,
+                        const Eigen::MatrixBase<Derived> & trfGradsK)
 {
     GISMO_ASSERT(allGrads.rows() % md.dim.first == 0, "Invalid size of gradient matrix");
 
-    const index_t numGrads = allGrads.rows() / md.dim.first;
-    const gsAsConstMatrix<T> grads_k(allGrads.col(k).data(), md.dim.first, numGrads);
-    trfGradsK.noalias() = md.jacobian(k).cramerInverse().transpose() * grads_k;
+    Eigen::MatrixBase<Derived> & result = const_cast<Eigen::MatrixBase<Derived>&>(trfGradsK);
+    switch (10 * md.dim.second + md.dim.first)
+    {
+    case 11: internal::transformGradients_fixed<T,1,1>(md, k, allGrads, result); break;
+    case 21: internal::transformGradients_fixed<T,1,2>(md, k, allGrads, result); break;
+    case 22: internal::transformGradients_fixed<T,2,2>(md, k, allGrads, result); break;
+    case 32: internal::transformGradients_fixed<T,2,3>(md, k, allGrads, result); break;
+    case 33: internal::transformGradients_fixed<T,3,3>(md, k, allGrads, result); break;
+    default:
+    {
+        const index_t numGrads = allGrads.rows() / md.dim.first;
+        const gsAsConstMatrix<T> grads_k(allGrads.col(k).data(), md.dim.first, numGrads);
+        result.derived().noalias() = md.jacobian(k).cramerInverse().transpose() * grads_k;
+    }
+    }
 }
 
 template <class T>
@@ -63,6 +117,14 @@ void normal(const gsMapData<T> & md, index_t k, gsVector<T> & result)
 {
     GISMO_ASSERT( md.dim.first+1 == md.dim.second, "Codimension should be equal to one");
     result.resize(md.dim.first+1);
+
+    // Already computed by computeMap (for curves and surfaces)
+    if ( (md.flags & NEED_NORMAL) && md.dim.second <= 3 )
+    {
+        result = md.normals.col(k);
+        return;
+    }
+
     const gsMatrix<T> Jk = md.jacobian(k);
 
     T alt_sgn(1.0);
@@ -79,7 +141,10 @@ template <class T>
 void outerNormal(const gsMapData<T> & md, index_t k, boxSide s, gsVector<T> & result)
 {
     //todo: fix and check me
-    short_t m_orientation = md.jacobian(k).determinant() >= 0 ? 1 : -1;
+    // (the Jacobian is copied to storage of bounded size, so no heap
+    // allocation occurs)
+    const Eigen::Matrix<T,Dynamic,Dynamic,ColMajor,4,4> Jk = md.jacobian(k);
+    short_t m_orientation = Jk.determinant() >= 0 ? 1 : -1;
 
     const T sgn = sideOrientation(s) * m_orientation; // TODO: fix me
     const short_t dir = s.direction();
@@ -88,10 +153,10 @@ void outerNormal(const gsMapData<T> & md, index_t k, boxSide s, gsVector<T> & re
     result.resize(md.dim.second);
     if (md.dim.first + 1 == md.dim.second) // surface case GeoDim == 3
     {
-        const gsMatrix<T,3,1> Jk = md.jacobian(k).col(!dir);
+        const gsMatrix<T,3,1> Jc = Jk.col(!dir);
         // fixme: generalize to nD
         normal(md, k, result);
-        result = result.template head<3>().normalized().cross(sgn * Jk);
+        result = result.template head<3>().normalized().cross(sgn * Jc);
 
         /*
           gsDebugVar(result.transpose()); // result 1
@@ -118,13 +183,14 @@ void outerNormal(const gsMapData<T> & md, index_t k, boxSide s, gsVector<T> & re
             return;
         } // 1D case
 
-        const gsMatrix<T> Jk = md.jacobian(k);
-
+        const index_t n = md.dim.first - 1;
+        Eigen::Matrix<T,Dynamic,Dynamic,ColMajor,3,3> minor(n, n);
         T alt_sgn = sgn;
-        typename gsMatrix<T>::FirstMinorMatrixType minor;
         for (short_t i = 0; i != md.dim.first; ++i) // for all components of the normal
         {
-            Jk.firstMinor(i, dir, minor);
+            for (index_t c = 0; c != n; ++c)
+                for (index_t r = 0; r != n; ++r)
+                    minor(r, c) = Jk(r < i ? r : r + 1, c < dir ? c : c + 1);
             result[i] = alt_sgn * minor.determinant();
             alt_sgn = -alt_sgn;
         }
@@ -292,6 +358,14 @@ protected: // *** Output data members ***
     /// must fit m_system.colBlocks().
     std::vector<gsMatrix<T> > m_ddof;
 
+    /// Factorized boundary mass matrices of the L2-projection of the
+    /// Dirichlet values, and the lumped masses they correspond to, per
+    /// unknown (see computeDirichletDofsL2Proj). Cleared by
+    /// initialize() and refresh(), since they are only valid for the
+    /// current patches, bases and mapper
+    std::vector<memory::shared_ptr<typename gsSparseSolver<T>::SimplicialLDLT> > m_ddofSolver;
+    std::vector<gsMatrix<T> > m_ddofLumped;
+
 public:
 
     gsAssembler() : m_options(defaultOptions())
@@ -331,6 +405,8 @@ public:
         m_pde_ptr = pde;
         m_bases = bases;
         m_options = opt;
+        m_ddofSolver.clear();
+        m_ddofLumped.clear();
         refresh(); // virtual call to derived
         GISMO_ASSERT( check(), "Something went wrong in assembler initialization");
     }
@@ -353,6 +429,8 @@ public:
         m_bases.clear();
         m_bases.push_back(bases);
         m_options = opt;
+        m_ddofSolver.clear();
+        m_ddofLumped.clear();
         refresh(); // virtual call to derived
         GISMO_ASSERT( check(), "Something went wrong in assembler initialization");
     }
@@ -374,6 +452,8 @@ public:
             m_bases.push_back(gsMultiBasis<T>(basis[c]));
 
         m_options = opt;
+        m_ddofSolver.clear();
+        m_ddofLumped.clear();
         refresh(); // virtual call to derived
         GISMO_ASSERT( check(), "Something went wrong in assembler initialization");
     }
@@ -541,6 +621,9 @@ public:  /* Dirichlet degrees of freedom computation */
 protected:  /* Helpers for Dirichlet degrees of freedom computation */
 
     /// @brief calculates the values of the eliminated dofs based on Interpolation.
+    ///
+    /// The boundary sides are interpolated in parallel; tensor-product
+    /// boundary bases interpolate by coordinate-wise (Kronecker) solves.
     /// \param[in] mapper the dofMapper for the considered unknown
     /// \param[in] mbasis the multipabasis for the considered unknown
     /// \param[in] unk_ the considered unknown
@@ -549,6 +632,12 @@ protected:  /* Helpers for Dirichlet degrees of freedom computation */
                                    const short_t unk_ = 0);
 
     /// @brief calculates the values of the eliminated dofs based on L2 Projection.
+    ///
+    /// The boundary sides are processed in parallel. The factorization
+    /// of the boundary mass matrix is kept and reused as long as the
+    /// lumped boundary mass does not change, therefore computing new
+    /// Dirichlet values on the same discretization (eg. in every time
+    /// step) costs only the right-hand side and a substitution.
     /// \param[in] mapper the dofMapper for the considered unknown
     /// \param[in] mbasis the multipabasis for the considered unknown
     /// \param[in] unk_ the considered unknown
@@ -556,6 +645,16 @@ protected:  /* Helpers for Dirichlet degrees of freedom computation */
                                     const gsMultiBasis<T> & mbasis,
                                     const short_t unk_ = 0);
 
+public:  /* Point loads */
+
+    /// @brief Adds the point loads \a pLoads to the right-hand side of row block \a r
+    ///
+    /// The loads are grouped by patch, and the loads given in physical
+    /// coordinates are inverted with one call per patch. The loads of a
+    /// patch are sorted by element and evaluated in chunks, in parallel.
+    /// Every load value must have one entry per right-hand side column.
+    void assemblePointLoads(const gsPointLoads<T> & pLoads, const index_t r = 0);
+
 public:  /* Solution reconstruction */
 
     /// @brief Construct solution from computed solution vector for a single unknows
@@ -668,6 +767,7 @@ void gsAssembler<T>::apply(ElementVisitor & visitor,
                            boxSide side)
 {
     //gsDebug<< "Apply to patch "<< patchIndex <<"("<< side <<")\n";
+    GISMO_PROFILE("gsAssembler::apply");
 
     const gsBasisRefs<T> bases(m_bases, patchIndex);
 
@@ -704,6 +804,8 @@ void gsAssembler<T>::apply(ElementVisitor & visitor,
     {
         // Map the Quadrature rule to the element
         quRule.mapTo( domIt->lowerCorner(), domIt->upperCorner(), quNodes, quWeights );
+        GISMO_PROFILE_COUNT(elements, 1);
+        GISMO_PROFILE_COUNT(quPoints, quWeights.size());
 
         // Perform required evaluations on the quadrature nodes
         visitor_.evaluate(bases, patch, quNodes);
@@ -725,6 +827,7 @@ template<class InterfaceVisitor>
 void gsAssembler<T>::apply(InterfaceVisitor & visitor,
                            const boundaryInterface & bi)
 {
+    GISMO_PROFILE("gsAssembler::applyInterface");
     gsRemapInterface<T> interfaceMap(m_pde_ptr->patches(), m_bases[0], bi);
 
     const index_t patchIndex1      = bi.first().patch;
@@ -754,6 +857,8 @@ void gsAssembler<T>::apply(InterfaceVisitor & visitor,
         // Compute the quadrature rule on both sides
         quRule.mapTo( domIt->lowerCorner(), domIt->upperCorner(), quNodes1, quWeights);
         interfaceMap.eval_into(quNodes1,quNodes2);
+        GISMO_PROFILE_COUNT(elements, 1);
+        GISMO_PROFILE_COUNT(quPoints, quWeights.size());
 
         // Perform required evaluations on the quadrature nodes
         visitor.evaluate(B1, patch1, B2, patch2, quNodes1, quNodes2);
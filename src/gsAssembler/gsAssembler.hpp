@@ -33,6 +33,7 @@ gsOptionList gsAssembler<T>::defaultOptions()
     opt.addInt("DirichletStrategy", "Method for enforcement of Dirichlet BCs [11..14]", 11 );
     opt.addInt("DirichletValues"  , "Method for computation of Dirichlet DoF values [100..103]", 101);
     opt.addInt("InterfaceStrategy", "Method of treatment of patch interfaces [0..3]", 1  );
+    opt.addInt("DofOrdering", "Ordering of the free DoFs (0: natural, 1: reverse Cuthill-McKee, 2: space-filling curve)", 0 );
     opt.addReal("quA", "Number of quadrature points: quA*deg + quB", 1.0  );
     opt.addInt ("quB", "Number of quadrature points: quA*deg + quB", 1    );
     opt.addReal("bdA", "Estimated nonzeros per column of the matrix: bdA*deg + bdB", 2.0  );
@@ -114,13 +115,19 @@ void gsAssembler<T>::scalarProblemGalerkinRefresh()
     m_bases.front().getMapper(
         static_cast<dirichlet::strategy>(m_options.getInt("DirichletStrategy")),
         static_cast<iFace::strategy>(m_options.getInt("InterfaceStrategy")),
-        this->pde().bc(), mapper, 0);
+        this->pde().bc(), mapper, 0, false);
+    mapper.finalize(m_bases.front(),
+        static_cast<dofOrdering::type>(m_options.askInt("DofOrdering", dofOrdering::natural)));
 
     if ( 0 == mapper.freeSize() ) // Are there any interior dofs ?
         gsWarn << " No internal DOFs, zero sized system.\n";
 
     // 2. Create the sparse system
     m_system = gsSparseSystem<T>(mapper);//1,1
+
+    // 3. Drop the Dirichlet projections of the previous discretization
+    m_ddofSolver.clear();
+    m_ddofLumped.clear();
 }
 
 template<class T>
@@ -319,30 +326,28 @@ void gsAssembler<T>::computeDirichletDofsIntpl(const gsDofMapper & mapper,
                                                const short_t unk_)
 {
     m_ddof[unk_].resize(mapper.boundarySize(), m_system.unkSize(unk_) * m_pde_ptr->numRhs() );
-    // Iterate over all patch-sides with Dirichlet-boundary conditions
+
+    // Collect the patch-sides with Dirichlet-boundary conditions
+    std::vector<typename gsBoundaryConditions<T>::const_iterator> sides;
     for ( typename gsBoundaryConditions<T>::const_iterator
           it = m_pde_ptr->bc().dirichletBegin();
           it != m_pde_ptr->bc().dirichletEnd(); ++it )
-    {
-        //const int unk = it->unknown();
-        const index_t k   = it->patch();
-        if(it->unknown()!=unk_)
-            continue;
-        const gsBasis<T> & basis = mbasis[k];
+        if ( it->unknown() == unk_ )
+            sides.push_back(it);
 
-        // Get dofs on this boundary
-        const gsMatrix<index_t> boundary = basis.boundary(it->side());
+    // Interpolate the sides in parallel, the values are stored per
+    // side and copied in the order of the conditions afterwards
+    std::vector<gsMatrix<T> > sideVals(sides.size());
+    const index_t nSides = sides.size();
 
-        // If the condition is homogeneous then fill with zeros
+#pragma omp parallel for schedule(dynamic)
+    for ( index_t s = 0; s < nSides; ++s )
+    {
+        const typename gsBoundaryConditions<T>::const_iterator & it = sides[s];
         if ( it->isHomogeneous() )
-        {
-            for (index_t i=0; i!= boundary.size(); ++i)
-            {
-                const index_t ii= mapper.bindex( boundary.at(i) , k );
-                m_ddof[unk_].row(ii).setZero();
-            }
             continue;
-        }
+
+        const gsBasis<T> & basis = mbasis[it->patch()];
 
         // Get the side information
         short_t dir = it->side().direction( );
@@ -380,12 +385,33 @@ void gsAssembler<T>::computeDirichletDofsIntpl(const gsDofMapper & mapper,
         // Interpolate dirichlet boundary
         typename gsBasis<T>::uPtr h = basis.boundaryBasis(it->side());
         typename gsGeometry<T>::uPtr geo = h->interpolateAtAnchors(fpts);
-        const gsMatrix<T> & dVals =  geo->coefs();
+        geo->coefs().swap(sideVals[s]);
+    }
+
+    for ( index_t s = 0; s < nSides; ++s )
+    {
+        const typename gsBoundaryConditions<T>::const_iterator & it = sides[s];
+        const index_t k = it->patch();
+
+        // Get dofs on this boundary
+        const gsMatrix<index_t> boundary = mbasis[k].boundary(it->side());
+
+        // If the condition is homogeneous then fill with zeros
+        if ( it->isHomogeneous() )
+        {
+            for (index_t i=0; i!= boundary.size(); ++i)
+            {
+                const index_t ii= mapper.bindex( boundary.at(i) , k );
+                m_ddof[unk_].row(ii).setZero();
+            }
+            continue;
+        }
 
         // Save corresponding boundary dofs
+        const gsMatrix<T> & dVals = sideVals[s];
         for (index_t l=0; l!= boundary.size(); ++l)
         {
-            const index_t ii = mapper.bindex( boundary.at(l) , it->patch() );
+            const index_t ii = mapper.bindex( boundary.at(l) , k );
             m_ddof[unk_].row(ii) = dVals.row(l);
         }
     }
@@ -396,145 +422,334 @@ void gsAssembler<T>::computeDirichletDofsL2Proj(const gsDofMapper & mapper,
                                                 const gsMultiBasis<T> & ,
                                                 const short_t unk_)
 {
-    m_ddof[unk_].resize( mapper.boundarySize(), m_system.unkSize(unk_)* m_pde_ptr->numRhs());
+    const index_t bSize = mapper.boundarySize();
+    const index_t nCols = m_system.unkSize(unk_)* m_pde_ptr->numRhs();
+    m_ddof[unk_].resize(bSize, nCols);
 
-    // Set up matrix, right-hand-side and solution vector/matrix for
-    // the L2-projection
-    gsSparseEntries<T> projMatEntries;
-    gsMatrix<T>        globProjRhs;
-    globProjRhs.setZero( mapper.boundarySize(), m_system.unkSize(unk_)* m_pde_ptr->numRhs() );
-
-    // Temporaries
-    gsVector<T> quWeights;
-
-    gsMatrix<T> rhsVals;
-    gsMatrix<index_t> globIdxAct;
-    gsMatrix<T> basisVals;
-
-    gsMapData<T> md(NEED_MEASURE);
-
-    // Iterate over all patch-sides with Dirichlet-boundary conditions
+    // Collect the patch-sides with non-homogeneous Dirichlet conditions
+    std::vector<typename gsBoundaryConditions<T>::const_iterator> sides;
     for ( typename gsBoundaryConditions<T>::const_iterator
           iter = m_pde_ptr->bc().dirichletBegin();
           iter != m_pde_ptr->bc().dirichletEnd(); ++iter )
     {
-        if (iter->isHomogeneous() )
+        if (iter->isHomogeneous() || iter->unknown() != unk_ )
             continue;
 
-        GISMO_ASSERT(iter->function()->targetDim() == m_system.unkSize(unk_)* m_pde_ptr->numRhs(),
+        GISMO_ASSERT(iter->function()->targetDim() == nCols,
                      "Given Dirichlet boundary function does not match problem dimension."
                      <<iter->function()->targetDim()<<" != "<<m_system.unkSize(unk_)<<"x"<<m_system.rhs().cols()<<"\n");
+        sides.push_back(iter);
+    }
+    const index_t nSides = sides.size();
+    if ( 0 == nSides )
+    {
+        m_ddof[unk_].setZero();
+        return;
+    }
 
-        const short_t unk = iter->unknown();
-        if(unk!=unk_)
-            continue;
-        const index_t patchIdx   = iter->patch();
-        const gsBasis<T> & basis = (m_bases[unk])[patchIdx];
+    // Per-thread parts of the right-hand side of the L2-projection,
+    // of the lumped mass (row sums of the projection matrix) and of
+    // the entries of the projection matrix. They are summed in the
+    // order of the threads, so that the result is reproducible.
+#   ifdef _OPENMP
+    const index_t nt = omp_get_max_threads();
+#   else
+    const index_t nt = 1;
+#   endif
+    std::vector<gsMatrix<T> > thRhs(nt), thLumped(nt);
+    std::vector<gsSparseEntries<T> > thEntries(nt);
+
+    if ( m_ddofSolver.size() <= static_cast<size_t>(unk_) )
+    {
+        m_ddofSolver.resize(unk_ + 1);
+        m_ddofLumped.resize(unk_ + 1);
+    }
 
-        const gsGeometry<T> & patch = m_pde_ptr->patches()[patchIdx];
+    // The projection matrix depends only on the basis and the
+    // geometry, which do not change between refreshes (the
+    // factorization is dropped by initialize() and refresh()). If
+    // there is a factorization of the right size, the
+    // first pass assembles the right-hand side and the lumped mass;
+    // if the lumped mass is the same as for the previous computation
+    // the factorization is reused, otherwise a second pass assembles
+    // the projection matrix as well. Without a factorization the
+    // matrix is assembled in the first pass.
+    const bool haveSolver = m_ddofSolver[unk_] && m_ddofLumped[unk_].rows() == bSize;
+    for (bool withMatrix = !haveSolver; ; withMatrix = true)
+    {
+        for (index_t t = 0; t < nt; ++t)
+        {
+            thRhs[t].setZero(bSize, nCols);
+            thLumped[t].setZero(bSize, 1);
+            thEntries[t].clear();
+        }
 
-        // Set up quadrature to degree+1 Gauss points per direction,
-        // all lying on iter->side() except from the direction which
-        // is NOT along the element
+#pragma omp parallel
+{
+#       ifdef _OPENMP
+        const index_t tid = omp_get_thread_num();
+#       else
+        const index_t tid = 0;
+#       endif
+        gsMatrix<T> & globProjRhs = thRhs[tid];
+        gsMatrix<T> & lumped = thLumped[tid];
+        gsSparseEntries<T> & projMatEntries = thEntries[tid];
+
+        // Temporaries
+        gsVector<T> quWeights;
+        gsMatrix<T> rhsVals;
+        gsMatrix<index_t> globIdxAct;
+        gsMatrix<T> basisVals;
+        gsMapData<T> md(NEED_MEASURE);
+        std::vector<index_t> eltBdryFcts;
+
+#pragma omp for schedule(static)
+        for ( index_t s = 0; s < nSides; ++s )
+        {
+            const typename gsBoundaryConditions<T>::const_iterator & iter = sides[s];
+            const index_t patchIdx   = iter->patch();
+            const gsBasis<T> & basis = (m_bases[unk_])[patchIdx];
 
-        gsGaussRule<T> bdQuRule(basis, 1.0, 1, iter->side().direction());
+            const gsGeometry<T> & patch = m_pde_ptr->patches()[patchIdx];
 
-        // Create the iterator along the given part boundary.
-        typename gsBasis<T>::domainIter bdryIter = basis.makeDomainIterator(iter->side());
+            // Set up quadrature to degree+1 Gauss points per direction,
+            // all lying on iter->side() except from the direction which
+            // is NOT along the element
 
-        for(; bdryIter->good(); bdryIter->next() )
-        {
-            bdQuRule.mapTo( bdryIter->lowerCorner(), bdryIter->upperCorner(),
-                            md.points, quWeights);
-
-            //geoEval->evaluateAt( md.points );
-            patch.computeMap(md);
-
-            // the values of the boundary condition are stored
-            // to rhsVals. Here, "rhs" refers to the right-hand-side
-            // of the L2-projection, not of the PDE.
-            rhsVals = iter->function()->eval( m_pde_ptr->domain()[patchIdx].eval( md.points ) );
-
-            basis.eval_into( md.points, basisVals);
-
-            // Indices involved here:
-            // --- Local index:
-            // Index of the basis function/DOF on the patch.
-            // Does not take into account any boundary or interface conditions.
-            // --- Global Index:
-            // Each DOF has a unique global index that runs over all patches.
-            // This global index includes a re-ordering such that all eliminated
-            // DOFs come at the end.
-            // The global index also takes care of glued interface, i.e., corresponding
-            // DOFs on different patches will have the same global index, if they are
-            // glued together.
-            // --- Boundary Index (actually, it's a "Dirichlet Boundary Index"):
-            // The eliminated DOFs, which come last in the global indexing,
-            // have their own numbering starting from zero.
-
-            // Get the global indices (second line) of the local
-            // active basis (first line) functions/DOFs:
-            basis.active_into(md.points.col(0), globIdxAct );
-            mapper.localToGlobal( globIdxAct, patchIdx, globIdxAct);
-
-            // Out of the active functions/DOFs on this element, collect all those
-            // which correspond to a boundary DOF.
-            // This is checked by calling mapper.is_boundary_index( global Index )
-
-            // eltBdryFcts stores the row in basisVals/globIdxAct, i.e.,
-            // something like a "element-wise index"
-            std::vector<index_t> eltBdryFcts;
-            eltBdryFcts.reserve(mapper.boundarySize());
-            for( index_t i=0; i < globIdxAct.rows(); i++)
-                if( mapper.is_boundary_index( globIdxAct(i,0)) )
-                    eltBdryFcts.push_back( i );
-
-            // Do the actual assembly:
-            for( index_t k=0; k < md.points.cols(); k++ )
-            {
-                const T weight_k = quWeights[k] * md.measure(k);
+            gsGaussRule<T> bdQuRule(basis, 1.0, 1, iter->side().direction());
+
+            // Create the iterator along the given part boundary.
+            typename gsBasis<T>::domainIter bdryIter = basis.makeDomainIterator(iter->side());
 
-                // Only run through the active boundary functions on the element:
-                for( size_t i0=0; i0 < eltBdryFcts.size(); i0++ )
+            for(; bdryIter->good(); bdryIter->next() )
+            {
+                bdQuRule.mapTo( bdryIter->lowerCorner(), bdryIter->upperCorner(),
+                                md.points, quWeights);
+
+                patch.computeMap(md);
+
+                // the values of the boundary condition are stored
+                // to rhsVals. Here, "rhs" refers to the right-hand-side
+                // of the L2-projection, not of the PDE.
+                rhsVals = iter->function()->eval( m_pde_ptr->domain()[patchIdx].eval( md.points ) );
+
+                basis.eval_into( md.points, basisVals);
+
+                // Indices involved here:
+                // --- Local index:
+                // Index of the basis function/DOF on the patch.
+                // Does not take into account any boundary or interface conditions.
+                // --- Global Index:
+                // Each DOF has a unique global index that runs over all patches.
+                // This global index includes a re-ordering such that all eliminated
+                // DOFs come at the end.
+                // The global index also takes care of glued interface, i.e., corresponding
+                // DOFs on different patches will have the same global index, if they are
+                // glued together.
+                // --- Boundary Index (actually, it's a "Dirichlet Boundary Index"):
+                // The eliminated DOFs, which come last in the global indexing,
+                // have their own numbering starting from zero.
+
+                // Get the global indices (second line) of the local
+                // active basis (first line) functions/DOFs:
+                basis.active_into(md.points.col(0), globIdxAct );
+                mapper.localToGlobal( globIdxAct, patchIdx, globIdxAct);
+
+                // Out of the active functions/DOFs on this element, collect all those
+                // which correspond to a boundary DOF.
+                // This is checked by calling mapper.is_boundary_index( global Index )
+
+                // eltBdryFcts stores the row in basisVals/globIdxAct, i.e.,
+                // something like a "element-wise index"
+                eltBdryFcts.clear();
+                for( index_t i=0; i < globIdxAct.rows(); i++)
+                    if( mapper.is_boundary_index( globIdxAct(i,0)) )
+                        eltBdryFcts.push_back( i );
+
+                // Do the actual assembly:
+                for( index_t k=0; k < md.points.cols(); k++ )
                 {
-                    // Each active boundary function/DOF in eltBdryFcts has...
-                    // ...the above-mentioned "element-wise index"
-                    const unsigned i = eltBdryFcts[i0];
-                    // ...the boundary index.
-                    const unsigned ii = mapper.global_to_bindex( globIdxAct( i ));
+                    const T weight_k = quWeights[k] * md.measure(k);
 
-                    for( size_t j0=0; j0 < eltBdryFcts.size(); j0++ )
+                    // Only run through the active boundary functions on the element:
+                    for( size_t i0=0; i0 < eltBdryFcts.size(); i0++ )
                     {
-                        const unsigned j = eltBdryFcts[j0];
-                        const unsigned jj = mapper.global_to_bindex( globIdxAct( j ));
-
-                        // Use the "element-wise index" to get the needed
-                        // function value.
-                        // Use the boundary index to put the value in the proper
-                        // place in the global projection matrix.
-                        projMatEntries.add(ii, jj, weight_k * basisVals(i,k) * basisVals(j,k));
-                    } // for j
-
-                    globProjRhs.row(ii) += weight_k *  basisVals(i,k) * rhsVals.col(k).transpose();
+                        // Each active boundary function/DOF in eltBdryFcts has...
+                        // ...the above-mentioned "element-wise index"
+                        const index_t i = eltBdryFcts[i0];
+                        // ...the boundary index.
+                        const index_t ii = mapper.global_to_bindex( globIdxAct( i ));
+
+                        if ( withMatrix )
+                            for( size_t j0=0; j0 < eltBdryFcts.size(); j0++ )
+                            {
+                                const index_t j = eltBdryFcts[j0];
+                                const index_t jj = mapper.global_to_bindex( globIdxAct( j ));
+
+                                // Use the "element-wise index" to get the needed
+                                // function value.
+                                // Use the boundary index to put the value in the proper
+                                // place in the global projection matrix.
+                                projMatEntries.add(ii, jj, weight_k * basisVals(i,k) * basisVals(j,k));
+                            } // for j
+
+                        const T wb = weight_k * basisVals(i,k);
+                        lumped(ii, 0) += wb;
+                        globProjRhs.row(ii) += wb * rhsVals.col(k).transpose();
+
+                    } // for i
+                } // for k
+            } // bdryIter
+        } // sides
+}//omp parallel
+
+        for (index_t t = 1; t < nt; ++t)
+        {
+            thRhs[0]    += thRhs[t];
+            thLumped[0] += thLumped[t];
+        }
 
-                } // for i
-            } // for k
-        } // bdryIter
-    } // boundaryConditions-Iterator
+        if ( !withMatrix )
+        {
+            if ( m_ddofLumped[unk_] == thLumped[0] )
+                break;
+            continue;
+        }
 
-    gsSparseMatrix<T> globProjMat( mapper.boundarySize(), mapper.boundarySize() );
-    globProjMat.setFrom( projMatEntries );
-    globProjMat.makeCompressed();
+        for (index_t t = 1; t < nt; ++t)
+            thEntries[0].insert(thEntries[0].end(), thEntries[t].begin(), thEntries[t].end());
+
+        gsSparseMatrix<T> globProjMat( bSize, bSize );
+        globProjMat.setFrom( thEntries[0] );
+        // Boundary DoFs which lie only on homogeneous sides get a unit
+        // row, their value is zero
+        for (index_t i = 0; i != bSize; ++i)
+            if ( 0 == globProjMat.coeff(i,i) )
+                globProjMat.coeffRef(i,i) = 1;
+        globProjMat.makeCompressed();
+
+        // A new object, since copies of the assembler may share the
+        // previous factorization
+        m_ddofSolver[unk_] = memory::make_shared(new typename gsSparseSolver<T>::SimplicialLDLT());
+        m_ddofSolver[unk_]->compute( globProjMat );
+        m_ddofLumped[unk_].swap(thLumped[0]);
+        break;
+    }
 
     // Solve the linear system:
     // The position in the solution vector already corresponds to the
     // numbering by the boundary index. Hence, we can simply take them
     // for the values of the eliminated Dirichlet DOFs.
-    typename gsSparseSolver<T>::CGDiagonal solver;
-    m_ddof[unk_] = solver.compute( globProjMat ).solve ( globProjRhs );
+    m_ddof[unk_] = m_ddofSolver[unk_]->solve( thRhs[0] );
 
 } // computeDirichletDofsL2Proj
 
+namespace
+{
+// Orders point indices by the first active basis function
+struct firstActiveLess
+{
+    explicit firstActiveLess(const gsMatrix<index_t> & act) : m_act(act) { }
+    bool operator()(const index_t i, const index_t j) const
+    { return m_act(0,i) < m_act(0,j); }
+    const gsMatrix<index_t> & m_act;
+};
+}
+
+template<class T>
+void gsAssembler<T>::assemblePointLoads(const gsPointLoads<T> & pLoads, const index_t r)
+{
+    GISMO_PROFILE("gsAssembler::assemblePointLoads");
+    const index_t nLoads = pLoads.numLoads();
+    if ( 0 == nLoads ) return;
+
+    const gsMultiPatch<T> & mp = m_pde_ptr->patches();
+    const gsMultiBasis<T> & mb = m_bases[m_system.colBasis(r)];
+    const gsDofMapper & mapper = m_system.rowMapper(r);
+    const index_t nCols = m_system.rhs().cols();
+
+    // Group the loads by patch
+    gsVector<index_t> pids(nLoads);
+    for (index_t i = 0; i != nLoads; ++i)
+        pids[i] = pLoads[i].patch;
+    std::vector<index_t> offsets, perm;
+    mp.groupByPatch(pids, offsets, perm);
+
+    const index_t chunkSize = 256;
+    gsMatrix<T> pts, phys, preim, vals;
+    gsMatrix<index_t> act;
+    std::vector<index_t> ord, loc;
+    for (size_t k = 0; k != mp.nPatches(); ++k)
+    {
+        const index_t nk = offsets[k+1] - offsets[k];
+        if ( 0 == nk ) continue;
+        const gsBasis<T> & basis = mb[k];
+
+        // Parameters and values of the loads, physical points are
+        // inverted at once
+        pts .resize(mp.parDim(), nk);
+        vals.resize(nCols      , nk);
+        loc.clear();
+        for (index_t j = 0; j != nk; ++j)
+        {
+            const point_load<T> & pl = pLoads[perm[offsets[k] + j]];
+            GISMO_ASSERT(pl.value.size() == nCols, "The value of a point load has "
+                         << pl.value.size() <<" entries instead of "<< nCols);
+            vals.col(j) = pl.value;
+            if ( pl.parametric )
+                pts.col(j) = pl.point;
+            else
+                loc.push_back(j);
+        }
+        if ( !loc.empty() )
+        {
+            phys.resize(mp.geoDim(), loc.size());
+            for (size_t j = 0; j != loc.size(); ++j)
+                phys.col(j) = pLoads[perm[offsets[k] + loc[j]]].point;
+            mp.patch(k).invertPoints(phys, preim);
+            for (size_t j = 0; j != loc.size(); ++j)
+                pts.col(loc[j]) = preim.col(j);
+        }
+
+        // Sort the loads by element, ie. by the first active function
+        basis.active_into(pts, act);
+        ord.resize(nk);
+        for (index_t j = 0; j != nk; ++j)
+            ord[j] = j;
+        std::stable_sort(ord.begin(), ord.end(), firstActiveLess(act));
+
+        const index_t nChunks = (nk + chunkSize - 1) / chunkSize;
+#pragma omp parallel
+{
+        gsMatrix<T> cPts, cVals, bVals;
+        gsMatrix<index_t> cAct;
+#pragma omp for schedule(dynamic)
+        for (index_t c = 0; c < nChunks; ++c)
+        {
+            const index_t first = c * chunkSize;
+            const index_t n = math::min(chunkSize, nk - first);
+            cPts .resize(pts .rows(), n);
+            cVals.resize(vals.rows(), n);
+            cAct .resize(act .rows(), n);
+            for (index_t j = 0; j != n; ++j)
+            {
+                const index_t o = ord[first + j];
+                cPts .col(j) = pts .col(o);
+                cVals.col(j) = vals.col(o);
+                cAct .col(j) = act .col(o);
+            }
+
+            basis.eval_into(cPts, bVals);
+            for (index_t j = 0; j != cAct.size(); ++j)
+                cAct.at(j) = mapper.index(cAct.at(j), k);
+
+#pragma omp critical(localToGlobal)
+            m_system.pushToRhsPoints(bVals, cAct, cVals, r);
+        }
+}//omp parallel
+    }
+}
+
 template<class T>
 void gsAssembler<T>::constructSolution(const gsMatrix<T>& solVector,
                                        gsMultiPatch<T>& result, short_t unk) const
@@ -26,6 +26,35 @@
 namespace gismo
 {
 
+namespace internal
+{
+
+/// Detects whether a visitor has a member setGeometryCache(), see
+/// gsVisitorBiharmonic::setGeometryCache
+template <class Visitor, class T>
+struct has_setGeometryCache
+{
+    typedef char (&yes)[1];
+    typedef char (&no)[2];
+    template <class U> static yes test(char (*)[sizeof(
+        static_cast<U*>(0)->setGeometryCache(*static_cast<std::vector<gsMatrix<T> >*>(0)), 1)]);
+    template <class U> static no  test(...);
+    enum { value = (sizeof(test<Visitor>(0)) == sizeof(yes)) };
+};
+
+/// Hands \a cache to the \a visitor, if it keeps geometric data
+template <class Visitor, class T>
+typename util::enable_if<has_setGeometryCache<Visitor,T>::value, bool>::type
+setGeometryCache(Visitor & visitor, std::vector<gsMatrix<T> > & cache)
+{ visitor.setGeometryCache(cache); return true; }
+
+template <class Visitor, class T>
+typename util::enable_if<!has_setGeometryCache<Visitor,T>::value, bool>::type
+setGeometryCache(Visitor &, std::vector<gsMatrix<T> > &)
+{ return false; }
+
+} // namespace internal
+
 /** @brief
     Implementation of a homogeneous Biharmonic Assembler.
 
@@ -33,6 +62,13 @@ namespace gismo
     combines the patch-local stiffness matrices into a global system.
     Dirichlet boundary can only be enforced strongly (i.e Nitsche is
     not implemented).
+
+    The geometric terms of the volume integrals are kept between calls
+    of assemble(), also across refresh() and refinement of the bases,
+    as long as the geometry of a patch (the patch object and its
+    control points) is the same (see
+    gsVisitorBiharmonic::setGeometryCache; a custom \a bhVisitor
+    without this member computes them on every assembly).
 */
 template <class T, class bhVisitor = gsVisitorBiharmonic<T> >
 class gsBiharmonicAssembler : public gsAssembler<T>
@@ -79,6 +115,12 @@ protected:
     // fixme: add constructor and remove this
     gsBiharmonicPde<T> m_ppde;
 
+    // Geometric data of the volume integrals, per patch and element
+    std::vector<std::vector<gsMatrix<T> > > m_geoCache;
+
+    // The patches and control points the geometric data belongs to
+    std::vector<std::pair<const gsGeometry<T>*, gsMatrix<T> > > m_geoKey;
+
     // Members from gsAssembler
     using Base::m_pde_ptr;
     using Base::m_bases;
@@ -107,8 +149,30 @@ void gsBiharmonicAssembler<T,bhVisitor>::assemble()
     // Compute the Dirichlet Degrees of freedom (if needed by m_options)
     Base::computeDirichletDofs();
     
-    // Assemble volume integrals
-    Base::template push<bhVisitor >();
+    // Assemble volume integrals, keeping the geometric data for the
+    // next assembly
+    m_geoCache.resize(m_pde_ptr->domain().nPatches());
+    m_geoKey  .resize(m_geoCache.size());
+    for (size_t np = 0; np < m_geoCache.size(); ++np)
+    {
+        bhVisitor visitor(*m_pde_ptr);
+        if ( internal::setGeometryCache(visitor, m_geoCache[np]) )
+        {
+            // The data of a different geometry is dropped
+            const gsGeometry<T> & patch = m_pde_ptr->patches()[np];
+            const gsMatrix<T> & coefs = patch.coefs();
+            gsMatrix<T> & keyCoefs = m_geoKey[np].second;
+            if ( m_geoKey[np].first != &patch || keyCoefs.rows() != coefs.rows() ||
+                 keyCoefs.cols() != coefs.cols() || keyCoefs != coefs )
+            {
+                m_geoCache[np].clear();
+                m_geoKey[np].first = &patch;
+                keyCoefs = coefs;
+            }
+            m_geoCache[np].resize(m_bases[0][np].numElements());
+        }
+        Base::apply(visitor, np);
+    }
     
     // Newman conditions of first kind
     Base::template push<gsVisitorNeumann<T> >(
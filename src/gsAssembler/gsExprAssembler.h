@@ -16,6 +16,7 @@
 #include <gsUtils/gsPointGrid.h>
 #include <gsAssembler/gsQuadrature.h>
 #include <gsAssembler/gsExprHelper.h>
+#include <gsUtils/gsProfiler.h>
 
 namespace gismo
 {
@@ -250,6 +251,7 @@ public:
     {
         resetDimensions();
         m_matrix = gsSparseMatrix<T>(numTestDofs(), numDofs());
+        GISMO_PROFILE_COUNT(allocations, 1);
 
         if ( 0 == m_matrix.rows() || 0 == m_matrix.cols() )
             gsWarn << " No internal DOFs, zero sized system.\n";
@@ -428,7 +430,7 @@ private:
     template <class op, class E1>
     void _apply(op _op, const expr::_expr<E1> & firstArg) {_op(firstArg);}
     template <class op, class E1, class... Rest>
-    void _apply(op _op, const expr::_expr<E1> & firstArg, Rest... restArgs)
+    void _apply(op _op, const expr::_expr<E1> & firstArg, const Rest &... restArgs)
     { _op(firstArg); _apply<op>(_op, restArgs...); }
 #endif
 
@@ -466,10 +468,7 @@ private:
         template <typename E> void operator() (const gismo::expr::_expr<E> & ee)
         {
             // ------- Compute  -------
-            const T * w = m_quWeights.data();
-            localMat.noalias() = (*w) * ee.eval(0);
-            for (index_t k = 1; k != m_quWeights.rows(); ++k)
-                localMat.noalias() += (*(++w)) * ee.eval(k);
+            ee.integrate_into(m_quWeights, localMat);
 
             //  ------- Accumulate  -------
             if (E::isMatrix())
@@ -491,8 +490,9 @@ private:
             const gsDofMapper  & colMap = static_cast<const expr::gsFeSpace<T>&>(u).mapper();
             const gsDofMapper  & rowMap = static_cast<const expr::gsFeSpace<T>&>(v).mapper();
 
-            const gsMatrix<index_t> & colInd0 = u.data().actives;
             const gsMatrix<index_t> & rowInd0 = v.data().actives;
+            // the column variable of a right-hand side has no data
+            const gsMatrix<index_t> & colInd0 = isMatrix ? u.data().actives : rowInd0;
             const gsMatrix<T>  & fixedDofs = static_cast<const expr::gsFeSpace<T>&>(u).fixedPart();
 
             for (index_t r = 0; r != rd; ++r)
@@ -710,6 +710,7 @@ void gsExprAssembler<T>::assemble(expr... args)
 #endif
 {
     GISMO_ASSERT(matrix().cols()==numDofs(), "System not initialized");
+    GISMO_PROFILE("gsExprAssembler::assemble");
 
     // initialize flags
     m_exprdata->initFlags(SAME_ELEMENT|NEED_ACTIVE, SAME_ELEMENT);
@@ -740,6 +741,8 @@ void gsExprAssembler<T>::assemble(expr... args)
             // Map the Quadrature rule to the element
             QuRule.mapTo( domIt->lowerCorner(), domIt->upperCorner(),
                           m_exprdata->points(), quWeights);
+            GISMO_PROFILE_COUNT(elements, 1);
+            GISMO_PROFILE_COUNT(quPoints, quWeights.size());
 
             // Perform required pre-computations on the quadrature nodes
             m_exprdata->precompute(patchInd);
@@ -766,6 +769,8 @@ template <class E1>
 void gsExprAssembler<T>::assemble(const bcRefList & BCs, const expr::_expr<E1> & a1)
 #endif
 {
+    GISMO_PROFILE("gsExprAssembler::assembleBdr");
+
     // initialize flags
     m_exprdata->initFlags(SAME_ELEMENT|NEED_ACTIVE, SAME_ELEMENT);
 #   if __cplusplus >= 201103L || _MSC_VER >= 1600
@@ -801,6 +806,8 @@ void gsExprAssembler<T>::assemble(const bcRefList & BCs, const expr::_expr<E1> &
             // Map the Quadrature rule to the element
             QuRule.mapTo( domIt->lowerCorner(), domIt->upperCorner(),
                           m_exprdata->points(), quWeights);
+            GISMO_PROFILE_COUNT(elements, 1);
+            GISMO_PROFILE_COUNT(quPoints, quWeights.size());
 
             // Perform required pre-computations on the quadrature nodes
             m_exprdata->precompute(it->patch());
@@ -828,6 +835,7 @@ void gsExprAssembler<T>::assembleLhsRhsBc_impl(const expr::_expr<E1> & exprLhs,
                                                space rvar, space cvar,
                                                const bcContainer & BCs)
 {
+    GISMO_PROFILE("gsExprAssembler::assembleBc");
     //GISMO_ASSERT( exprRhs.isVector(), "Expecting vector expression");
 
     // initialize flags
@@ -859,6 +867,8 @@ void gsExprAssembler<T>::assembleLhsRhsBc_impl(const expr::_expr<E1> & exprLhs,
             // Map the Quadrature rule to the element
             QuRule.mapTo( domIt->lowerCorner(), domIt->upperCorner(),
                           m_exprdata->points(), quWeights);
+            GISMO_PROFILE_COUNT(elements, 1);
+            GISMO_PROFILE_COUNT(quPoints, quWeights.size());
 
             // Perform required pre-computations on the quadrature nodes
             m_exprdata->precompute(it->patch());
@@ -881,6 +891,7 @@ void gsExprAssembler<T>::assembleInterface_impl(const expr::_expr<E1> & exprLhs,
                                                 space rvar, space cvar,
                                                 const ifContainer & iFaces)
 {
+    GISMO_PROFILE("gsExprAssembler::assembleInterface");
     //GISMO_ASSERT( exprRhs.isVector(), "Expecting vector expression");
 
     // initialize flags
@@ -920,6 +931,8 @@ void gsExprAssembler<T>::assembleInterface_impl(const expr::_expr<E1> & exprLhs,
             // Map the Quadrature rule to the element
             QuRule.mapTo( domIt->lowerCorner(), domIt->upperCorner(),
                           m_exprdata->points(), quWeights);
+            GISMO_PROFILE_COUNT(elements, 1);
+            GISMO_PROFILE_COUNT(quPoints, quWeights.size());
 
             // Perform required pre-computations on the quadrature nodes
             m_exprdata->precompute(patch1);
@@ -288,6 +288,21 @@ private:
     template<class E, class _op>
     T computeInterface_impl(const expr::_expr<E> & expr, const intContainer & iFaces);
 
+    // Computes the values of \a expr on the elements of side \a side
+    // of patch \a patchInd, in parallel; elVals[i] is the value on
+    // the i-th element
+    template<class E, class _op>
+    void computeElements_impl(const expr::_expr<E> & expr, const gsQuadRule<T> & QuRule,
+                              const index_t patchInd, const boxSide side,
+                              std::vector<T> & elVals);
+
+    // Computes the values of \a ev on the elements tid, tid+nt, ...
+    template<class _op, class E>
+    void elementValues_impl(const E & ev, const gsQuadRule<T> & QuRule,
+                              const index_t patchInd, const boxSide side,
+                              const int tid, const int nt,
+                              std::vector<T> & elVals);
+
     template<class E>
     void computeGrid_impl(const expr::_expr<E> & expr, const index_t patchInd);
 
@@ -295,6 +310,12 @@ private:
     {
         static inline T init() { return 0; }
         static inline void acc(const T contrib, const T w, T & res) { res += w * contrib; }
+        template<class E> static inline T element(const E & ev, const gsVector<T> & w)
+        {
+            gsMatrix<T> res;
+            ev.integrate_into(w, res);
+            return res.value();
+        }
     };
     struct min_op
     {
@@ -303,6 +324,13 @@ private:
         {
             res = math::min(contrib, res);
         }
+        template<class E> static inline T element(const E & ev, const gsVector<T> & w)
+        {
+            T res = init();
+            for (index_t k = 0; k != w.rows(); ++k)
+                acc(ev.eval(k), w[k], res);
+            return res;
+        }
     };
     struct max_op
     {
@@ -311,6 +339,13 @@ private:
         {
             res = math::max(contrib, res);
         }
+        template<class E> static inline T element(const E & ev, const gsVector<T> & w)
+        {
+            T res = init();
+            for (index_t k = 0; k != w.rows(); ++k)
+                acc(ev.eval(k), w[k], res);
+            return res;
+        }
     };
 
 };
@@ -324,15 +359,12 @@ T gsExprEvaluator<T>::compute_impl(const expr::_expr<E> & expr)
     //               <<expr.cols()<<" x "<<expr.rows() );
     //expr.print(gsInfo); // precompute
 
-    gsQuadRule<T> QuRule;  // Quadrature rule
-    gsVector<T> quWeights; // quadrature weights
-
     // initialize flags
     m_exprdata->initFlags(SAME_ELEMENT|NEED_ACTIVE, SAME_ELEMENT);
     m_exprdata->setFlags(expr, SAME_ELEMENT, SAME_ELEMENT);
 
     // Computed value
-    T elVal;
+    std::vector<T> elVals;
     m_value = _op::init();
     m_elWise.clear();
     if ( storeElWise )
@@ -340,34 +372,17 @@ T gsExprEvaluator<T>::compute_impl(const expr::_expr<E> & expr)
     for (unsigned patchInd=0; patchInd < m_exprdata->multiBasis().nBases(); ++patchInd)
     {
         // Quadrature rule
-        QuRule =  gsQuadrature::get(m_exprdata->multiBasis().basis(patchInd), m_options);
+        const gsQuadRule<T> QuRule =
+            gsQuadrature::get(m_exprdata->multiBasis().basis(patchInd), m_options);
         //gsDebugVar(QuRule.numNodes());
 
-        // Initialize domain element iterator
-        typename gsBasis<T>::domainIter domIt =
-            m_exprdata->multiBasis().piece(patchInd).makeDomainIterator();
-        m_element.set(*domIt);
+        computeElements_impl<E,_op>(expr, QuRule, patchInd, boundary::none, elVals);
 
-        // Start iteration over elements
-        for (; domIt->good(); domIt->next() )
-        {
-            // Map the Quadrature rule to the element
-            QuRule.mapTo( domIt->lowerCorner(), domIt->upperCorner(),
-                          m_exprdata->points(), quWeights);
-
-            // Perform required pre-computations on the quadrature nodes
-            m_exprdata->precompute(patchInd);
-
-            // Compute on element
-            elVal = _op::init();
-            for (index_t k = 0; k != quWeights.rows(); ++k) // loop over quadrature nodes
-                _op::acc(expr.val().eval(k), quWeights[k], elVal);
-
-            //gsDebugVar(elVal);
-            _op::acc(elVal, 1, m_value);
-            if ( storeElWise )
-                m_elWise.push_back( elVal );
-        }
+        // Accumulate in element order, independently of the threads
+        for (size_t i = 0; i != elVals.size(); ++i)
+            _op::acc(elVals[i], 1, m_value);
+        if ( storeElWise )
+            m_elWise.insert(m_elWise.end(), elVals.begin(), elVals.end());
     }
 
     return m_value;
@@ -382,14 +397,11 @@ T gsExprEvaluator<T>::computeBdr_impl(const expr::_expr<E> & expr)
                   <<expr.cols()<<" x "<<expr.rows() );
     //expr.print(gsInfo);
 
-    gsQuadRule<T> QuRule;  // Quadrature rule
-    gsVector<T> quWeights; // quadrature weights
-
     // initialize flags
     m_exprdata->setFlags(expr, SAME_ELEMENT, SAME_ELEMENT);
 
     // Computed value
-    T elVal;
+    std::vector<T> elVals;
     m_value = _op::init();
     m_elWise.clear();
 
@@ -397,32 +409,14 @@ T gsExprEvaluator<T>::computeBdr_impl(const expr::_expr<E> & expr)
              m_exprdata->multiBasis().topology().bBegin(); bit != m_exprdata->multiBasis().topology().bEnd(); ++bit)
     {
         // Quadrature rule
-        QuRule = gsQuadrature::get(m_exprdata->multiBasis().basis(bit->patch), m_options,bit->direction());
-        m_exprdata->mapData.side = bit->side();
-
-        // Initialize domain element iterator
-        typename gsBasis<T>::domainIter domIt =
-            m_exprdata->multiBasis().piece(bit->patch).makeDomainIterator(bit->side());
-        m_element.set(*domIt);
-
-        // Start iteration over elements
-        for (; domIt->good(); domIt->next() )
-        {
-            // Map the Quadrature rule to the element
-            QuRule.mapTo( domIt->lowerCorner(), domIt->upperCorner(),
-                          m_exprdata->points(), quWeights);
+        const gsQuadRule<T> QuRule =
+            gsQuadrature::get(m_exprdata->multiBasis().basis(bit->patch), m_options,bit->direction());
 
-            // Perform required pre-computations on the quadrature nodes
-            m_exprdata->precompute(bit->patch);
+        computeElements_impl<E,_op>(expr, QuRule, bit->patch, bit->side(), elVals);
 
-            // Compute on element
-            elVal = _op::init();
-            for (index_t k = 0; k != quWeights.rows(); ++k) // loop over quadrature nodes
-                _op::acc(expr.val().eval(k), quWeights[k], elVal);
-
-            _op::acc(elVal, 1, m_value);
-            //if ( storeElWise ) m_elWise.push_back( elVal );
-        }
+        for (size_t i = 0; i != elVals.size(); ++i)
+            _op::acc(elVals[i], 1, m_value);
+        //if ( storeElWise ) m_elWise.insert(..);
     }
 
     return m_value;
@@ -438,14 +432,11 @@ T gsExprEvaluator<T>::computeInterface_impl(const expr::_expr<E> & expr, const i
 
     //expr.print(gsInfo);
 
-    gsQuadRule<T> QuRule;  // Quadrature rule
-    gsVector<T> quWeights; // quadrature weights
-
     // initialize flags
     m_exprdata->setFlags(expr, SAME_ELEMENT, SAME_ELEMENT);
 
     // Computed value
-    T elVal;
+    std::vector<T> elVals;
     m_value = _op::init();
     m_elWise.clear();
 
@@ -456,39 +447,89 @@ T gsExprEvaluator<T>::computeInterface_impl(const expr::_expr<E> & expr, const i
         const index_t patch1 = iFace.first().patch;
         // const index_t patch2 = iFace.second().patch; //!
         // Quadrature rule
-        QuRule = gsQuadrature::get(m_exprdata->multiBasis().basis(patch1),
-                                   m_options, iFace.first().side().direction());
+        const gsQuadRule<T> QuRule =
+            gsQuadrature::get(m_exprdata->multiBasis().basis(patch1),
+                              m_options, iFace.first().side().direction());
 
-        m_exprdata->mapData.side = iFace.first().side();
+        computeElements_impl<E,_op>(expr, QuRule, patch1, iFace.first().side(), elVals);
 
-        // Initialize domain element iterator
-        typename gsBasis<T>::domainIter domIt =
-            m_exprdata->multiBasis().basis(patch1).makeDomainIterator(iFace.first().side());
-        m_element.set(*domIt);
+        for (size_t i = 0; i != elVals.size(); ++i)
+            _op::acc(elVals[i], 1, m_value);
+        //if ( storeElWise ) m_elWise.insert(..);
+    }
 
-        // Start iteration over elements
-        for (; domIt->good(); domIt->next() )
-        {
-            // Map the Quadrature rule to the element
-            QuRule.mapTo( domIt->lowerCorner(), domIt->upperCorner(),
-                          m_exprdata->points(), quWeights);
+    return m_value;
+}
 
-            // Perform required pre-computations on the quadrature nodes
-            m_exprdata->precompute(patch1);
+template<class T>
+template<class E, class _op>
+void gsExprEvaluator<T>::computeElements_impl(const expr::_expr<E> & expr,
+                                              const gsQuadRule<T> & QuRule,
+                                              const index_t patchInd,
+                                              const boxSide side,
+                                              std::vector<T> & elVals)
+{
+    const gsBasis<T> & basis = m_exprdata->multiBasis().basis(patchInd);
+    elVals.resize(basis.makeDomainIterator(side)->numElements());
 
-            // Compute on element
-            elVal = _op::init();
-            for (index_t k = 0; k != quWeights.rows(); ++k) // loop over quadrature nodes
-                _op::acc(expr.val().eval(k), quWeights[k], elVal);
+    // The flags of this thread are passed to the others
+    m_exprdata->mapData.side = side;
+#ifdef _OPENMP
+    const index_t nThreads = omp_get_max_threads();
+#else
+    const index_t nThreads = 1;
+#endif
+    m_exprdata->setNumThreads(nThreads);
+    m_element.setNumThreads(nThreads);
 
-            _op::acc(elVal, 1, m_value);
-            //if ( storeElWise ) m_elWise.push_back( elVal );
-        }
-    }
+#pragma omp parallel
+{
+#ifdef _OPENMP
+    const int tid = omp_get_thread_num();
+    const int nt  = omp_get_num_threads();
+#else
+    const int tid = 0;
+    const int nt  = 1;
+#endif
+    // The expression leaves read the data of slot tid
+    expr::threadSlotScope slot(tid);
 
-    return m_value;
+    // Thread-private copy of the expression (temporaries included)
+    elementValues_impl<_op>(expr.val(), QuRule, patchInd, side, tid, nt, elVals);
+}//omp parallel
 }
 
+template<class T>
+template<class _op, class E>
+void gsExprEvaluator<T>::elementValues_impl(const E & ev,
+                                              const gsQuadRule<T> & QuRule,
+                                              const index_t patchInd,
+                                              const boxSide side,
+                                              const int tid, const int nt,
+                                              std::vector<T> & elVals)
+{
+    gsVector<T> quWeights; // quadrature weights
+
+    // Initialize domain element iterator
+    typename gsBasis<T>::domainIter domIt =
+        m_exprdata->multiBasis().basis(patchInd).makeDomainIterator(side);
+    m_element.set(*domIt);
+
+    // Start iteration over the elements of this thread
+    index_t i = tid;
+    for ( domIt->next(tid); domIt->good(); domIt->next(nt), i += nt )
+    {
+        // Map the Quadrature rule to the element
+        QuRule.mapTo( domIt->lowerCorner(), domIt->upperCorner(),
+                      m_exprdata->points(), quWeights);
+
+        // Perform required pre-computations on the quadrature nodes
+        m_exprdata->precompute(patchInd);
+
+        // Compute on element
+        elVals[i] = _op::element(ev, quWeights);
+    }
+}
 
 template<class T>
 template<class E, int mode, short_t d>
@@ -19,6 +19,14 @@ namespace gismo
 {
 /**
    Class holding an expression environment
+
+   The evaluation data (flags, points, values) is stored once per
+   thread, see setNumThreads(). The expression leaves read the data
+   of the slot of the calling thread (see expr::threadSlot()), hence
+   an expression can be evaluated concurrently on different elements,
+   as long as each thread uses its own copy of the expression tree
+   (eg. the one returned by _expr::val()). Outside of the parallel
+   element loops the first slot is used.
  */
 template<class T>
 class gsExprHelper
@@ -26,11 +34,13 @@ class gsExprHelper
 private:
     gsExprHelper(const gsExprHelper &);
 
-    gsExprHelper() : mesh_ptr(NULL)
+    gsExprHelper() : m_mapData(1), mutData(1), mesh_ptr(NULL),
+                     mapData(m_mapData.front())
     { mutVar.setData(mutData); }
 
 private:
-    typedef std::map<const gsFunctionSet<T>*,gsFuncData<T> > FunctionTable;
+    typedef std::vector<gsFuncData<T> > ThreadData;
+    typedef std::map<const gsFunctionSet<T>*,ThreadData> FunctionTable;
     typedef typename FunctionTable::iterator ftIterator;
     typedef typename FunctionTable::const_iterator const_ftIterator;
 
@@ -45,14 +55,15 @@ private:
 
     // geometry map
     expr::gsGeometryMap<T> mapVar;
-public:
-    gsMapData<T> mapData;
-private:
+    std::deque<gsMapData<T> > m_mapData; // references stay valid on resize
+
+    // common sub-expressions
+    expr::gsExprCache<T> m_cache;
 
     // mutable pair of variable and data,
     // ie. not uniquely assigned to a gsFunctionSet
     expr::gsFeVariable<T> mutVar ;
-    gsFuncData<T>         mutData;
+    ThreadData            mutData;
     bool mutParametric;
 
     gsSortedVector<const gsFunctionSet<T>*> evList;
@@ -74,7 +85,33 @@ public:
     typedef memory::shared_ptr<gsExprHelper>  Ptr;
 public:
 
-    gsMatrix<T> & points() { return mapData.points; }
+    /// Mapping data of the first slot, used outside of the parallel
+    /// element loops
+    gsMapData<T> & mapData;
+
+    /// Returns the evaluation points of the calling thread
+    gsMatrix<T> & points() { return m_mapData[expr::threadSlot()].points; }
+
+    /// Returns the number of threads that have evaluation data
+    index_t numThreads() const { return m_mapData.size(); }
+
+    /// Provides evaluation data for \a nt threads. The flags and the
+    /// side of the calling thread are copied to the other threads, so
+    /// this is called after setFlags() and before entering a parallel
+    /// region.
+    void setNumThreads(const index_t nt)
+    {
+        const index_t tid = expr::threadSlot();
+        resizeData(m_mapData, nt, tid);
+        for (index_t i = 0; i != nt; ++i)
+            m_mapData[i].side = m_mapData[tid].side;
+        resizeData(mutData, nt, tid);
+        m_cache.setNumThreads(nt);
+        for (ftIterator it = m_ptable.begin(); it != m_ptable.end(); ++it)
+            resizeData(it->second, nt, tid);
+        for (ftIterator it = m_itable.begin(); it != m_itable.end(); ++it)
+            resizeData(it->second, nt, tid);
+    }
 
     static uPtr make() { return uPtr(new gsExprHelper()); }
 
@@ -93,10 +130,10 @@ public:
         //mapData.side
         if ( mapVar.isValid() ) // list ?
         {
-            gsInfo << "mapVar: "<< &mapData <<"\n";
+            gsInfo << "mapVar: "<< &m_mapData.front() <<"\n";
         }
 
-        if ( mutVar.isValid() && 0!=mutData.flags)
+        if ( mutVar.isValid() && 0!=mutData.front().flags)
         {
             gsInfo << "mutVar: "<< &mutVar <<"\n";
         }
@@ -112,16 +149,24 @@ public:
         {
             gsInfo << " * "<< &it->first <<" --> "<< &it->second <<"\n";
         }
+
+        gsInfo << "cached sub-expressions:\n";
+        m_cache.print(gsInfo);
     }
 
     void cleanUp()
     {
-        mapData.clear();
-        mutData.clear();
+        for (size_t i = 0; i != m_mapData.size(); ++i)
+        {
+            m_mapData[i].clear();
+            mutData[i].clear();
+        }
         for (ftIterator it = m_ptable.begin(); it != m_ptable.end(); ++it)
-            it->second.clear();
+            for (size_t i = 0; i != it->second.size(); ++i)
+                it->second[i].clear();
         for (ftIterator it = m_itable.begin(); it != m_itable.end(); ++it)
-            it->second.clear();
+            for (size_t i = 0; i != it->second.size(); ++i)
+                it->second[i].clear();
     }
 
     void setMultiBasis(const gsMultiBasis<T> & mesh) { mesh_ptr = &mesh; }
@@ -138,14 +183,14 @@ public:
     geometryMap getMap(const gsFunction<T> & mp)
     {
         //mapData.clear();
-        mapVar.registerData(mp, mapData);
+        mapVar.registerData(mp, m_mapData, m_cache);
         return mapVar;
     }
 
     geometryMap getMap(const gsMultiPatch<T> & mp)
     {
         //mapData.clear();
-        mapVar.registerData(mp, mapData);
+        mapVar.registerData(mp, m_mapData, m_cache);
         return mapVar;
     }
 
@@ -159,7 +204,8 @@ public:
     {
         m_vlist.push_back( expr::gsFeVariable<T>() );
         expr::gsFeVariable<T> & var = m_vlist.back();
-        gsFuncData<T> & fd = m_ptable[&mp];
+        ThreadData & fd = m_ptable[&mp];
+        fd.resize(numThreads());
         //fd.dim = mp.dimensions();
         //gsDebugVar(&fd);
         var.registerData(mp, fd, dim);
@@ -172,10 +218,11 @@ public:
         GISMO_ASSERT(&G==&mapVar, "geometry map not known");
         m_vlist.push_back( expr::gsFeVariable<T>() );
         expr::gsFeVariable<T> & var = m_vlist.back();
-        gsFuncData<T> & fd = m_itable[&mp];
+        ThreadData & fd = m_itable[&mp];
+        fd.resize(numThreads());
         //fd.dim = mp.dimensions();
         //gsDebugVar(&fd);
-        var.registerData(mp, fd, 1, mapData);
+        var.registerData(mp, fd, 1, m_mapData);
         return var;
     }
 
@@ -183,7 +230,8 @@ public:
     {
         m_slist.push_back( expr::gsFeSpace<T>() );
         expr::gsFeSpace<T> & var = m_slist.back();
-        gsFuncData<T> & fd = m_ptable[&mp];
+        ThreadData & fd = m_ptable[&mp];
+        fd.resize(numThreads());
         //fd.dim = mp.dimensions();
         var.registerData(mp, fd, dim);
         return var;
@@ -226,12 +274,18 @@ public:
     void initFlags(const unsigned fflag = 0,
                    const unsigned mflag = 0)
     {
-        mapData.flags = mflag;
-        mutData.flags = fflag;
+        m_cache.clear(); // the expressions register again in setFlag()
+        for (size_t i = 0; i != m_mapData.size(); ++i)
+        {
+            m_mapData[i].flags = mflag;
+            mutData[i].flags = fflag;
+        }
         for (ftIterator it = m_ptable.begin(); it != m_ptable.end(); ++it)
-            it->second.flags = fflag;
+            for (size_t i = 0; i != it->second.size(); ++i)
+                it->second[i].flags = fflag;
         for (ftIterator it = m_itable.begin(); it != m_itable.end(); ++it)
-            it->second.flags = fflag;
+            for (size_t i = 0; i != it->second.size(); ++i)
+                it->second[i].flags = fflag;
     }
 
     template<class Expr> // to remove
@@ -252,22 +306,25 @@ public:
     void precompute(const index_t patchIndex = 0)
     {
         GISMO_ASSERT(0!=points().size(), "No points");
+        const index_t tid = expr::threadSlot();
+        gsMapData<T> & md = m_mapData[tid];
+        m_cache.newPoints();
 
         //mapData.side
         if ( mapVar.isValid() ) // list ?
         {
             //gsDebugVar("MAPDATA-------***************");
-            mapData.flags |= NEED_VALUE;
-            mapVar.source().function(patchIndex).computeMap(mapData);
-            mapData.patchId = patchIndex;
+            md.flags |= NEED_VALUE;
+            mapVar.source().function(patchIndex).computeMap(md);
+            md.patchId = patchIndex;
         }
 
-        if ( mutVar.isValid() && 0!=mutData.flags)
+        if ( mutVar.isValid() && 0!=mutData[tid].flags)
         {
-            GISMO_ASSERT( mutParametric || 0!=mapData.values.size(), "Map values not computed");
+            GISMO_ASSERT( mutParametric || 0!=md.values.size(), "Map values not computed");
             //mutVar.source().piece(patchIndex).compute(mapData.points, mutData);
             mutVar.source().piece(patchIndex)
-                .compute( mutParametric ? mapData.points : mapData.values[0], mutData);
+                .compute( mutParametric ? md.points : md.values[0], mutData[tid]);
         }
 
         for (ftIterator it = m_ptable.begin(); it != m_ptable.end(); ++it)
@@ -275,23 +332,23 @@ public:
             //gsDebugVar("-------");
             //gsDebugVar(&it->second);
             //gsDebugVar(it->second.dim.first);
-            it->first->piece(patchIndex).compute(mapData.points, it->second); // ! piece(.) ?
+            it->first->piece(patchIndex).compute(md.points, it->second[tid]); // ! piece(.) ?
             //gsDebugVar(&it->second);
             //gsDebugVar(it->second.dim.first);
             //gsDebugVar("-------");
-            it->second.patchId = patchIndex;
+            it->second[tid].patchId = patchIndex;
         }
 
-        GISMO_ASSERT( m_itable.empty() || 0!=mapData.values.size(), "Map values not computed");
+        GISMO_ASSERT( m_itable.empty() || 0!=md.values.size(), "Map values not computed");
 
-        if ( 0!=mapData.values.size() && 0!= mapData.values[0].rows() ) // avoid left-over from previous expr.
+        if ( 0!=md.values.size() && 0!= md.values[0].rows() ) // avoid left-over from previous expr.
         for (ftIterator it = m_itable.begin(); it != m_itable.end(); ++it)
         {
             //gsDebugVar(&it->second);
             //gsDebugVar(it->second.dim.first);
-            it->first->piece(patchIndex).compute(mapData.values[0], it->second);
+            it->first->piece(patchIndex).compute(md.values[0], it->second[tid]);
             //gsDebugVar(it->second.dim.first);
-            it->second.patchId = patchIndex;
+            it->second[tid].patchId = patchIndex;
         }
     }
 
@@ -317,6 +374,19 @@ public:
 //*/
 
 
+private:
+
+    // Resizes the per-thread data \a data to \a nt threads, new
+    // and existing threads get the flags of thread \a tid
+    template<class Container>
+    static void resizeData(Container & data, const index_t nt, const index_t tid)
+    {
+        const unsigned flags = data[tid].flags;
+        data.resize(nt);
+        for (index_t i = 0; i != nt; ++i)
+            data[i].flags = flags;
+    }
+
 };//class
 
 
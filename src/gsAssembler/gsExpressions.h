@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <deque>
 #include <gsCore/gsFuncData.h>
 #include <gsUtils/gsSortedVector.h>
 
@@ -96,6 +97,81 @@ template<class E> class temp_expr;
 template<class E1, class E2, bool = E1::ColBlocks> class mult_expr
 {using E1::GISMO_ERROR_mult_expr_has_invalid_template_arguments;};
 
+/// Returns a reference to the slot of the calling thread (see threadSlot())
+inline index_t & threadSlotRef()
+{
+    static index_t slot = 0;
+#   ifdef _OPENMP
+#   pragma omp threadprivate(slot)
+#   endif
+    return slot;
+}
+
+/// Returns the slot of the calling thread, which selects the
+/// evaluation data of the expression leaves (see gsExprHelper). It is
+/// the thread number inside the parallel element loops of
+/// gsExprEvaluator and zero elsewhere, hence threads of a parallel
+/// region of the caller, each with its own evaluator, use the first
+/// slot of their evaluator.
+inline index_t threadSlot() { return threadSlotRef(); }
+
+/// Sets the slot of the calling thread while in scope
+class threadSlotScope
+{
+public:
+    explicit threadSlotScope(const index_t slot) { threadSlotRef() = slot; }
+    ~threadSlotScope() { threadSlotRef() = 0; }
+};
+
+/*
+   Default implementations of the batched evaluation of an expression
+   E at the points 0,...,n-1 (see _expr::evalAll_into and
+   _expr::integrate_into), for matrix-valued and scalar-valued
+   expressions
+ */
+template<bool ScalarValued> struct batch_eval
+{
+    template<class E, class T>
+    static void evalAll(const E & e, const index_t n, gsMatrix<T> & res)
+    {
+        if (0==n) { res.resize(0,0); return; }
+        gsMatrix<T> tmp = e.eval(0);
+        const index_t c = tmp.cols();
+        res.resize(tmp.rows(), c*n);
+        res.leftCols(c) = tmp;
+        for (index_t k = 1; k != n; ++k)
+            res.middleCols(k*c, c) = e.eval(k);
+    }
+
+    template<class E, class T>
+    static void integrate(const E & e, const gsVector<T> & w, gsMatrix<T> & res)
+    {
+        res.noalias() = w[0] * e.eval(0);
+        for (index_t k = 1; k != w.size(); ++k)
+            res.noalias() += w[k] * e.eval(k);
+    }
+};
+
+template<> struct batch_eval<true>
+{
+    template<class E, class T>
+    static void evalAll(const E & e, const index_t n, gsMatrix<T> & res)
+    {
+        res.resize(1, n);
+        for (index_t k = 0; k != n; ++k)
+            res(0,k) = e.eval(k);
+    }
+
+    template<class E, class T>
+    static void integrate(const E & e, const gsVector<T> & w, gsMatrix<T> & res)
+    {
+        T val = 0;
+        for (index_t k = 0; k != w.size(); ++k)
+            val += w[k] * e.eval(k);
+        res.setConstant(1, 1, val);
+    }
+};
+
 /*
    Traits class for expressions
  */
@@ -168,6 +244,26 @@ public:
     MatExprType eval(const index_t k) const
     { return static_cast<E const&>(*this).eval(k); }
 
+    ///\brief Evaluates the expression at the points 0,...,\a n-1
+    /// into \a res. The value at point k is the block
+    /// res.middleCols(k*c,c), where c is the number of columns of the
+    /// expression (one for scalar-valued expressions)
+    void evalAll_into(const index_t n, gsMatrix<Scalar> & res) const
+    { static_cast<E const&>(*this).evalAll_impl(n, res); }
+
+    ///\brief Computes the weighted sum of the values of the
+    /// expression, \a res = sum_k w[k]*eval(k), over the points
+    /// k=0,...,w.size()-1
+    void integrate_into(const gsVector<Scalar> & w, gsMatrix<Scalar> & res) const
+    { static_cast<E const&>(*this).integrate_impl(w, res); }
+
+    // Default implementations, point by point. Expressions can
+    // provide batched versions with the same name.
+    void evalAll_impl(const index_t n, gsMatrix<Scalar> & res) const
+    { batch_eval<E::ScalarValued>::evalAll(static_cast<E const&>(*this), n, res); }
+    void integrate_impl(const gsVector<Scalar> & w, gsMatrix<Scalar> & res) const
+    { batch_eval<E::ScalarValued>::integrate(static_cast<E const&>(*this), w, res); }
+
     /// Returns the transpose of the expression
     tr_expr<E> tr() const
     { return tr_expr<E>(static_cast<E const&>(*this)); }
@@ -368,6 +464,146 @@ public:
     void print(std::ostream &os) const { os<<_c; }
 };
 
+/**
+   Cache of common sub-expressions, owned by gsExprHelper
+
+   Sub-expressions register themselves when their flags are set, with
+   a key made of their node type and their operands. Equal keys share
+   one slot, hence the sub-expression is computed once per evaluation
+   point, even if it appears several times in the expressions that
+   are evaluated on an element (eg. in the left- and right-hand side).
+   The values are stored per thread and are invalidated by
+   newPoints().
+*/
+template<class T>
+class gsExprCache
+{
+    struct Entry
+    {
+        std::vector<gsMatrix<T> > values; ///< values at the evaluation points
+        std::vector<unsigned>     stamps; ///< points of value k
+    };
+
+    struct ThreadCache
+    {
+        ThreadCache() : stamp(1), numEvals(0), numHits(0) { }
+        unsigned stamp;               ///< identifies the current points
+        std::vector<Entry> entries;
+        index_t numEvals, numHits;    ///< statistics, see numEvaluations()
+    };
+
+    std::map<std::string,index_t> m_keys;
+    std::vector<std::string> m_names; ///< printout of the slots
+    std::vector<index_t>     m_uses;  ///< number of registrations of the slots
+    std::vector<ThreadCache> m_threads;
+    unsigned m_generation;            ///< increased by clear()
+
+public:
+
+    gsExprCache() : m_threads(1), m_generation(0) { }
+
+    /// Forgets the registered sub-expressions
+    void clear()
+    {
+        m_keys.clear();
+        m_names.clear();
+        m_uses.clear();
+        for (size_t t = 0; t != m_threads.size(); ++t)
+        {
+            m_threads[t].entries.clear();
+            m_threads[t].numEvals = m_threads[t].numHits = 0;
+        }
+        ++m_generation;
+    }
+
+    /// Returns the number of evaluations of the registered
+    /// sub-expressions since the last clear(), summed over the threads
+    index_t numEvaluations() const
+    {
+        index_t n = 0;
+        for (size_t t = 0; t != m_threads.size(); ++t)
+            n += m_threads[t].numEvals;
+        return n;
+    }
+
+    /// Returns the number of times a registered sub-expression was
+    /// taken from the cache since the last clear(), summed over the
+    /// threads
+    index_t numHits() const
+    {
+        index_t n = 0;
+        for (size_t t = 0; t != m_threads.size(); ++t)
+            n += m_threads[t].numHits;
+        return n;
+    }
+
+    /// Returns the generation of the registrations, which changes
+    /// with every clear()
+    unsigned generation() const { return m_generation; }
+
+    /// Returns the slot of the sub-expression with key \a key,
+    /// \a name is its printout
+    index_t registerExpr(const std::string & key, const std::string & name)
+    {
+        typename std::map<std::string,index_t>::iterator it = m_keys.find(key);
+        if ( it != m_keys.end() )
+        {
+            gsDebug << "gsExprCache: "<< name <<" is computed once for "
+                    << ++m_uses[it->second] <<" occurrences\n";
+            return it->second;
+        }
+        const index_t slot = m_names.size();
+        m_keys[key] = slot;
+        m_names.push_back(name);
+        m_uses.push_back(1);
+        for (size_t t = 0; t != m_threads.size(); ++t)
+            m_threads[t].entries.resize(m_names.size());
+        return slot;
+    }
+
+    /// Provides storage for \a nt threads
+    void setNumThreads(const index_t nt)
+    {
+        m_threads.resize(nt);
+        for (size_t t = 0; t != m_threads.size(); ++t)
+            m_threads[t].entries.resize(m_names.size());
+    }
+
+    /// Invalidates the values of the calling thread, since its
+    /// evaluation points changed
+    void newPoints() { ++m_threads[threadSlot()].stamp; }
+
+    /// Returns the value of the sub-expression \a e of slot \a slot
+    /// at the point \a k, evaluated if not yet available
+    template<class E>
+    const gsMatrix<T> & eval(const index_t slot, const index_t k, const E & e)
+    {
+        ThreadCache & tc = m_threads[threadSlot()];
+        Entry & en = tc.entries[slot];
+        if ( k >= (index_t)en.stamps.size() )
+        {
+            en.stamps.resize(k+1, 0);
+            en.values.resize(k+1);
+        }
+        if ( en.stamps[k] != tc.stamp )
+        {
+            en.values[k] = e.eval(k);
+            en.stamps[k] = tc.stamp;
+            ++tc.numEvals;
+        }
+        else
+            ++tc.numHits;
+        return en.values[k];
+    }
+
+    /// Prints the registered sub-expressions
+    void print(std::ostream & os) const
+    {
+        for (size_t i = 0; i != m_names.size(); ++i)
+            os << " * "<< m_names[i] <<" (x"<< m_uses[i] <<")\n";
+    }
+};
+
 /*
    Geometry map expression
  */
@@ -375,7 +611,8 @@ template<class T>
 class gsGeometryMap : public _expr<gsGeometryMap<T> >
 {
     const gsFunctionSet<T> * m_fs; ///< Evaluation source for this geometry map
-    const gsMapData<T> *  m_fd;    ///< Temporary variable storing flags and evaluation data
+    const std::deque<gsMapData<T> > * m_fd; ///< Temporary variables storing flags and evaluation data, one per thread
+    gsExprCache<T> * m_cache;      ///< Cache of common sub-expressions
     //index_t d, n;
 
 public:
@@ -383,8 +620,15 @@ public:
     /// Returns the function source
     const gsFunctionSet<T> & source() const {return *m_fs;}
 
-    /// Returns the function data
-    const gsMapData<T> & data() const  { return *m_fd; }
+    /// Returns the cache of common sub-expressions
+    gsExprCache<T> & cache() const { return *m_cache; }
+
+    /// Returns the function data of the calling thread
+    const gsMapData<T> & data() const
+    {
+        GISMO_ASSERT(threadSlot() < (index_t)m_fd->size(), "GeometryMap: no data for thread "<<threadSlot());
+        return (*m_fd)[threadSlot()];
+    }
 
 public:
     typedef T Scalar;
@@ -393,29 +637,31 @@ public:
 
     void print(std::ostream &os) const { os << "G"; }
 
-    MatExprType eval(const index_t k) const { return m_fd->values[0].col(k); }
+    MatExprType eval(const index_t k) const { return data().values[0].col(k); }
 
     void setFlag() const
     {
         GISMO_ASSERT(NULL!=m_fd, "GeometryMap not registered");
-        m_fd->flags |= NEED_VALUE;
+        data().flags |= NEED_VALUE;
     }
 
 protected:
 
-    gsGeometryMap() : m_fs(NULL), m_fd(NULL) { }
+    gsGeometryMap() : m_fs(NULL), m_fd(NULL), m_cache(NULL) { }
 
-    /// Registers the source function and evaluation data
-    void registerData(const gsFunctionSet<T> & fs, const gsMapData<T> & val)
+    /// Registers the source function, evaluation data and cache
+    void registerData(const gsFunctionSet<T> & fs, const std::deque<gsMapData<T> > & val,
+                      gsExprCache<T> & cache)
     {
         m_fs = &fs;
         m_fd = &val;
+        m_cache = &cache;
     }
 
     /// Returns true iff the source function has been set
     bool isValid() const { return NULL!=m_fs; }
 
-    index_t rows() const { return m_fd->dim.second; }
+    index_t rows() const { return data().dim.second; }
     index_t cols() const { return 1; }
 
     static bool rowSpan() {return false;}
@@ -428,7 +674,7 @@ protected:
     {
         GISMO_ASSERT(NULL!=m_fd, "GeometryMap not registered");
         evList.push_unique(m_fs);
-        m_fd->flags |= NEED_VALUE;
+        data().flags |= NEED_VALUE;
     }
 };
 
@@ -447,16 +693,24 @@ class gsFeElement
 {
     friend class cdiam_expr<T>;
 
-    const gsDomainIterator<T> * m_di; ///< Pointer to the domain iterator
+    std::vector<const gsDomainIterator<T> *> m_di; ///< Pointers to the domain iterators, one per thread
 
     cdiam_expr<T> cd;
 public:
     typedef T Scalar;
 
-    gsFeElement() : m_di(NULL), cd(*this) { }
+    gsFeElement() : m_di(1, NULL), cd(*this) { }
+
+    /// Sets the number of threads that iterate over elements
+    void setNumThreads(const index_t nt)
+    { m_di.resize(nt, NULL); }
 
+    /// Sets the domain iterator of the calling thread
     void set(const gsDomainIterator<T> & di)
-    { m_di = &di; }
+    {
+        GISMO_ASSERT(threadSlot() < (index_t)m_di.size(), "gsFeElement: no slot for thread "<<threadSlot());
+        m_di[threadSlot()] = &di;
+    }
 
     /// The diameter of the element
     const cdiam_expr<T> & diam() const
@@ -483,7 +737,7 @@ public:
 
     explicit cdiam_expr(const gsFeElement<T> & el) : _e(el) { }
 
-    T eval(const index_t ) const { return _e.m_di->getCellSize(); }
+    T eval(const index_t ) const { return _e.m_di[threadSlot()]->getCellSize(); }
 
     inline cdiam_expr<T> val() const { return *this; }
     inline index_t rows() const { return 0; }
@@ -550,9 +804,9 @@ class gsFeVariable  : public _expr<gsFeVariable<T> >
 protected:
     //const gsFuncData<T>    * m_fd2; // more data when needed
     const gsFunctionSet<T> * m_fs; ///< Evaluation source for this FE variable
-    const gsFuncData<T>    * m_fd; ///< Temporary variable storing flags and evaluation data
+    const std::vector<gsFuncData<T> > * m_fd; ///< Temporary variables storing flags and evaluation data, one per thread
     index_t m_d;                   ///< Dimension of this (scalar or vector) variable
-    const gsMapData<T>     * m_md; ///< If set, the variable is composed with a geometry map
+    const std::deque<gsMapData<T> > * m_md; ///< If set, the variable is composed with a geometry map
     // comp(u,G)
 
 public:
@@ -561,11 +815,15 @@ public:
     /// Returns the function source
     const gsFunctionSet<T> & source() const {return *m_fs;}
 
-    /// Returns the function data
-    const gsFuncData<T> & data() const {return *m_fd;}
+    /// Returns the function data of the calling thread
+    const gsFuncData<T> & data() const
+    {
+        GISMO_ASSERT(threadSlot() < (index_t)m_fd->size(), "FeVariable: no data for thread "<<threadSlot());
+        return (*m_fd)[threadSlot()];
+    }
 
-    /// Returns the mapping data (precondition: composed()==true)
-    const gsMapData<T> & mapData() const {return *m_md;}
+    /// Returns the mapping data of the calling thread (precondition: composed()==true)
+    const gsMapData<T> & mapData() const {return (*m_md)[threadSlot()];}
 
     /// Returns true if the variable is a composition
     bool composed() const {return NULL!=m_md;}
@@ -574,7 +832,7 @@ private:
     friend class gismo::gsExprHelper<T>;
 
     void setSource(const gsFunctionSet<T> & fs) { m_fs = &fs;}
-    void setData(const gsFuncData<T> & val) { m_fd = &val;}
+    void setData(const std::vector<gsFuncData<T> > & val) { m_fd = &val;}
     void clear() { m_fs = NULL; }
     // gsFuncData<T> & data() {return *m_fd;}
     // gsMapData<T> & mapData() {return *m_md;}
@@ -583,7 +841,7 @@ protected:
 
     explicit gsFeVariable(index_t _d = 1) : m_fs(NULL), m_fd(NULL), m_d(_d), m_md(NULL) { }
 
-    void registerData(const gsFunctionSet<T> & fs, const gsFuncData<T> & val, index_t d)
+    void registerData(const gsFunctionSet<T> & fs, const std::vector<gsFuncData<T> > & val, index_t d)
     {
         GISMO_ASSERT(NULL==m_fs, "gsFeVariable: already registered");
         m_fs = &fs ;
@@ -592,8 +850,8 @@ protected:
         m_md = NULL;
     }
 
-    void registerData(const gsFunctionSet<T> & fs, const gsFuncData<T> & val, index_t d,
-                      const gsMapData<T> & md)
+    void registerData(const gsFunctionSet<T> & fs, const std::vector<gsFuncData<T> > & val, index_t d,
+                      const std::deque<gsMapData<T> > & md)
     {
         registerData(fs,val,d);
         m_md  = &md;
@@ -611,7 +869,7 @@ public:
     // The evaluation return rows for (basis) functions and columns
     // for (coordinate) components
     MatExprType eval(const index_t k) const
-    { return m_fd->values[0].col(k).blockDiag(m_d); } //!!
+    { return data().values[0].col(k).blockDiag(m_d); } //!!
     //{ return m_fd->values[0].col(k); }
 
     const gsFeVariable<T> & rowVar() const {return *this;}
@@ -634,12 +892,13 @@ public:
         */
 
         // note: precomputation is needed
-        if (m_fd->flags & NEED_VALUE)
-        {return m_d * m_fd->values[0].rows();}
-        if (m_fd->flags & NEED_ACTIVE) // note: gsFunction coeff ??
-        {return m_d * m_fd->actives.rows();}
-        if (m_fd->flags & NEED_DERIV)
-        {return m_d * m_fd->values[0].rows();}
+        const gsFuncData<T> & fd = data();
+        if (fd.flags & NEED_VALUE)
+        {return m_d * fd.values[0].rows();}
+        if (fd.flags & NEED_ACTIVE) // note: gsFunction coeff ??
+        {return m_d * fd.actives.rows();}
+        if (fd.flags & NEED_DERIV)
+        {return m_d * fd.values[0].rows();}
         GISMO_ERROR("Cannot deduce row size.");
     }
 
@@ -648,16 +907,16 @@ public:
     void setFlag() const
     {
         GISMO_ASSERT(NULL!=m_fd, "FeVariable: FuncData member not registered");
-        m_fd->flags |= NEED_VALUE;
-        if (NULL!=m_md) m_md->flags |= NEED_VALUE;
+        data().flags |= NEED_VALUE;
+        if (NULL!=m_md) mapData().flags |= NEED_VALUE;
     }
 
     void parse(gsSortedVector<const gsFunctionSet<Scalar>*> & evList) const
     {
         GISMO_ASSERT(NULL!=m_fd, "FeVariable: FuncData member not registered");
         evList.push_sorted_unique(m_fs);
-        m_fd->flags |= NEED_VALUE;
-        if (NULL!=m_md) m_md->flags |= NEED_VALUE;
+        data().flags |= NEED_VALUE;
+        if (NULL!=m_md) mapData().flags |= NEED_VALUE;
     }
 
     void print(std::ostream &os) const { os << "u"; }
@@ -674,7 +933,7 @@ public:
         //return m_fd->dim.first;
     }
 
-    index_t cSize()  const { return m_fd->values[0].rows(); } // coordinate size
+    index_t cSize()  const { return data().values[0].rows(); } // coordinate size
 
 };
 
@@ -913,8 +1172,8 @@ public:
     inline const gsMatrix<T> & fixedPart() const {return _u.m_fixedDofs;}
     gsMatrix<T> & fixedPart() {return _u.m_fixedDofs;}
 
-    gsFuncData<T> & data() {return *_u.m_fd;}
-    const gsFuncData<T> & data() const {return *_u.m_fd;}
+    gsFuncData<T> & data() {return const_cast<gsFuncData<T>&>(_u.data());}
+    const gsFuncData<T> & data() const {return _u.data();}
 
     void setSolutionVector(const gsMatrix<T>& solVector)
     { _Sv = & solVector; }
@@ -1178,6 +1437,65 @@ public:
     void print(std::ostream &os) const { _u.print(os); }
 };
 
+/*
+   Expression for a sub-expression that is computed once per
+   evaluation point, and shared by all its occurrences with the same
+   operands (see gsExprCache)
+*/
+template<class E>
+class cached_expr : public _expr<cached_expr<E> >
+{
+public:
+    typedef typename E::Scalar Scalar;
+private:
+    typename E::Nested_t _u;
+    const void * m_op;                       ///< the operand besides the geometry map
+    const gsGeometryMap<Scalar> & _G;        ///< the geometry map, which provides the cache
+    mutable index_t  m_slot;                 ///< slot in the cache
+    mutable unsigned m_generation;           ///< generation of the cache when m_slot was set
+    mutable gsMatrix<Scalar> tmp;
+
+public:
+    cached_expr(_expr<E> const& u, const void * op, const gsGeometryMap<Scalar> & G)
+    : _u(u), m_op(op), _G(G), m_slot(-1), m_generation(0) { }
+
+public:
+    enum {ColBlocks = E::ColBlocks};
+
+    const gsMatrix<Scalar> & eval(const index_t k) const
+    {
+        // not registered in the current cache: evaluate directly
+        if ( -1 == m_slot || m_generation != _G.cache().generation() )
+            return tmp = _u.eval(k);
+        return _G.cache().eval(m_slot, k, _u);
+    }
+
+    index_t rows() const { return _u.rows(); }
+    index_t cols() const { return _u.cols(); }
+
+    void setFlag() const
+    {
+        _u.setFlag();
+        // the key is the node type and the operands
+        std::ostringstream key, name;
+        key << typeid(E).name() <<" "<< m_op <<" "<< &_G;
+        _u.print(name);
+        m_slot = _G.cache().registerExpr(key.str(), name.str());
+        m_generation = _G.cache().generation();
+    }
+
+    void parse(gsSortedVector<const gsFunctionSet<Scalar>*> & evList) const
+    { _u.parse(evList); }
+
+    const gsFeVariable<Scalar> & rowVar() const { return _u.rowVar(); }
+    const gsFeVariable<Scalar> & colVar() const { return _u.colVar(); }
+
+    static bool rowSpan() {return E::rowSpan();}
+    static bool colSpan() {return E::colSpan();}
+
+    void print(std::ostream &os) const { _u.print(os); }
+};
+
 /*
    Expression for the trace of a (matrix) expression
  */
@@ -2106,6 +2424,9 @@ public:
         return _G.data().measures.at(k);
     }
 
+    void evalAll_impl(const index_t n, gsMatrix<T> & res) const
+    { res = _G.data().measures.leftCols(n); }
+
     index_t rows() const { return 0; }
     index_t cols() const { return 0; }
     void setFlag() const { _G.data().flags |= NEED_MEASURE; }
@@ -2223,6 +2544,48 @@ public:
         //return ( _u.eval(k) * _v.eval(k) );
     }
 
+    // Fused weighted sum over the points: a scalar factor is moved
+    // into the weights, and sum_k w[k]*A_k*B_k is computed as the
+    // single product [w[0]*A_0,...,w[n]*A_n] * [B_0;...;B_n]
+    void integrate_impl(const gsVector<Scalar> & w, gsMatrix<Scalar> & res) const
+    {
+        const index_t n = w.size();
+        if (E1::ScalarValued && E2::ScalarValued)
+        {
+            batch_eval<ScalarValued>::integrate(*this, w, res);
+            return;
+        }
+
+        gsMatrix<Scalar> U, V;
+        if (E2::ScalarValued)
+        {
+            _v.evalAll_into(n, V);
+            const gsVector<Scalar> ws = w.cwiseProduct(V.row(0).transpose());
+            _u.integrate_into(ws, res);
+            return;
+        }
+        if (E1::ScalarValued)
+        {
+            _u.evalAll_into(n, U);
+            const gsVector<Scalar> ws = w.cwiseProduct(U.row(0).transpose());
+            _v.integrate_into(ws, res);
+            return;
+        }
+
+        _u.evalAll_into(n, U);
+        _v.evalAll_into(n, V);
+        const index_t c = U.cols() / n, q = V.cols() / n;
+        GISMO_ASSERT(c == V.rows(), "Wrong dimensions "<<c<<"!="<<V.rows()<<" in * operation:\n"
+                     << _u <<" times \n" << _v );
+        gsMatrix<Scalar> Vs(c*n, q);
+        for (index_t k = 0; k != n; ++k)
+        {
+            U.middleCols(k*c, c) *= w[k];
+            Vs.middleRows(k*c, c) = V.middleCols(k*q, q);
+        }
+        res.noalias() = U * Vs;
+    }
+
     index_t rows() const { return E1::ScalarValued ? _v.rows()  : _u.rows(); }
     index_t cols() const { return E2::ScalarValued ? _u.cols()  : _v.cols(); }
     void setFlag() const { _u.setFlag(); _v.setFlag(); }
@@ -2354,6 +2717,9 @@ public:
         return ( _c * _v.eval(k) );
     }
 
+    void integrate_impl(const gsVector<Scalar> & w, gsMatrix<Scalar> & res) const
+    { _v.integrate_into(w, res); res *= _c; }
+
     index_t rows() const { return _v.rows(); }
     index_t cols() const { return _v.cols(); }
     void setFlag() const { _v.setFlag(); }
@@ -2642,6 +3008,16 @@ public:
         return _u.eval(k) + _v.eval(k);
     }
 
+    // The terms are integrated separately, so that products inside
+    // the sum are fused over the points
+    void integrate_impl(const gsVector<Scalar> & w, gsMatrix<Scalar> & res) const
+    {
+        gsMatrix<Scalar> tmp;
+        _u.integrate_into(w, res);
+        _v.integrate_into(w, tmp);
+        res += tmp;
+    }
+
     index_t rows() const { return _u.rows(); }
     index_t cols() const { return _u.cols(); }
     void setFlag() const { _u.setFlag(); _v.setFlag(); }
@@ -2766,6 +3142,14 @@ public:
         return (_u.eval(k) - _v.eval(k) );
     }
 
+    void integrate_impl(const gsVector<Scalar> & w, gsMatrix<Scalar> & res) const
+    {
+        gsMatrix<Scalar> tmp;
+        _u.integrate_into(w, res);
+        _v.integrate_into(w, tmp);
+        res -= tmp;
+    }
+
     index_t rows() const { return _u.rows(); }
     index_t cols() const { return _u.cols(); }
     void setFlag() const { _u.setFlag(); _v.setFlag(); }
@@ -2972,6 +3356,13 @@ operator-(typename E2::Scalar const& s, _expr<E2> const& v)
 }
 
 
+/// Marks \a e, which depends on the variable \a u and the geometry
+/// map \a G, as a common sub-expression (see gsExprCache)
+template<class E> EIGEN_STRONG_INLINE
+cached_expr<E> cached(const _expr<E> & e, const gsFeVariable<typename E::Scalar> & u,
+                      const gsGeometryMap<typename E::Scalar> & G)
+{ return cached_expr<E>(e, &u, G); }
+
 //----------------------------------------------------------------------------------
 #if __cplusplus >= 201402L || _MSVC_LANG >= 201402L
 
@@ -2991,13 +3382,13 @@ GISMO_SHORTCUT_PHY_EXPRESSION( idiv, ijac(u,G).trace()    )
 // The unit (normalized) boundary (outer pointing) normal
 GISMO_SHORTCUT_MAP_EXPRESSION(unv, nv(G).normalized()   ) //(!) bug + mem. leak
 
-GISMO_SHORTCUT_PHY_EXPRESSION(igrad, grad(u)*jac(G).ginv() ) // transpose() problem ??
+GISMO_SHORTCUT_PHY_EXPRESSION(igrad, cached(grad(u)*jac(G).ginv(),u,G) ) // transpose() problem ??
 GISMO_SHORTCUT_VAR_EXPRESSION(igrad, grad(u) ) // u is presumed to be defined over G
 
-GISMO_SHORTCUT_PHY_EXPRESSION( ijac, jac(u) * jac(G).ginv())
+GISMO_SHORTCUT_PHY_EXPRESSION( ijac, cached(jac(u) * jac(G).ginv(),u,G))
 
 GISMO_SHORTCUT_PHY_EXPRESSION(ihess,
-jac(G).ginv().tr()*( hess(u) - summ(igrad(u,G),hess(G)) ) * jac(G).ginv() )
+cached(jac(G).ginv().tr()*( hess(u) - summ(igrad(u,G),hess(G)) ) * jac(G).ginv(),u,G) )
 GISMO_SHORTCUT_VAR_EXPRESSION(ihess, hess(u) )
 
 GISMO_SHORTCUT_PHY_EXPRESSION(ilapl, ihess(u,G).trace()   )
@@ -3018,25 +3409,25 @@ GISMO_SHORTCUT_VAR_EXPRESSION(div, jac(u).trace() )
 template<class T> EIGEN_STRONG_INLINE normalized_expr<onormal_expr<T> >
 GISMO_SHORTCUT_MAP_EXPRESSION(unv, nv(G).normalized() )
 
-template<class T> EIGEN_STRONG_INLINE mult_expr<grad_expr<T>,jacGinv_expr<T>, 0>
-GISMO_SHORTCUT_PHY_EXPRESSION(igrad, grad(u)*jac(G).ginv())
+template<class T> EIGEN_STRONG_INLINE cached_expr<mult_expr<grad_expr<T>,jacGinv_expr<T>, 0> >
+GISMO_SHORTCUT_PHY_EXPRESSION(igrad, cached(grad(u)*jac(G).ginv(),u,G))
 
 template<class T> EIGEN_STRONG_INLINE grad_expr<T> // u is presumed to be defined over G
 GISMO_SHORTCUT_VAR_EXPRESSION(igrad, grad(u))
 
-template<class T> EIGEN_STRONG_INLINE mult_expr<jac_expr<T>,jacGinv_expr<T>, 1>
-GISMO_SHORTCUT_PHY_EXPRESSION(ijac, jac(u) * jac(G).ginv() )
+template<class T> EIGEN_STRONG_INLINE cached_expr<mult_expr<jac_expr<T>,jacGinv_expr<T>, 1> >
+GISMO_SHORTCUT_PHY_EXPRESSION(ijac, cached(jac(u) * jac(G).ginv(),u,G) )
 
-template<class T> EIGEN_STRONG_INLINE trace_expr<mult_expr<jac_expr<T>,jacGinv_expr<T>, 1> >
+template<class T> EIGEN_STRONG_INLINE trace_expr<cached_expr<mult_expr<jac_expr<T>,jacGinv_expr<T>, 1> > >
 GISMO_SHORTCUT_PHY_EXPRESSION(idiv, ijac(u,G).trace() )
 
-template<class T> EIGEN_STRONG_INLINE mult_expr<mult_expr<tr_expr<jacGinv_expr<T> >,sub_expr<hess_expr<T>,summ_expr<mult_expr<grad_expr<T>, jacGinv_expr<T>, 0>, hess_expr<T> > >, 0>, jacGinv_expr<T>, 1>
-GISMO_SHORTCUT_PHY_EXPRESSION(ihess, jac(G).ginv().tr()*(hess(u)-summ(igrad(u,G),hess(G)))*jac(G).ginv() )
+template<class T> EIGEN_STRONG_INLINE cached_expr<mult_expr<mult_expr<tr_expr<jacGinv_expr<T> >,sub_expr<hess_expr<T>,summ_expr<cached_expr<mult_expr<grad_expr<T>, jacGinv_expr<T>, 0> >, hess_expr<T> > >, 0>, jacGinv_expr<T>, 1> >
+GISMO_SHORTCUT_PHY_EXPRESSION(ihess, cached(jac(G).ginv().tr()*(hess(u)-summ(igrad(u,G),hess(G)))*jac(G).ginv(),u,G) )
 
 template<class T> EIGEN_STRONG_INLINE hess_expr<T>
 GISMO_SHORTCUT_VAR_EXPRESSION(ihess, hess(u) )
 
-template<class T> EIGEN_STRONG_INLINE trace_expr< mult_expr<mult_expr<tr_expr<jacGinv_expr<T> >, sub_expr<hess_expr<T>, summ_expr<mult_expr<grad_expr<T>, jacGinv_expr<T>, 0>, hess_expr<T> > >, 0>, jacGinv_expr<T>, 1> >
+template<class T> EIGEN_STRONG_INLINE trace_expr<cached_expr<mult_expr<mult_expr<tr_expr<jacGinv_expr<T> >, sub_expr<hess_expr<T>, summ_expr<cached_expr<mult_expr<grad_expr<T>, jacGinv_expr<T>, 0> >, hess_expr<T> > >, 0>, jacGinv_expr<T>, 1> > >
 GISMO_SHORTCUT_PHY_EXPRESSION(ilapl, ihess(u,G).trace() )
 
 template<class T> EIGEN_STRONG_INLINE trace_expr<hess_expr<T> >
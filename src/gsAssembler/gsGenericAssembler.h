@@ -83,6 +83,8 @@ public:
             (iFace::strategy)(m_options.getInt("InterfaceStrategy")),
             this->pde().bc(), mapper, 0);
         m_system = gsSparseSystem<T>(mapper);
+        m_ddofSolver.clear();
+        m_ddofLumped.clear();
         //note: no allocation here
         //        const index_t nz = m_options.numColNz(m_bases[0][0]);
         //        m_system.reserve(nz, 1);
@@ -240,6 +242,8 @@ private:
     using Base::m_ddof;
     using Base::m_options;
     using Base::m_system;
+    using Base::m_ddofSolver;
+    using Base::m_ddofLumped;
 
 private:
 
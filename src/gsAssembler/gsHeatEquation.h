@@ -27,6 +27,9 @@ namespace gismo
     - Crank-Nicolson semi-implicit scheme (theta=0.5)
     - implicit Euler scheme (theta=1)
     
+    For many time steps, see gsHeatTimeStepper, which keeps the
+    factorizations of the system matrices.
+
     \ingroup Assembler
 */
 template <class T>
@@ -100,7 +103,7 @@ public:
 
     const gsSparseMatrix<T> & mass() const { return m_mass; }
     const gsSparseMatrix<T> & stationaryMatrix() const { return m_stationary->matrix(); }
-    const gsSparseMatrix<T> & stationaryRhs() const { return m_stationary->rhs(); }
+    const gsMatrix<T> & stationaryRhs() const { return m_stationary->rhs(); }
     
     /// Mass assembly routine
     void assembleMass();
@@ -172,7 +175,8 @@ void gsHeatEquation<T>::nextTimeStep(const gsSparseMatrix<T> & sysMatrix,
     m_system.matrix() = massMatrix + c1 * sysMatrix;
 
     const T c2 = Dt * (1.0 - m_theta);
-    m_system.rhs().noalias() = c1 * rhs1 + c2 * rhs0 + (massMatrix - c2 * sysMatrix) * curSolution;
+    m_system.rhs().noalias() = c1 * rhs1 + c2 * rhs0 + massMatrix * curSolution;
+    m_system.rhs().noalias() -= c2 * (sysMatrix * curSolution);
 }
 
 template<class T>
@@ -189,7 +193,8 @@ void gsHeatEquation<T>::nextTimeStepFixedRhs(const gsSparseMatrix<T> & sysMatrix
     m_system.matrix() = massMatrix + c1 * sysMatrix;
 
     const T c2 = Dt * (1.0 - m_theta);
-    m_system.rhs().noalias() = Dt * rhs + (massMatrix - c2 * sysMatrix) * curSolution;
+    m_system.rhs().noalias() = Dt * rhs + massMatrix * curSolution;
+    m_system.rhs().noalias() -= c2 * (sysMatrix * curSolution);
 }
 
 
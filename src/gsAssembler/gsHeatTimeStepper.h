@@ -0,0 +1,323 @@
+/** @file gsHeatTimeStepper.h
+
+    @brief Time integration of the heat equation with cached
+    factorizations.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsAssembler/gsHeatEquation.h>
+#include <gsSolver/gsMatrixOp.h>
+
+namespace gismo
+{
+
+/** \brief Integrates in time the semi-discrete heat equation
+    \f$ M u' + K u = f \f$ assembled by gsHeatEquation.
+
+    Every implicit scheme below solves systems with the matrix \f$ M
+    + c K \f$, where \a c depends only on the step size. The stepper
+    factorizes this matrix once for every distinct \a c and keeps the
+    factorizations (at most "CacheSize" of them), so a time step
+    costs only the update of the right-hand side and the
+    substitutions. The right-hand sides are formed by a single pass
+    over the columns of \a M and \a K, without forming \f$ M - c K
+    \f$.
+
+    The schemes (option "Scheme") are
+
+    - the theta-scheme (0), eg. Crank-Nicolson for theta=0.5 (option
+      "Theta"),
+    - the variable-step BDF2 scheme (1), started by one SDIRK2 step,
+    - the two-stage, L-stable SDIRK2 scheme of Alexander (2). Both
+      stages use the same matrix.
+
+    With the option "Adaptive" and the SDIRK2 scheme, integrate()
+    controls the step size by the embedded first-order error
+    estimate. The step sizes are the initial one times powers of two,
+    so that the factorizations are reused across the accepted steps.
+
+    The right-hand side and the Dirichlet values are assumed constant
+    in time, as in gsHeatEquation::nextTimeStep.
+
+    \ingroup Assembler
+*/
+template <class T>
+class gsHeatTimeStepper
+{
+public:
+
+    /// Time integration schemes
+    enum scheme
+    {
+        theta  = 0, ///< theta-scheme
+        bdf2   = 1, ///< BDF2, variable step
+        sdirk2 = 2  ///< two-stage SDIRK of order 2
+    };
+
+    typedef typename gsLinearOperator<T>::Ptr OpPtr;
+
+public:
+
+    /// Constructor, \a heat must be assembled
+    explicit gsHeatTimeStepper(const gsHeatEquation<T> & heat)
+    : m_heat(&heat), m_options(defaultOptions())
+    { reset(); }
+
+    /// Returns the default options
+    static gsOptionList defaultOptions()
+    {
+        gsOptionList opt;
+        opt.addInt   ("Scheme"   , "Time integration scheme (0: theta, 1: BDF2, 2: SDIRK2)", sdirk2);
+        opt.addReal  ("Theta"    , "Theta parameter of the theta-scheme [0..1]", 0.5);
+        opt.addSwitch("Adaptive" , "Adapt the step size to the local error (SDIRK2 only)", false);
+        opt.addReal  ("Tolerance", "Tolerance of the local error of adaptive steps", 1e-4);
+        opt.addReal  ("MinStep"  , "Smallest step size of adaptive steps", 1e-10);
+        opt.addSwitch("Symmetric", "Factorize by sparse Cholesky instead of sparse LU", true);
+        opt.addInt   ("CacheSize", "Maximum number of cached factorizations", 4);
+        return opt;
+    }
+
+    /// Access to the options
+    gsOptionList & options() { return m_options; }
+
+    /// Forgets the previous steps (for BDF2) and the cached
+    /// factorizations. Call this after changing the options or the
+    /// assembled matrices.
+    void reset()
+    {
+        m_cache.clear();
+        m_prev.resize(0, 0);
+        m_prevDt = 0;
+        m_numFact = m_numSteps = m_numRejected = 0;
+    }
+
+    /** \brief Advances the solution \a u by one step of size \a Dt
+
+        For BDF2, the previous solution is taken from the last call of
+        step() or integrate(); call reset() before integrating from a
+        new initial value.
+    */
+    void step(gsMatrix<T> & u, const T Dt)
+    {
+        GISMO_ASSERT( u.rows() == m_heat->mass().cols(),
+                      "Wrong size in current solution vector.");
+        switch ( m_options.getInt("Scheme") )
+        {
+        case theta:
+        {
+            const T th = m_options.getReal("Theta");
+            GISMO_ASSERT(th<=1 && th>=0, "Invalid value");
+            rhsInto(u, -Dt * (1 - th), Dt, m_rhs);
+            solveInto(Dt * th, m_rhs, u);
+            break;
+        }
+        case bdf2:
+            if ( 0 == m_prev.size() )
+            {
+                m_prev = u;
+                sdirk2Step(u, Dt, m_sol);
+                u.swap(m_sol);
+            }
+            else
+            {
+                // (1+2w)/(1+w) u_{n+1} - (1+w) u_n + w^2/(1+w) u_{n-1} = Dt u'_{n+1}
+                const T w = Dt / m_prevDt;
+                const T beta = (1 + w) / (1 + 2 * w);
+                m_sol.noalias() = (1 + w) * u - (w * w / (1 + w)) * m_prev;
+                m_prev = u;
+                rhsInto(m_sol, 0, Dt, m_rhs);
+                m_rhs *= beta;
+                solveInto(beta * Dt, m_rhs, u);
+            }
+            break;
+        case sdirk2:
+            sdirk2Step(u, Dt, m_sol);
+            u.swap(m_sol);
+            break;
+        default:
+            GISMO_ERROR("Unknown time integration scheme.");
+        }
+        m_prevDt = Dt;
+        ++m_numSteps;
+    }
+
+    /** \brief Integrates the solution \a u from time \a t to time \a
+        endTime, with steps of size \a Dt
+
+        With the option "Adaptive" (and the SDIRK2 scheme) \a Dt is
+        only the initial step size, and it is halved or doubled
+        according to the estimated local error.
+
+        \returns the number of accepted steps
+    */
+    index_t integrate(gsMatrix<T> & u, T t, const T endTime, T Dt)
+    {
+        GISMO_ASSERT( Dt > 0, "The step size must be positive.");
+        const bool adapt = m_options.getSwitch("Adaptive") &&
+            sdirk2 == m_options.getInt("Scheme");
+        const T tol    = m_options.getReal("Tolerance");
+        const T minDt  = m_options.getReal("MinStep");
+        const T eps    = (endTime - t) * std::numeric_limits<T>::epsilon() * 10;
+        const index_t steps0 = m_numSteps;
+
+        while ( endTime - t > eps )
+        {
+            // Rounding of t must not produce a new step size (and
+            // factorization) at the end of the interval
+            const T h = endTime - t < Dt - eps ? endTime - t : Dt;
+            if ( !adapt )
+            {
+                step(u, h);
+                t += h;
+                continue;
+            }
+
+            // The error is of order two, the step size factor which
+            // meets the tolerance is about 1/sqrt(err)
+            const T err = sdirk2Step(u, h, m_sol, tol);
+            const T fac = (T)(0.9) / math::sqrt( math::max(err, (T)(1e-10)) );
+            if ( err <= 1 )
+            {
+                u.swap(m_sol);
+                t += h;
+                m_prevDt = h;
+                ++m_numSteps;
+                if ( h == Dt && fac >= 2 )
+                    Dt *= 2;
+            }
+            else
+            {
+                ++m_numRejected;
+                Dt = math::min(Dt, h);
+                do { Dt /= 2; } while ( Dt > fac * h && Dt > minDt );
+                GISMO_ENSURE( Dt >= minDt, "Step size below the minimum at time "<< t );
+            }
+        }
+        return m_numSteps - steps0;
+    }
+
+    /// Number of factorizations computed since the last reset()
+    index_t numFactorizations() const { return m_numFact; }
+
+    /// Number of steps performed since the last reset()
+    index_t numSteps() const { return m_numSteps; }
+
+    /// Number of rejected adaptive steps since the last reset()
+    index_t numRejected() const { return m_numRejected; }
+
+private:
+
+    /// \a r = M \a x + \a b K \a x + \a c f, in one pass over the
+    /// columns of M and K
+    void rhsInto(const gsMatrix<T> & x, const T b, const T c, gsMatrix<T> & r) const
+    {
+        const gsSparseMatrix<T> & M = m_heat->mass();
+        const gsSparseMatrix<T> & K = m_heat->stationaryMatrix();
+        const gsMatrix<T>       & f = m_heat->stationaryRhs();
+        GISMO_ASSERT( x.cols() == f.cols(), "Wrong number of right-hand sides.");
+
+        r.noalias() = c * f;
+        for (index_t j = 0; j != x.cols(); ++j)
+            for (index_t k = 0; k != M.outerSize(); ++k)
+            {
+                const T xk = x(k,j), bxk = b * xk;
+                for (typename gsSparseMatrix<T>::InnerIterator it(M,k); it; ++it)
+                    r(it.row(),j) += it.value() * xk;
+                if ( 0 != b )
+                    for (typename gsSparseMatrix<T>::InnerIterator it(K,k); it; ++it)
+                        r(it.row(),j) += it.value() * bxk;
+            }
+    }
+
+    /// Solves (M + \a c K) \a x = \a rhs, with a cached factorization
+    void solveInto(const T c, const gsMatrix<T> & rhs, gsMatrix<T> & x)
+    {
+        typename std::map<T,OpPtr>::iterator it = m_cache.find(c);
+        if ( it == m_cache.end() )
+        {
+            // Make room by dropping the factorization farthest from c
+            const size_t maxSize = math::max((index_t)1, m_options.getInt("CacheSize"));
+            while ( m_cache.size() >= maxSize )
+            {
+                typename std::map<T,OpPtr>::iterator far =
+                    math::abs(m_cache.begin()->first - c) > math::abs(m_cache.rbegin()->first - c)
+                    ? m_cache.begin() : --m_cache.end();
+                m_cache.erase(far);
+            }
+
+            const gsSparseMatrix<T> A = m_heat->mass() + c * m_heat->stationaryMatrix();
+            OpPtr op;
+            if ( m_options.getSwitch("Symmetric") )
+                op = makeSparseCholeskySolver(A);
+            else
+                op = makeSparseLUSolver(A);
+            it = m_cache.insert(std::make_pair(c, op)).first;
+            ++m_numFact;
+        }
+        it->second->apply(rhs, x);
+    }
+
+    /** Performs a step of SDIRK2 from \a u to \a u1. If \a tol is
+        positive, returns the scaled norm of the difference to the
+        embedded first-order solution, zero otherwise.
+
+        With \f$ \gamma = 1 - 1/\sqrt{2} \f$ the stages solve
+        \f$ (M + \gamma \Delta t K) Y_i = M (u + \sum_{j<i} a_{ij} k_j) +
+        \gamma \Delta t f \f$, where \f$ k_j = \Delta t M^{-1}(f - K Y_j) \f$
+        is recovered from the stage values, and \f$ u_1 = Y_2 \f$.
+    */
+    T sdirk2Step(const gsMatrix<T> & u, const T Dt, gsMatrix<T> & u1, const T tol = 0)
+    {
+        const T gamma = 1 - 1 / math::sqrt((T)2);
+        const T c = gamma * Dt;
+
+        rhsInto(u, 0, c, m_rhs);
+        solveInto(c, m_rhs, m_stage);
+        m_stage -= u;
+        m_stage /= gamma;                        // k_1
+        m_sol2.noalias() = u + (1 - gamma) * m_stage;
+        rhsInto(m_sol2, 0, c, m_rhs);
+        solveInto(c, m_rhs, u1);
+
+        if ( tol <= 0 ) return 0;
+
+        // u1 - \hat u1 = gamma (k_2 - k_1), where the embedded solution
+        // \hat u1 = u + k_1 is of first order
+        m_sol2.noalias() = u1 - m_sol2 - gamma * m_stage;  // gamma k_2 - gamma k_1
+        T sum = 0;
+        for (index_t i = 0; i != m_sol2.size(); ++i)
+        {
+            const T sc = tol * ( 1 + math::max(math::abs(u.data()[i]), math::abs(u1.data()[i])) );
+            const T e = m_sol2.data()[i] / sc;
+            sum += e * e;
+        }
+        return math::sqrt( sum / math::max((index_t)1, m_sol2.size()) );
+    }
+
+private:
+
+    const gsHeatEquation<T> * m_heat;
+
+    gsOptionList m_options;
+
+    /// Factorizations of M + c K, by c
+    std::map<T,OpPtr> m_cache;
+
+    /// Previous solution and step size (for BDF2)
+    gsMatrix<T> m_prev;
+    T m_prevDt;
+
+    /// Work vectors
+    gsMatrix<T> m_rhs, m_sol, m_sol2, m_stage;
+
+    index_t m_numFact, m_numSteps, m_numRejected;
+};
+
+} // namespace gismo
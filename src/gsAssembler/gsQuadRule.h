@@ -171,19 +171,17 @@ gsQuadRule<T>::mapTo( const gsVector<T>& lower, const gsVector<T>& upper,
     GISMO_ASSERT( d == m_nodes.rows(), "Inconsistent quadrature mapping");
 
     nodes.resize( m_nodes.rows(), m_nodes.cols() );
-    weights.resize( m_weights.size() );
-    nodes.setZero();
-    weights.setZero();
-
-    const gsVector<T> h = (upper-lower) / T(2) ;
-    // Linear map from [-1,1]^d to [lower,upper]
-    nodes.noalias() = ( h.asDiagonal() * (m_nodes.array()+1).matrix() ).colwise() + lower;
 
     T hprod(1.0); //volume of the cube.
     for ( index_t i = 0; i!=d; ++i)
     {
+        // Linear map from [-1,1] to [lower,upper] in direction i
+        // (row-wise, so that no temporaries are allocated per element)
+        const T h = (upper[i]-lower[i]) / T(2) ;
+        nodes.row(i).array() = h * (m_nodes.row(i).array()+1) + lower[i];
+
         // the factor 0.5 is due to the reference interval is [-1,1].
-        hprod *= ( 0 == h[i] ? T(0.5) : h[i] );
+        hprod *= ( 0 == h ? T(0.5) : h );
     }
 
     // Adjust the weights (multiply by the Jacobian of the linear map)
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <gsCore/gsStdVectorRef.h>
+#include <gsUtils/gsProfiler.h>
 
 namespace gismo
 {
@@ -329,6 +330,7 @@ public:
         GISMO_ASSERT( 0 != m_mappers.size(), "Sparse system was not initialized");
         if ( 0 != m_matrix.cols() )
         {
+            GISMO_PROFILE_COUNT(allocations, 1);
             m_matrix.reservePerColumn(nz);
             if ( 0 != numRhs )
                 m_rhs.setZero(m_matrix.cols(), numRhs);
@@ -919,6 +921,32 @@ public: /* Add local contributions to system right-hand side */
     }
 
 
+    /**
+     * @brief pushToRhsPoints pushes the contributions of point sources to the global system
+     * \note checks are done if an index is eliminated or not
+     * @param[in] bVals the values of the active basis functions, one column per point
+     * @param[in] actives the corresponding mapped indices without shifts, one column per point
+     * @param[in] loads the values of the sources, one column per point
+     * @param[in] r the row block associated to
+     */
+    void pushToRhsPoints(const gsMatrix<T> & bVals,
+                         const gsMatrix<index_t> & actives,
+                         const gsMatrix<T> & loads,
+                         const size_t r = 0)
+    {
+        const gsDofMapper & mapper = m_mappers[m_row.at(r)];
+        const index_t rstr = m_rstr.at(r);
+        GISMO_ASSERT( loads.rows() == m_rhs.cols(), "Wrong size of the point loads");
+
+        for (index_t j = 0; j != actives.cols(); ++j)
+            for (index_t i = 0; i != actives.rows(); ++i)
+            {
+                const index_t a = actives(i,j);
+                if ( mapper.is_free_index(a) )
+                    m_rhs.row(rstr + a).noalias() += bVals(i,j) * loads.col(j).transpose();
+            }
+    }
+
     /**
      * @brief pushToRhs pushes one local rhs consisting of several blocks corresponding to blocks of the global system
      * \note Usefull for rhs depending on a vector valued function
@@ -969,8 +997,8 @@ public: /* Add local contributions to system matrix and right-hand side */
      * @param[in] r the row block
      * @param[in] c the column block
      */
-    void push(const gsMatrix<T> & localMat,
-              const gsMatrix<T> & localRhs,
+    void push(typename gsMatrix<T>::constRef & localMat,
+              typename gsMatrix<T>::constRef & localRhs,
               const gsMatrix<index_t> & actives,
               const gsMatrix<T> & eliminatedDofs,
               const size_t r = 0, const size_t c = 0)
@@ -1023,8 +1051,8 @@ public: /* Add local contributions to system matrix and right-hand side */
      * @param[in] r the row block
      * @param[in] c the column block
      */
-    void push(const gsMatrix<T> & localMat,
-              const gsMatrix<T> & localRhs,
+    void push(typename gsMatrix<T>::constRef & localMat,
+              typename gsMatrix<T>::constRef & localRhs,
               const gsMatrix<index_t> & actives_i,
               const gsMatrix<index_t> & actives_j,
               const gsMatrix<T> & eliminatedDofs_j,
@@ -1079,8 +1107,8 @@ public: /* Add local contributions to system matrix and right-hand side */
      * @param[in] r the row block
      * @param[in] c the column block
      */
-    void pushAllFree(const gsMatrix<T>  & localMat,
-                     const gsMatrix<T>  & localRhs,
+    void pushAllFree(typename gsMatrix<T>::constRef & localMat,
+                     typename gsMatrix<T>::constRef & localRhs,
                      const gsMatrix<index_t> & actives,
                      const size_t r = 0, const size_t c = 0)
     {
@@ -22,6 +22,12 @@ namespace gismo
  * \f[ (\Delta u,\Delta v)_\Omega \text{ and } (f,v)_\Omega \f]
  * For \f[ u = g \quad on \quad \partial \Omega \f],
  *
+ * For planar and volume domains the physical Laplacians of all
+ * active functions are computed at once per quadrature node, as
+ * \f$ \Delta u = w \cdot \partial^2 u - d \cdot \nabla u \f$ with
+ * the parametric derivatives of \a u and coefficients \a w, \a d
+ * which depend only on the geometry. These coefficients can be kept
+ * across assemblies, see setGeometryCache().
  */
 
 template <class T>
@@ -30,6 +36,7 @@ class gsVisitorBiharmonic
 public:
 
     gsVisitorBiharmonic(const gsPde<T> & pde)
+    : m_cache(NULL), m_count(0)
     { 
         rhs_ptr = static_cast<const gsBiharmonicPde<T>&>(pde).rhs() ;
     }
@@ -39,11 +46,24 @@ public:
      * \param[in] rhs Given right-hand-side function/source term that, for
      */
     gsVisitorBiharmonic(const gsFunction<T> & rhs) :
-        rhs_ptr(&rhs)
+        rhs_ptr(&rhs), m_cache(NULL), m_count(0)
     {
         GISMO_ASSERT( rhs.targetDim() == 1 ,"Not yet tested for multiple right-hand-sides");
     }
 
+    /** \brief Keeps the geometric data at the quadrature nodes of the
+     * elements of a patch in \a cache, which has one (initially
+     * empty) matrix per element.
+     *
+     * The elements are numbered in the order of gsAssembler::apply,
+     * where thread \a t of \a n visits the elements \a t, \a t+n,
+     * ... of the domain iterator. Entries whose nodes do not match
+     * the element are recomputed, hence the cache survives changes
+     * of the basis or of the quadrature, but it must be cleared when
+     * the geometry changes (as gsBiharmonicAssembler does).
+     */
+    void setGeometryCache(std::vector<gsMatrix<T> > & cache) { m_cache = &cache; }
+
     void initialize(const gsBasis<T> & basis,
                     gsQuadRule<T>    & rule)
     {
@@ -75,23 +95,58 @@ public:
                          const gsGeometry<T>    & geo,
                          gsMatrix<T>            & quNodes)
     {
-        md.points = quNodes;
         // Compute the active basis functions
         // Assumes actives are the same for all quadrature points on the elements
-        basis.active_into(md.points.col(0), actives);
+        basis.active_into(quNodes.col(0), actives);
         numActive = actives.rows();
 
         //deriv2_into()
         //col(point) = B1_xx B2_yy B1_zz B_xy B1_xz B1_xy B2_xx ...
 
         // Evaluate basis functions on element
-        basis.evalAllDers_into(md.points, 2, basisData);
+        basis.evalAllDers_into(quNodes, 2, basisData);
+
+        // Index of the element in the order of gsAssembler::apply
+#       ifdef _OPENMP
+        const index_t el = omp_get_thread_num() + omp_get_num_threads() * m_count++;
+#       else
+        const index_t el = m_count++;
+#       endif
+
+        const short_t parDim = basis.dim(), geoDim = geo.targetDim();
+        m_square = ( parDim == geoDim );
+        m_dim = parDim;
+        if ( m_square )
+        {
+            gsMatrix<T> * cached = ( m_cache && el < static_cast<index_t>(m_cache->size()) )
+                ? &(*m_cache)[el] : NULL;
+
+            // The cached data starts with the quadrature nodes, these
+            // identify the element
+            if ( cached && cached->cols() == quNodes.cols() &&
+                 cached->topRows(parDim) == quNodes )
+                geoData = cached;
+            else
+            {
+                md.points = quNodes;
+                geo.computeMap(md);
+                computeGeometryData(quNodes, localGeo);
+                if ( cached ) { cached->swap(localGeo); geoData = cached; }
+                else          { geoData = &localGeo; }
+            }
 
-        // Compute image of Gauss nodes under geometry mapping as well as Jacobians
-        geo.computeMap(md);
+            // Evaluate right-hand side at the geometry points
+            rhs_ptr->eval_into(geoData->middleRows(parDim + 1, geoDim), rhsVals); // Dim: 1 X NumPts
+        }
+        else
+        {
+            md.points = quNodes;
+            // Compute image of Gauss nodes under geometry mapping as well as Jacobians
+            geo.computeMap(md);
 
-        // Evaluate right-hand side at the geometry points
-        rhs_ptr->eval_into(md.values[0], rhsVals); // Dim: 1 X NumPts
+            // Evaluate right-hand side at the geometry points
+            rhs_ptr->eval_into(md.values[0], rhsVals); // Dim: 1 X NumPts
+        }
 
         // Initialize local matrix/rhs
         localMat.setZero(numActive, numActive);
@@ -105,20 +160,47 @@ public:
         gsMatrix<T> & basisVals  = basisData[0];
         gsMatrix<T> & basisGrads = basisData[1];
         gsMatrix<T> & basis2ndDerivs = basisData[2];
+        const index_t nPts = quWeights.rows();
 
-        for (index_t k = 0; k < quWeights.rows(); ++k) // loop over quadrature nodes
+        if ( !m_square )
         {
-            // Multiply weight by the geometry measure
-            const T weight = quWeights[k] * md.measure(k);
+            for (index_t k = 0; k < nPts; ++k) // loop over quadrature nodes
+            {
+                // Multiply weight by the geometry measure
+                const T weight = quWeights[k] * md.measure(k);
 
-            // Compute physical laplacian at k as a 1 x numActive matrix
-            transformLaplaceHgrad(md, k, basisGrads, basis2ndDerivs, physBasisLaplace);
+                // Compute physical laplacian at k as a 1 x numActive matrix
+                transformLaplaceHgrad(md, k, basisGrads, basis2ndDerivs, physBasisLaplace);
 
-            // (\Delta u, \Delta v)
-            localMat.noalias() += weight * (physBasisLaplace.transpose() * physBasisLaplace);
+                // (\Delta u, \Delta v)
+                localMat.noalias() += weight * (physBasisLaplace.transpose() * physBasisLaplace);
 
-            localRhs.noalias() += weight * ( basisVals.col(k) * rhsVals.col(k).transpose() ) ;
+                localRhs.noalias() += weight * ( basisVals.col(k) * rhsVals.col(k).transpose() ) ;
+            }
+            return;
         }
+
+        // Physical laplacians of all active functions at all nodes
+        const gsMatrix<T> & gd = *geoData;
+        const index_t parDim = m_dim, geoDim = m_dim;
+        const index_t nsd = parDim * (parDim + 1) / 2;
+        physBasisLaplace.resize(numActive, nPts);
+        for (index_t k = 0; k < nPts; ++k)
+        {
+            const gsAsConstMatrix<T> d2(basis2ndDerivs.col(k).data(), nsd, numActive);
+            const gsAsConstMatrix<T> d1(basisGrads.col(k).data(), parDim, numActive);
+            physBasisLaplace.col(k).noalias() =
+                d2.transpose() * gd.col(k).segment(parDim + 1 + geoDim, nsd)
+                - d1.transpose() * gd.col(k).tail(parDim);
+        }
+
+        // Weights times the geometry measure
+        weights = quWeights.array() * gd.row(parDim).transpose().array();
+
+        // (\Delta u, \Delta v)
+        localMat.noalias() = physBasisLaplace * weights.asDiagonal() * physBasisLaplace.transpose();
+
+        localRhs.noalias() = basisVals * weights.asDiagonal() * rhsVals.transpose();
     }
 
     inline void localToGlobal(const index_t                     patchIndex,
@@ -169,10 +251,58 @@ public:
     */
 
 
+protected:
+
+    /// Computes the geometric data at the nodes \a quNodes, after
+    /// computeMap: the nodes, the measure, the physical points and the
+    /// coefficients \a w and \a d of the Laplacian (see the class
+    /// documentation), one column per node
+    void computeGeometryData(const gsMatrix<T> & quNodes, gsMatrix<T> & result) const
+    {
+        typedef Eigen::Matrix<T,Dynamic,Dynamic,ColMajor,3,3> smallMatrix;
+        typedef Eigen::Matrix<T,Dynamic,1,ColMajor,6,1>       smallVector;
+
+        const index_t parDim = md.dim.first, geoDim = md.dim.second;
+        const index_t nsd = parDim * (parDim + 1) / 2;
+        result.resize(2 * parDim + 1 + geoDim + nsd, quNodes.cols());
+        result.topRows(parDim) = quNodes;
+        result.row(parDim) = md.measures;
+        result.middleRows(parDim + 1, geoDim) = md.values[0];
+
+        smallVector w(nsd);
+        for (index_t k = 0; k != quNodes.cols(); ++k)
+        {
+            // The physical Hessian is J^{-T} (H(u) - sum_l (grad u)_l H(x_l)) J^{-1},
+            // its trace is G : (H(u) - sum_l (grad u)_l H(x_l)) with G = J^{-1} J^{-T}
+            const smallMatrix Jinv = md.jacobian(k).inverse();
+            const smallMatrix G = Jinv * Jinv.transpose();
+            for (index_t a = 0; a != parDim; ++a)
+                w[a] = G(a,a);
+            index_t c = parDim;
+            for (index_t a = 0; a != parDim; ++a)
+                for (index_t b = a + 1; b != parDim; ++b)
+                    w[c++] = 2 * G(a,b);
+
+            // Second derivatives of the geometry, one column per coordinate
+            const gsAsConstMatrix<T> geoD2(md.values[2].col(k).data(), nsd, geoDim);
+            result.col(k).segment(parDim + 1 + geoDim, nsd) = w;
+            result.col(k).tail(parDim).noalias() = Jinv * (geoD2.transpose() * w);
+        }
+    }
+
 protected:
     // Right hand side
     const gsFunction<T> * rhs_ptr;
 
+    // Geometric data, see setGeometryCache
+    std::vector<gsMatrix<T> > * m_cache;
+    index_t m_count;
+    bool m_square;
+    short_t m_dim;
+    gsMatrix<T> localGeo;
+    const gsMatrix<T> * geoData;
+    gsVector<T> weights;
+
 protected:
     // Basis values
     std::vector<gsMatrix<T> > basisData;
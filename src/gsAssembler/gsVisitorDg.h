@@ -40,6 +40,9 @@ public:
      */
 
     gsVisitorDg(const gsPde<T> &)
+    : phGrad1(NULL, 0, 0), phGrad2(NULL, 0, 0),
+      B11(NULL, 0, 0), B12(NULL, 0, 0), E11(NULL, 0, 0), E12(NULL, 0, 0), N1(NULL, 0, 0),
+      B22(NULL, 0, 0), B21(NULL, 0, 0), E22(NULL, 0, 0), E21(NULL, 0, 0), N2(NULL, 0, 0)
     {}
 
     void initialize(const gsBasis<T> & basis1,
@@ -59,6 +62,10 @@ public:
 
         // Set Geometry evaluation flags
         md1.flags = md2.flags = NEED_VALUE|NEED_JACOBIAN|NEED_GRAD_TRANSFORM;
+
+        // Every (thread-private) visitor creates its own evaluators
+        basisEval1.reset();
+        basisEval2.reset();
     }
 
     // Evaluate on element.
@@ -78,18 +85,27 @@ public:
         const index_t numActive2 = actives2.rows();
 
         // Evaluate basis functions and their first derivatives
-        B1.evalAllDers_into( md1.points, 1, basisData1);
-        B2.evalAllDers_into( md2.points, 1, basisData2);
+        if ( !basisEval1 || &basisEval1->basis() != &B1 )
+            basisEval1 = B1.makeEvaluator();
+        if ( !basisEval2 || &basisEval2->basis() != &B2 )
+            basisEval2 = B2.makeEvaluator();
+        basisEval1->evalAllDers_into( md1.points, 1, basisData1);
+        basisEval2->evalAllDers_into( md2.points, 1, basisData2);
 
         // Compute image of Gauss nodes under geometry mapping as well as Jacobians
         geo1.computeMap(md1);
         geo2.computeMap(md2);
 
         // Initialize local matrices
-        B11.setZero(numActive1, numActive1); B12.setZero(numActive1, numActive2);
-        E11.setZero(numActive1, numActive1); E12.setZero(numActive1, numActive2);
-        B22.setZero(numActive2, numActive2); B21.setZero(numActive2, numActive1);
-        E22.setZero(numActive2, numActive2); E21.setZero(numActive2, numActive1);
+        ws.reset();
+        ws.bind(phGrad1, md1.dim.first, numActive1); ws.bind(N1, 1, numActive1);
+        ws.bind(phGrad2, md2.dim.first, numActive2); ws.bind(N2, 1, numActive2);
+        ws.bind(B11, numActive1, numActive1); ws.bind(B12, numActive1, numActive2);
+        ws.bind(E11, numActive1, numActive1); ws.bind(E12, numActive1, numActive2);
+        ws.bind(B22, numActive2, numActive2); ws.bind(B21, numActive2, numActive1);
+        ws.bind(E22, numActive2, numActive2); ws.bind(E21, numActive2, numActive1);
+        B11.setZero(); B12.setZero(); E11.setZero(); E12.setZero();
+        B22.setZero(); B21.setZero(); E22.setZero(); E21.setZero();
     }
 
     // assemble on element
@@ -97,9 +113,6 @@ public:
                          gsDomainIterator<T>    & element2,
                          gsVector<T>            & quWeights)
     {
-        const index_t numActive1 = actives1.rows();
-        const index_t numActive2 = actives2.rows();
-
         for (index_t k = 0; k < quWeights.rows(); ++k) // loop over quadrature nodes
         {
             // Compute the outer normal vector from patch1
@@ -113,11 +126,9 @@ public:
             unormal.normalize();
 
             // Take blocks of values and derivatives of basis functions
-            //const typename gsMatrix<T>::Column val1 = basisData1.col(k);//bug
-            const typename gsMatrix<T>::Block val1 = basisData1[0].block(0,k,numActive1,1);
+            const typename gsMatrix<T>::Column val1 = basisData1[0].col(k);
             gsMatrix<T> & grads1 = basisData1[1];// all grads
-            //const typename gsMatrix<T>::Column val2 = basisData2.col(k);//bug
-            const typename gsMatrix<T>::Block val2 = basisData2[0].block(0,k,numActive2,1);
+            const typename gsMatrix<T>::Column val2 = basisData2[0].col(k);
             gsMatrix<T> & grads2 = basisData2[1];// all grads
 
             // Transform the basis gradients
@@ -128,20 +139,22 @@ public:
             const T c1     = weight * T(0.5);
             N1.noalias()   = unormal.transpose() * phGrad1;
             N2.noalias()   = unormal.transpose() * phGrad2;
-            B11.noalias() += c1 * ( val1 * N1 );
-            B12.noalias() += c1 * ( val1 * N2 );
-            B22.noalias() -= c1 * ( val2 * N2 );
-            B21.noalias() -= c1 * ( val2 * N1 );
+            // (the constants are applied to the right factors, since a
+            // scaled left factor of an outer product is a temporary)
+            B11.noalias() += val1 * ( c1 * N1 );
+            B12.noalias() += val1 * ( c1 * N2 );
+            B22.noalias() -= val2 * ( c1 * N2 );
+            B21.noalias() -= val2 * ( c1 * N1 );
 
             const T h1     = element1.getCellSize();
             const T h2     = element2.getCellSize();
             // Maybe, the h should be scaled with the patch diameter, since its the h from the parameterdomain.
             const T c2     = weight * penalty * 2*(1./h1 + 1./h2);
 
-            E11.noalias() += c2 * ( val1 * val1.transpose() );
-            E12.noalias() += c2 * ( val1 * val2.transpose() );
-            E22.noalias() += c2 * ( val2 * val2.transpose() );
-            E21.noalias() += c2 * ( val2 * val1.transpose() );
+            E11.noalias() += val1 * ( c2 * val1.transpose() );
+            E12.noalias() += val1 * ( c2 * val2.transpose() );
+            E22.noalias() += val2 * ( c2 * val2.transpose() );
+            E21.noalias() += val2 * ( c2 * val1.transpose() );
         }
     }
     
@@ -154,13 +167,29 @@ public:
         system.mapColIndices(actives1, patch1, actives1);
         system.mapColIndices(actives2, patch2, actives2);
 
-        m_localRhs1.setZero(actives1.rows(),system.rhsCols());
-        m_localRhs2.setZero(actives2.rows(),system.rhsCols());
+        const index_t numActive1 = actives1.rows();
+        const index_t numActive2 = actives2.rows();
+
+        gsAsMatrix<T> localRhs1 = ws.matrix(numActive1, system.rhsCols());
+        gsAsMatrix<T> localRhs2 = ws.matrix(numActive2, system.rhsCols());
+        localRhs1.setZero();
+        localRhs2.setZero();
+
+        gsAsMatrix<T> localMat = ws.matrix(numActive1, numActive1);
+        localMat = -B11 - B11.transpose() + E11;
+        system.push(localMat, localRhs1,actives1,actives1,eliminatedDofs.front(),0,0);
+
+        ws.bind(localMat, numActive2, numActive1);
+        localMat = -B21 - B12.transpose() - E21;
+        system.push(localMat, localRhs2,actives2,actives1,eliminatedDofs.front(),0,0);
+
+        ws.bind(localMat, numActive1, numActive2);
+        localMat = -B12 - B21.transpose() - E12;
+        system.push(localMat, localRhs1,actives1,actives2,eliminatedDofs.front(),0,0);
 
-        system.push(-B11 - B11.transpose() + E11, m_localRhs1,actives1,actives1,eliminatedDofs.front(),0,0);
-        system.push(-B21 - B12.transpose() - E21, m_localRhs2,actives2,actives1,eliminatedDofs.front(),0,0);
-        system.push(-B12 - B21.transpose() - E12, m_localRhs1,actives1,actives2,eliminatedDofs.front(),0,0);
-        system.push(-B22 - B22.transpose() + E22, m_localRhs2,actives2,actives2,eliminatedDofs.front(),0,0);
+        ws.bind(localMat, numActive2, numActive2);
+        localMat = -B22 - B22.transpose() + E22;
+        system.push(localMat, localRhs2,actives2,actives2,eliminatedDofs.front(),0,0);
 
     }
 
@@ -175,18 +204,18 @@ private:
 private:
 
     // Basis values etc
+    typename gsBasisEvaluator<T>::Ptr basisEval1, basisEval2;
     std::vector<gsMatrix<T> > basisData1, basisData2;
-    gsMatrix<T>        phGrad1   , phGrad2;
+    gsAsMatrix<T>      phGrad1   , phGrad2;
     gsMatrix<index_t> actives1  , actives2;
 
     // Outer normal
     gsVector<T> unormal;
 
-    // Auxiliary element matrices
-    gsMatrix<T> B11, B12, E11, E12, N1,
-                B22, B21, E22, E21, N2;
-                
-    gsMatrix<T> m_localRhs1, m_localRhs2;
+    // Auxiliary element matrices, stored in the workspace
+    gsWorkspace<T> ws;
+    gsAsMatrix<T> B11, B12, E11, E12, N1,
+                  B22, B21, E22, E21, N2;
 
     gsMapData<T> md1, md2;
 };
@@ -97,19 +97,26 @@ public:
     inline void assemble(gsDomainIterator<T>    & ,
                          gsVector<T> const      & quWeights)
     {
-        for (index_t k = 0; k < quWeights.rows(); ++k) // loop over quadrature nodes
+        const index_t nPts = quWeights.rows();
+        normalDerivs.resize(numActive, nPts);
+        weights.resize(nPts);
+        for (index_t k = 0; k < nPts; ++k) // loop over quadrature nodes
         {
             // Compute the outer normal vector on the side
             outerNormal(md, k, side, unormal);
             
             // Multiply quadrature weight by the measure of normal
-            const T weight = quWeights[k] * unormal.norm();
+            weights[k] = quWeights[k] * unormal.norm();
             unormal.normalize();
             //Get gradients of the physical space
             transformGradients(md, k, basisGrads, physBasisGrad);
 
-            localRhs.noalias() += weight *(( physBasisGrad.transpose() * unormal )* neuData.col(k).transpose());
+            // Normal derivatives of all active functions
+            normalDerivs.col(k).noalias() = physBasisGrad.transpose() * unormal;
         }
+
+        // One product for all quadrature nodes
+        localRhs.noalias() = normalDerivs * weights.asDiagonal() * neuData.transpose();
     }
     
     inline void localToGlobal(const index_t                     patchIndex,
@@ -162,6 +169,8 @@ protected:
 
     gsVector<T> unormal;
     gsMatrix<T> neuData;
+    gsMatrix<T> normalDerivs;
+    gsVector<T> weights;
     index_t numActive;
 
 
@@ -32,7 +32,9 @@ class gsVisitorNitsche
 public:
 
     gsVisitorNitsche(const gsPde<T> & , const boundary_condition<T> & s)
-    : dirdata_ptr( s.function().get() ), side(s.side())
+    : dirdata_ptr( s.function().get() ), side(s.side()),
+      pGrads(NULL, 0, 0), nGrads(NULL, 0, 0), wVals(NULL, 0, 0), cVals(NULL, 0, 0),
+    localMat(NULL, 0, 0), localRhs(NULL, 0, 0)
     { }
 
 /** @brief
@@ -45,7 +47,9 @@ public:
     \param[in] s
 */
     gsVisitorNitsche(const gsFunction<T> & dirdata, T _penalty, boxSide s) : 
-    dirdata_ptr(&dirdata),penalty(_penalty), side(s)
+    dirdata_ptr(&dirdata),penalty(_penalty), side(s),
+    pGrads(NULL, 0, 0), nGrads(NULL, 0, 0), wVals(NULL, 0, 0), cVals(NULL, 0, 0),
+    localMat(NULL, 0, 0), localRhs(NULL, 0, 0)
     { }
 
     void initialize(const gsBasis<T> & basis, 
@@ -62,6 +66,9 @@ public:
 
         // Set Geometry evaluation flags
         md.flags = NEED_VALUE|NEED_JACOBIAN|NEED_GRAD_TRANSFORM;
+
+        // Every (thread-private) visitor creates its own evaluator
+        basisEval.reset();
     }
 
     void initialize(const gsBasis<T> & basis,
@@ -78,6 +85,9 @@ public:
         // Compute penalty parameter
         const int deg = basis.maxDegree();
         penalty = (deg + basis.dim()) * (deg + 1) * T(2.5);
+
+        // Every (thread-private) visitor creates its own evaluator
+        basisEval.reset();
     }
 
     // Evaluate on element.
@@ -93,7 +103,9 @@ public:
         const index_t numActive = actives.rows();
 
         // Evaluate basis values and derivatives on element
-        basis.evalAllDers_into( md.points, 1, basisData);
+        if ( !basisEval || &basisEval->basis() != &basis )
+            basisEval = basis.makeEvaluator();
+        basisEval->evalAllDers_into( md.points, 1, basisData);
 
         // Compute geometry related values
         geo.computeMap(md);
@@ -102,8 +114,15 @@ public:
         dirdata_ptr->eval_into(md.values[0], dirData);
 
         // Initialize local matrix/rhs
-        localMat.setZero(numActive, numActive);
-        localRhs.setZero(numActive, dirdata_ptr->targetDim() );
+        ws.reset();
+        ws.bind(pGrads, md.dim.first, numActive);
+        ws.bind(nGrads, 1, numActive);
+        ws.bind(wVals, numActive, 1);
+        ws.bind(cVals, numActive, 1);
+        ws.bind(localMat, numActive, numActive);
+        ws.bind(localRhs, numActive, dirdata_ptr->targetDim() );
+        localMat.setZero();
+        localRhs.setZero();
     }
 
     inline void assemble(gsDomainIterator<T>    & element,
@@ -129,18 +148,23 @@ public:
         
         // Compute physical gradients at k as a Dim x NumActive matrix
         transformGradients(md, k, bGrads, pGrads);
+
+        // Normal derivatives of the basis functions
+        nGrads.noalias() = unormal.transpose() * pGrads;
         
         // Get penalty parameter
         const T h = element.getCellSize();
         const T mu = penalty / (0!=h?h:1);
 
-        // Sum up quadrature point evaluations
-        localRhs.noalias() -= weight * (( pGrads.transpose() * unormal - mu * bVals )
-                                        * dirData.col(k).transpose() );
+        // Weighted basis values and consistency/penalty term
+        wVals = weight * bVals;
+        cVals = nGrads.transpose() - mu * bVals;
 
-        localMat.noalias() -= weight * ( bVals * unormal.transpose() * pGrads
-                           +  (bVals * unormal.transpose() * pGrads).transpose()
-                           -  mu * bVals * bVals.transpose() );
+        // Sum up quadrature point evaluations (the products have
+        // plain factors, so that no temporaries are created)
+        localRhs.noalias() -= cVals * (weight * dirData.col(k).transpose());
+        localMat.noalias() -= wVals * nGrads;
+        localMat.noalias() -= cVals * wVals.transpose();
         }
     }
 
@@ -192,17 +216,19 @@ private:
 
 private:
     // Basis values
+    typename gsBasisEvaluator<T>::Ptr basisEval;
     std::vector<gsMatrix<T> > basisData;
-    gsMatrix<T>      pGrads;
+    gsAsMatrix<T>    pGrads, nGrads, wVals, cVals;
     gsMatrix<index_t> actives;
 
     // Normal and Neumann values
     gsVector<T> unormal;
     gsMatrix<T> dirData;
 
-    // Local  matrix and rhs
-    gsMatrix<T> localMat;
-    gsMatrix<T> localRhs;
+    // Local  matrix and rhs, stored in the workspace
+    gsWorkspace<T> ws;
+    gsAsMatrix<T> localMat;
+    gsAsMatrix<T> localRhs;
 
     gsMapData<T> md;
 };
@@ -34,6 +34,7 @@ public:
     /** \brief Constructor for gsVisitorPoisson.
      */
     gsVisitorPoisson(const gsPde<T> & pde)
+    : physGrad(NULL, 0, 0), localMat(NULL, 0, 0), localRhs(NULL, 0, 0)
     { 
         pde_ptr = static_cast<const gsPoissonPde<T>*>(&pde);
     }
@@ -51,6 +52,9 @@ public:
 
         // Set Geometry evaluation flags
         md.flags = NEED_VALUE | NEED_MEASURE | NEED_GRAD_TRANSFORM;
+
+        // Every (thread-private) visitor creates its own evaluator
+        basisEval.reset();
     }
 
     // Evaluate on element.
@@ -65,7 +69,9 @@ public:
         numActive = actives.rows();
         
         // Evaluate basis functions on element
-        basis.evalAllDers_into( md.points, 1, basisData);
+        if ( !basisEval || &basisEval->basis() != &basis )
+            basisEval = basis.makeEvaluator();
+        basisEval->evalAllDers_into( md.points, 1, basisData);
         
         // Compute image of Gauss nodes under geometry mapping as well as Jacobians
         geo.computeMap(md);
@@ -76,8 +82,12 @@ public:
         rhs_ptr->eval_into( (paramCoef ?  md.points :  md.values[0] ), rhsVals );
         
         // Initialize local matrix/rhs
-        localMat.setZero(numActive, numActive      );
-        localRhs.setZero(numActive, rhsVals.rows() );//multiple right-hand sides
+        ws.reset();
+        ws.bind(physGrad, md.dim.first, numActive);
+        ws.bind(localMat, numActive, numActive      );
+        ws.bind(localRhs, numActive, rhsVals.rows() );//multiple right-hand sides
+        localMat.setZero();
+        localRhs.setZero();
     }
     
     inline void assemble(gsDomainIterator<T>    & ,
@@ -94,8 +104,11 @@ public:
             // Compute physical gradients at k as a Dim x NumActive matrix
             transformGradients(md, k, bGrads, physGrad);
             
-            localRhs.noalias() += weight * ( bVals.col(k) * rhsVals.col(k).transpose() ) ;
-            localMat.noalias() += weight * (physGrad.transpose() * physGrad);
+            // (the weight scales the right factor of the outer product
+            // and the result of the lazy product, since a scaled
+            // factor is evaluated into a temporary)
+            localRhs.noalias() += bVals.col(k) * ( weight * rhsVals.col(k).transpose() ) ;
+            localMat.noalias() += weight * physGrad.transpose().lazyProduct(physGrad);
         }
     }
 
@@ -116,8 +129,9 @@ protected:
     
 protected:
     // Basis values
+    typename gsBasisEvaluator<T>::Ptr basisEval;
     std::vector<gsMatrix<T> > basisData;
-    gsMatrix<T>        physGrad;
+    gsAsMatrix<T>      physGrad;
     gsMatrix<index_t> actives;
     index_t numActive;
 
@@ -129,9 +143,10 @@ protected:
     gsMatrix<T> rhsVals;
 
 protected:
-    // Local matrices
-    gsMatrix<T> localMat;
-    gsMatrix<T> localRhs;
+    // Local matrices, stored in the workspace
+    gsWorkspace<T> ws;
+    gsAsMatrix<T> localMat;
+    gsAsMatrix<T> localRhs;
 
     gsMapData<T> md;
 };
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <gsCore/gsFunctionSet.h>
+#include <gsCore/gsBasisEvaluator.h>
 
 #define GISMO_MAKE_GEOMETRY_NEW    \
 virtual memory::unique_ptr<gsGeometry<T> > makeGeometry( gsMatrix<T>coefs ) const      \
@@ -677,6 +678,13 @@ public:
     virtual void evalAllDers_into(const gsMatrix<T> & u, int n,
                                   std::vector<gsMatrix<T> >& result) const;
 
+    /// @brief Creates an evaluator of this basis, which keeps the
+    /// scratch memory of evalAllDers_into between calls. A class
+    /// which overrides evalAllDers_into must override this function
+    /// too, if one of its base classes does.
+    virtual typename gsBasisEvaluator<T>::uPtr makeEvaluator() const
+    { return typename gsBasisEvaluator<T>::uPtr(new gsBasisEvaluator<T>(*this)); }
+
     /// @brief Evaluate the basis function \a i and its derivatives up
     /// to order \a n at points \a u into \a result.
     virtual void evalAllDersSingle_into(index_t i, const gsMatrix<T> & u,
@@ -908,8 +916,9 @@ public:
     virtual short_t degree(short_t i) const;
 
     /// @brief Applies interpolation given the parameter values \a pts
-    /// and values \a vals.
-    memory::unique_ptr<gsGeometry<T> > interpolateData(gsMatrix<T> const& vals,
+    /// and values \a vals. May be reimplemented in derived classes
+    /// with more efficient algorithms.
+    virtual memory::unique_ptr<gsGeometry<T> > interpolateData(gsMatrix<T> const& vals,
                                     gsMatrix<T> const& pts ) const;
 
     /// @brief Applies interpolation of values \a pts using the
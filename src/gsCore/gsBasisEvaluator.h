@@ -0,0 +1,61 @@
+/** @file gsBasisEvaluator.h
+
+    @brief Provides an evaluator of a basis which keeps its scratch
+    memory between calls
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+namespace gismo
+{
+
+/** \brief Evaluates a basis repeatedly, eg. on the quadrature nodes
+    of every element of a mesh.
+
+    An evaluator is created by gsBasis::makeEvaluator() and refers to
+    the basis it was created by. Derived evaluators keep the
+    intermediate results (eg. the univariate values of a tensor-product
+    basis) between calls, so that evaluations on points sets of the
+    same size do not allocate memory. The default implementation
+    forwards to the basis.
+
+    An evaluator is not thread-safe: each thread should create its
+    own one.
+
+    \tparam T coefficient type
+
+    \ingroup Core
+*/
+template<class T>
+class gsBasisEvaluator
+{
+public:
+    typedef memory::shared_ptr< gsBasisEvaluator > Ptr;
+    typedef memory::unique_ptr< gsBasisEvaluator > uPtr;
+
+    explicit gsBasisEvaluator(const gsBasis<T> & basis)
+    : m_basis(&basis)
+    { }
+
+    virtual ~gsBasisEvaluator() { }
+
+    /// The basis which is evaluated
+    const gsBasis<T> & basis() const { return *m_basis; }
+
+    /// @brief Same as gsBasis::evalAllDers_into for the basis of the
+    /// evaluator
+    virtual void evalAllDers_into(const gsMatrix<T> & u, int n,
+                                  std::vector<gsMatrix<T> >& result)
+    { m_basis->evalAllDers_into(u, n, result); }
+
+protected:
+    const gsBasis<T> * m_basis;
+};
+
+} // namespace gismo
@@ -324,6 +324,91 @@ void gsDofMapper::finalizeComp(const index_t comp)
                  "does not match allocated number");
 }
 
+void gsDofMapper::reverseCuthillMcKee(const std::vector<std::vector<index_t> > & adj,
+                                      std::vector<index_t> & order)
+{
+    const index_t n = adj.size();
+    order.clear();
+    order.reserve(n);
+
+    std::vector<char> visited(n, 0);
+    std::vector<index_t> mark(n, -1), queue;
+    std::vector<std::pair<size_t,index_t> > nbrs; // (degree, vertex)
+    index_t stamp = 0;
+
+    for (index_t s = 0; s != n; ++s) // for all connected components
+    {
+        if ( visited[s] ) continue;
+
+        // Find a pseudo-peripheral start vertex by repeated
+        // breadth-first searches (George and Liu)
+        index_t root = s, ecc = -1;
+        for (index_t it = 0; it != 8; ++it)
+        {
+            queue.clear();
+            queue.push_back(root);
+            mark[root] = ++stamp;
+            size_t lvlBegin = 0, lvlEnd = 1;
+            index_t depth = 0;
+            for (;;)
+            {
+                for (size_t h = lvlBegin; h != lvlEnd; ++h)
+                    for (std::vector<index_t>::const_iterator j = adj[queue[h]].begin();
+                         j != adj[queue[h]].end(); ++j)
+                        if ( mark[*j] != stamp )
+                        {
+                            mark[*j] = stamp;
+                            queue.push_back(*j);
+                        }
+                if ( queue.size() == lvlEnd ) break;
+                lvlBegin = lvlEnd;
+                lvlEnd   = queue.size();
+                ++depth;
+            }
+
+            if ( depth <= ecc ) break;
+            ecc = depth;
+
+            // Continue from a vertex of minimal degree in the last level
+            for (size_t h = lvlBegin; h != lvlEnd; ++h)
+                if ( adj[queue[h]].size() < adj[root].size() || h == lvlBegin )
+                    root = queue[h];
+        }
+
+        // Cuthill-McKee: visit the neighbors by increasing degree
+        order.push_back(root);
+        visited[root] = 1;
+        for (size_t h = order.size() - 1; h != order.size(); ++h)
+        {
+            const std::vector<index_t> & nb = adj[order[h]];
+            nbrs.clear();
+            for (std::vector<index_t>::const_iterator j = nb.begin(); j != nb.end(); ++j)
+                if ( !visited[*j] )
+                {
+                    visited[*j] = 1;
+                    nbrs.push_back( std::make_pair(adj[*j].size(), *j) );
+                }
+            std::sort(nbrs.begin(), nbrs.end());
+            for (size_t i = 0; i != nbrs.size(); ++i)
+                order.push_back(nbrs[i].second);
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+}
+
+void gsDofMapper::applyFreePermutation(const std::vector<index_t> & perm)
+{
+    GISMO_ASSERT(static_cast<index_t>(perm.size()) == m_numFreeDofs.back(),
+                 "The permutation does not match the number of free dofs");
+    GISMO_ASSERT(m_tagged.empty(), "Tagged dofs are not permuted");
+
+    for (size_t c = 0; c != m_dofs.size(); ++c)
+        for (std::vector<index_t>::iterator j = m_dofs[c].begin(); j != m_dofs[c].end(); ++j)
+            if ( *j < m_numFreeDofs.back() )
+                *j = perm[*j];
+}
+
 std::ostream& gsDofMapper::print( std::ostream& os ) const
 {
   os<<" Dofs: "<< this->size() 
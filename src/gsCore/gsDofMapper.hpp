@@ -12,6 +12,7 @@
 **/
 
 #include <gsCore/gsMultiBasis.h>
+#include <gsCore/gsDomainIterator.h>
 
 namespace gismo 
 {
@@ -132,5 +133,122 @@ void gsDofMapper::initSingle( const gsBasis<T> & basis, index_t nComp)
     m_dofs.resize(nComp, std::vector<index_t>(m_numFreeDofs.back(), 0));
 }
 
+template<class T>
+void gsDofMapper::finalize(const gsMultiBasis<T> & bases, dofOrdering::type ordering)
+{
+    finalize();
+    if ( dofOrdering::natural == ordering || 0 == m_numFreeDofs.back() )
+        return;
+
+    GISMO_ASSERT( bases.nBases() == numPatches() &&
+                  static_cast<size_t>(bases.totalSize()) == m_dofs.front().size(),
+                  "The bases do not match the mapper" );
+
+    std::vector<index_t> perm(m_numFreeDofs.back()); // old free index -> new
+    std::vector<index_t> order;                      // block-local, new -> old
+    gsMatrix<index_t> act;
+    gsMatrix<T> anch;
+
+    for (size_t c = 0; c != m_dofs.size(); ++c)
+    {
+        // The standard dofs and the coupled dofs are ordered separately
+        const index_t nc = m_numCpldDofs[c+1] - m_numCpldDofs[c];
+        const index_t blocks[3] = {m_numFreeDofs[c], m_numFreeDofs[c+1] - nc, m_numFreeDofs[c+1]};
+
+        for (index_t b = 0; b != 2; ++b)
+        {
+            const index_t first = blocks[b];
+            const index_t n     = blocks[b+1] - first;
+            if ( 0 == n ) continue;
+
+            if ( dofOrdering::rcm == ordering )
+            {
+                // Two dofs are adjacent if the supports of their basis
+                // functions share an element
+                std::vector<std::vector<index_t> > adj(n);
+                std::vector<size_t> lim(n, 64); // size of the next compaction
+                for (size_t k = 0; k != bases.nBases(); ++k)
+                {
+                    typename gsBasis<T>::domainIter domIt = bases[k].makeDomainIterator();
+                    for (; domIt->good(); domIt->next() )
+                    {
+                        bases[k].active_into(domIt->centerPoint(), act);
+                        index_t na = 0;
+                        for (index_t i = 0; i != act.rows(); ++i)
+                        {
+                            const index_t gl = MAPPER_PATCH_DOF(act(i,0),k,c) - first;
+                            if ( gl >= 0 && gl < n ) act(na++,0) = gl;
+                        }
+                        for (index_t i = 0; i != na; ++i)
+                        {
+                            std::vector<index_t> & row = adj[act(i,0)];
+                            for (index_t j = 0; j != na; ++j)
+                                if ( i != j ) row.push_back(act(j,0));
+                            if ( row.size() >= lim[act(i,0)] ) // remove duplicates
+                            {
+                                std::sort(row.begin(), row.end());
+                                row.erase(std::unique(row.begin(), row.end()), row.end());
+                                lim[act(i,0)] = 2 * row.size() + 64;
+                            }
+                        }
+                    }
+                }
+                for (index_t i = 0; i != n; ++i)
+                {
+                    std::sort(adj[i].begin(), adj[i].end());
+                    adj[i].erase(std::unique(adj[i].begin(), adj[i].end()), adj[i].end());
+                }
+
+                reverseCuthillMcKee(adj, order);
+            }
+            else // dofOrdering::sfc
+            {
+                // Key of every dof: the patch of its first pre-image and
+                // the Morton code of the anchor in the parameter domain
+                typedef std::pair<std::pair<index_t,unsigned long long>,index_t> sfcKey;
+                std::vector<sfcKey> keys;
+                keys.reserve(n);
+                std::vector<char> found(n, 0);
+                for (size_t k = 0; k != bases.nBases(); ++k)
+                {
+                    const gsBasis<T> & basis = bases[k];
+                    const short_t d = basis.dim();
+                    const unsigned bits = math::min(16, 63 / static_cast<int>(d));
+                    const gsMatrix<T> box = basis.support();
+                    basis.anchors_into(anch);
+                    for (index_t i = 0; i != basis.size(); ++i)
+                    {
+                        const index_t gl = MAPPER_PATCH_DOF(i,k,c) - first;
+                        if ( gl < 0 || gl >= n || found[gl] ) continue;
+                        found[gl] = 1;
+
+                        unsigned long long code = 0;
+                        for (short_t j = 0; j != d; ++j)
+                        {
+                            const T len = box(j,1) - box(j,0);
+                            const T x = ( 0 == len ? 0 : (anch(j,i) - box(j,0)) / len );
+                            const unsigned long long q = static_cast<unsigned long long>(
+                                math::min(math::max(x, (T)0), (T)1) * ((1u << bits) - 1) );
+                            for (unsigned l = 0; l != bits; ++l) // interleave the bits
+                                code |= ((q >> l) & 1ULL) << (l * d + j);
+                        }
+                        keys.push_back( sfcKey(std::make_pair((index_t)k, code), gl) );
+                    }
+                }
+                GISMO_ASSERT( static_cast<index_t>(keys.size()) == n, "Internal error");
+                std::sort(keys.begin(), keys.end());
+                order.resize(n);
+                for (index_t i = 0; i != n; ++i)
+                    order[i] = keys[i].second;
+            }
+
+            for (index_t i = 0; i != n; ++i)
+                perm[first + order[i]] = first + i;
+        }
+    }
+
+    applyFreePermutation(perm);
+}
+
 }//namespace gismo
 
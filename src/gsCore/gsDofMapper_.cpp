@@ -32,6 +32,9 @@ namespace gismo {
 
     TEMPLATE_INST void gsDofMapper::initSingle(
         const gsBasis<real_t> & bases, index_t nComp);
+
+    TEMPLATE_INST void gsDofMapper::finalize(
+        const gsMultiBasis<real_t> & bases, dofOrdering::type ordering);
 }
 
 
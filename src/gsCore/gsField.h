@@ -134,6 +134,20 @@ public:
         return ( m_fields->piece(i).eval(u) );
     }
 
+    /**
+     * @brief Evaluates the field at many points \a x of the physical domain.
+     *
+     * The points are located by gsMultiPatch::locatePoints and grouped
+     * by patch, and every patch evaluates its points in chunks, in
+     * parallel. Points outside the domain get NaN values.
+     *
+     * @param[in] x Points as gsMatrix of size <em>geoDim()</em> x <em>n</em>
+     * @param[out] result The <em>j</em>-th column is the value of the field at \a x_j
+     * @param[out] pids If given, the patch of every point (-1 if outside)
+     */
+    void probe_into(const gsMatrix<T> & x, gsMatrix<T> & result,
+                    gsVector<index_t> * pids = NULL) const;
+
     /// Computes the L2-distance between the two fields, on the physical domain
     T distanceL2(gsField<T> const & field, int numEvals= 1000) const;
 
@@ -20,6 +20,54 @@
 namespace gismo
 {
 
+template <class T>
+void gsField<T>::probe_into(const gsMatrix<T> & x, gsMatrix<T> & result,
+                            gsVector<index_t> * pids) const
+{
+    const gsMultiPatch<T> & mp = this->patches();
+    GISMO_ASSERT(x.rows() == mp.geoDim(), "Wrong dimension of the points");
+
+    gsVector<index_t> pid;
+    gsMatrix<T> preim;
+    mp.locatePoints(x, pid, preim);
+
+    std::vector<index_t> offsets, perm;
+    mp.groupByPatch(pid, offsets, perm);
+
+    result.setConstant(dim(), x.cols(), std::numeric_limits<T>::quiet_NaN());
+
+    // Chunks of points of the same patch
+    const index_t chunkSize = 256;
+    std::vector<std::pair<index_t,index_t> > chunks; // (patch, first)
+    for (size_t k = 0; k + 1 < offsets.size(); ++k)
+        for (index_t first = offsets[k]; first < offsets[k+1]; first += chunkSize)
+            chunks.push_back(std::make_pair(static_cast<index_t>(k), first));
+    const index_t nChunks = chunks.size();
+
+#pragma omp parallel
+{
+    gsMatrix<T> pts, vals;
+#pragma omp for schedule(dynamic)
+    for (index_t c = 0; c < nChunks; ++c)
+    {
+        const index_t k     = chunks[c].first;
+        const index_t first = chunks[c].second;
+        const index_t n     = math::min(chunkSize, offsets[k+1] - first);
+
+        const gsMatrix<T> & src = m_parametric ? preim : x;
+        pts.resize(src.rows(), n);
+        for (index_t j = 0; j != n; ++j)
+            pts.col(j) = src.col(perm[first + j]);
+
+        m_fields->piece(k).eval_into(pts, vals);
+        for (index_t j = 0; j != n; ++j) // distinct columns per thread
+            result.col(perm[first + j]) = vals.col(j);
+    }
+}//omp parallel
+
+    if ( pids ) pids->swap(pid);
+}
+
 template <class T>
 T gsField<T>::distanceL2(gsFunctionSet<T> const & func,
                          gsMultiBasis<T> const & B,
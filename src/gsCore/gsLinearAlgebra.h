@@ -195,6 +195,7 @@ public:
 #include <gsMatrix/gsMatrix.h>
 #include <gsMatrix/gsVector.h>
 #include <gsMatrix/gsAsMatrix.h>
+#include <gsMatrix/gsWorkspace.h>
 #include <gsMatrix/gsSparseMatrix.h>
 #include <gsMatrix/gsSparseVector.h>
 #include <gsMatrix/gsSparseSolver.h>
@@ -346,7 +346,8 @@ public:
     /// grid functions.
     ///
     /// For computing the transfer matrix (but not for refinement), the \a boundaryConditions and
-    /// the \a assemblerOptions have to be provided
+    /// the \a assemblerOptions have to be provided. The dofs are numbered as by the assembler,
+    /// including its "DofOrdering".
     ///
     /// \sa gsMultiBasis::uniformRefine
     void uniformRefine_withTransfer(
@@ -411,7 +412,8 @@ public:
     /// grid functions.
     ///
     /// For computing the transfer matrix (but not for refinement), the \a boundaryConditions and
-    /// the \a assemblerOptions have to be provided
+    /// the \a assemblerOptions have to be provided. The dofs are numbered as by the assembler,
+    /// including its "DofOrdering".
     ///
     /// \sa gsMultiBasis::uniformCoarsen
     void uniformCoarsen_withTransfer(
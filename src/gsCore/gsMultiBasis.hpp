@@ -182,6 +182,10 @@ void gsMultiBasis<T>::uniformRefine_withTransfer(
         int numKnots,
         int mul)
 {
+    // The same ordering of the dofs as in the assembler
+    const dofOrdering::type ordering = static_cast<dofOrdering::type>(
+        assemblerOptions.askInt("DofOrdering", dofOrdering::natural));
+
     // Get coarse mapper
     gsDofMapper coarseMapper;
     this->getMapper(
@@ -189,8 +193,10 @@ void gsMultiBasis<T>::uniformRefine_withTransfer(
             (iFace    ::strategy)assemblerOptions.askInt("InterfaceStrategy", 1),
             boundaryConditions,
             coarseMapper,
-            0
+            0,
+            false
     );
+    coarseMapper.finalize(*this, ordering);
 
     // Refine
     std::vector< gsSparseMatrix<T, RowMajor> > localTransferMatrices(nBases());
@@ -206,8 +212,10 @@ void gsMultiBasis<T>::uniformRefine_withTransfer(
             (iFace    ::strategy)assemblerOptions.askInt("InterfaceStrategy", 1),
             boundaryConditions,
             fineMapper,
-            0
+            0,
+            false
     );
+    fineMapper.finalize(*this, ordering);
 
     // restrict to free dofs
     combineTransferMatrices( localTransferMatrices, coarseMapper, fineMapper, transferMatrix );
@@ -221,6 +229,10 @@ void gsMultiBasis<T>::uniformCoarsen_withTransfer(
         const gsOptionList& assemblerOptions,
         int numKnots)
 {
+    // The same ordering of the dofs as in the assembler
+    const dofOrdering::type ordering = static_cast<dofOrdering::type>(
+        assemblerOptions.askInt("DofOrdering", dofOrdering::natural));
+
     // Get fine mapper
     gsDofMapper fineMapper;
     this->getMapper(
@@ -228,8 +240,10 @@ void gsMultiBasis<T>::uniformCoarsen_withTransfer(
             (iFace    ::strategy)assemblerOptions.askInt("InterfaceStrategy", 1),
             boundaryConditions,
             fineMapper,
-            0
+            0,
+            false
     );
+    fineMapper.finalize(*this, ordering);
 
     // Refine
     std::vector< gsSparseMatrix<T, RowMajor> > localTransferMatrices(nBases());
@@ -245,8 +259,10 @@ void gsMultiBasis<T>::uniformCoarsen_withTransfer(
             (iFace    ::strategy)assemblerOptions.askInt("InterfaceStrategy", 1),
             boundaryConditions,
             coarseMapper,
-            0
+            0,
+            false
     );
+    coarseMapper.finalize(*this, ordering);
 
     // restrict to free dofs
     combineTransferMatrices( localTransferMatrices, coarseMapper, fineMapper, transferMatrix );
@@ -306,7 +306,33 @@ public:
     /// \param pid2 vector containing for each point the patch id where it belongs (or -1 if not found)
     /// \param preim in each column,  the parametric coordinates of the corresponding point in the patch
     void locatePoints(const gsMatrix<T> & points, index_t pid1, gsVector<index_t> & pid2, gsMatrix<T> & preim) const;
-    
+
+    /// @brief Groups point indices by patch (counting sort)
+    ///
+    /// \param pids for each point the patch id (points with negative id are skipped)
+    /// \param offsets on output, the points of patch \a k are
+    /// perm[offsets[k]], ..., perm[offsets[k+1]-1], in increasing order
+    /// \param perm the point indices grouped by patch
+    void groupByPatch(const gsVector<index_t> & pids, std::vector<index_t> & offsets,
+                      std::vector<index_t> & perm) const
+    {
+        offsets.assign(m_patches.size() + 1, 0);
+        for (index_t i = 0; i != pids.size(); ++i)
+            if ( pids[i] >= 0 )
+            {
+                GISMO_ASSERT(static_cast<size_t>(pids[i]) < m_patches.size(), "Invalid patch index "<< pids[i]);
+                ++offsets[pids[i]+1];
+            }
+        for (size_t k = 0; k != m_patches.size(); ++k)
+            offsets[k+1] += offsets[k];
+
+        perm.resize(offsets.back());
+        std::vector<index_t> pos(offsets.begin(), offsets.end() - 1);
+        for (index_t i = 0; i != pids.size(); ++i)
+            if ( pids[i] >= 0 )
+                perm[pos[pids[i]]++] = i;
+    }
+
 protected:
 
     void setIds();
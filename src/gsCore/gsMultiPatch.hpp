@@ -648,28 +648,8 @@ void gsMultiPatch<T>::locatePoints(const gsMatrix<T> & points,
                                    gsVector<index_t> & pids,
                                    gsMatrix<T> & preim) const
 {
-    pids.resize(points.cols());
-    pids.setConstant(-1); // -1 implies not in the domain
-    preim.resize(parDim(), points.cols());//uninitialized by default
-    gsMatrix<T> pt, pr, tmp;
-
-    for (index_t i = 0; i!=pids.size(); ++i)
-    {
-        pt = points.col(i);
-
-        for (size_t k = 0; k!= m_patches.size(); ++k)
-        {
-            pr = m_patches[k]->parameterRange();
-            m_patches[k]->invertPoints(pt, tmp);
-            if ( (tmp.array() >= pr.col(0).array()).all()
-                 && (tmp.array() <= pr.col(1).array()).all() )
-            {
-                pids[i] = k;
-                preim.col(i) = tmp;
-                break;
-            }
-        }
-    }
+    // No patch is skipped
+    locatePoints(points, -1, pids, preim);
 }
 
 template<class T>
@@ -682,24 +662,40 @@ void gsMultiPatch<T>::locatePoints(const gsMatrix<T> & points, index_t pid1,
     preim.resize(parDim(), points.cols());//uninitialized by default
     gsMatrix<T> pt, pr, tmp;
 
-    for (index_t i = 0; i!=pid2.size(); ++i)
+    // The patches are visited in order, and each patch inverts at
+    // once all the points which are not located yet
+    std::vector<index_t> rem(points.cols()); // points not located yet
+    for (index_t i = 0; i!=points.cols(); ++i)
+        rem[i] = i;
+
+    for (size_t k = 0; k!= m_patches.size() && !rem.empty(); ++k)
     {
-        pt = points.col(i);
+        if (pid1==(index_t)k) continue; // skip pid1
 
-        for (size_t k = 0; k!= m_patches.size(); ++k)
+        if ( rem.size() == static_cast<size_t>(points.cols()) )
+            m_patches[k]->invertPoints(points, tmp);
+        else
         {
-            if (pid1==(index_t)k) continue; // skip pid1
-
-            pr = m_patches[k]->parameterRange();
+            pt.resize(points.rows(), rem.size());
+            for (size_t j = 0; j!= rem.size(); ++j)
+                pt.col(j) = points.col(rem[j]);
             m_patches[k]->invertPoints(pt, tmp);
-            if ( (tmp.array() >= pr.col(0).array()).all()
-                 && (tmp.array() <= pr.col(1).array()).all() )
+        }
+
+        pr = m_patches[k]->parameterRange();
+        size_t r = 0;
+        for (size_t j = 0; j!= rem.size(); ++j)
+        {
+            if ( (tmp.col(j).array() >= pr.col(0).array()).all()
+                 && (tmp.col(j).array() <= pr.col(1).array()).all() )
             {
-                pid2[i] = k;
-                preim.col(i) = tmp;
-                break;
+                pid2[rem[j]] = k;
+                preim.col(rem[j]) = tmp.col(j);
             }
+            else
+                rem[r++] = rem[j];
         }
+        rem.resize(r);
     }
 }
 
@@ -15,6 +15,9 @@
 
 #include <gsModeling/gsFitting.h>
 #include <gsHSplines/gsHTensorBasis.h>
+#include <gsIO/gsPointCloudReader.h>
+
+#include <map>
 
 namespace gismo {
 
@@ -34,6 +37,22 @@ public:
 
     typedef typename gsBSplineTraits<d,T>::Basis tensorBasis;
 
+    /// Error statistics of the points lying in one element of the
+    /// finest level of the hierarchy
+    struct cellError
+    {
+        cellError() : maxErr(0), sqErr(0), numPoints(0) { }
+
+        T maxErr;          ///< maximum point-wise error
+        T sqErr;           ///< sum of the squared point-wise errors
+        index_t numPoints; ///< number of points in the element
+        gsVector<T> param; ///< parameter of the point with maximum error
+    };
+
+    /// Element-wise error statistics, indexed by the (lexicographic)
+    /// index of the element of the finest level
+    typedef std::map<size_t,cellError> cellErrorMap;
+
 public:
     /// Default constructor
     gsHFitting();
@@ -79,8 +98,52 @@ public:
         m_pointErrors.reserve(m_param_values.cols());
     }
 
+    /**
+        \brief
+        Constructor for fitting point clouds which are read in chunks
+        (cf. iterativeRefine(gsPointCloudReader<T>&,int,T,T)), hence no
+        points are stored in the object.
+
+        \param basis  Hiearchical basis to use for fitting
+
+        \param refin Percentage of errors to refine (if this strategy is chosen)
+
+        \param extension Extension to apply to marked cells
+
+        \param lambda Smoothing parameter
+    */
+    gsHFitting(gsHTensorBasis<d,T> & basis,
+               T refin, const std::vector<unsigned> & extension,
+               T lambda = 0)
+    : gsFitting<T>()
+    {
+        GISMO_ASSERT((refin >=0) && (refin <=1),
+                     "Refinement percentage must be between 0 and 1." );
+        GISMO_ASSERT(extension.size() == d, "Extension is not of the right dimension");
+
+        m_basis  = &basis;
+
+        m_ref    = refin;     //how many % to refine
+
+        m_ext    = extension;
+
+        m_lambda = lambda;    // Smoothing parameter
+
+        m_max_error = m_min_error = 0;
+    }
+
 public:
 
+    using gsFitting<T>::compute;
+
+    /// Computes the euclidean error for each point, together with
+    /// the element-wise error statistics (see cellErrors())
+    void computeErrors();
+
+    /// Computes the maximum norm error for each point, together with
+    /// the element-wise error statistics (see cellErrors())
+    void computeMaxNormErrors();
+
     /**
      * @brief iterative_refine iteratively refine the basis
      *
@@ -110,6 +173,37 @@ public:
     bool nextIteration(T tolerance, T err_threshold,
 		       const std::vector<boxSide>& fixedSides);
 
+    /**
+     * @brief Streaming variant of iterativeRefine(int,T,T): the point
+     * cloud is read in chunks from \a reader (twice per iteration),
+     * hence the memory needed is bounded by the size of the basis
+     * rather than by the number of points.
+     *
+     * The refinement is decided from the error statistics which are
+     * accumulated per element of the finest level (see
+     * cellErrors()). If \a err_threshold is -1, the m_ref percentage
+     * of the elements with the largest errors is refined.
+     */
+    void iterativeRefine(gsPointCloudReader<T> & reader, int iterations,
+                         T tolerance, T err_threshold = -1);
+
+    /// One step of iterativeRefine(gsPointCloudReader<T>&,int,T,T)
+    bool nextIteration(gsPointCloudReader<T> & reader,
+                       T tolerance, T err_threshold);
+
+    /// Computes the least squares fit of the point cloud provided
+    /// by \a reader, accumulating the system chunk by chunk
+    void compute(gsPointCloudReader<T> & reader, T lambda = 0);
+
+    /// Computes the point-wise errors of the point cloud provided by
+    /// \a reader and accumulates them per element of the finest
+    /// level, without storing them
+    void computeErrors(gsPointCloudReader<T> & reader);
+
+    /// Returns the element-wise error statistics computed by the
+    /// last call of computeErrors or computeMaxNormErrors
+    const cellErrorMap & cellErrors() const { return m_cellErrors; }
+
     /// Return the refinement percentage
     T getRefPercentage() const
     {
@@ -143,6 +237,10 @@ public:
     std::vector<index_t> getBoxes(const std::vector<T>& errors,
                                    const T threshold);
 
+    /// Returns boxes which define refinment area, using the
+    /// element-wise error statistics.
+    std::vector<index_t> getBoxes(const T threshold);
+
     /// Sets constraints in such a way that the previous values at \a
     /// fixedSides of the geometry remain intact.
     void setConstraints(const std::vector<boxSide>& fixedSides);
@@ -163,6 +261,17 @@ protected:
     /// Identifies the threshold from where we should refine
     T setRefineThreshold(const std::vector<T>& errors);
 
+    /// Returns the (lexicographic) index of the element of the
+    /// finest level which contains \a parameter
+    size_t cellIndex(const gsVector<T>& parameter) const;
+
+    /// Adds the error \a err of the point with parameter \a param
+    /// to the statistics of the element \a cell
+    void addCellError(size_t cell, const gsVector<T>& param, T err);
+
+    /// Computes m_cellErrors from the point-wise errors
+    void computeCellErrors();
+
     /// Checks if a_cell is already inserted in container of cells
     static bool isCellAlreadyInserted(const gsVector<index_t, d>& a_cell,
                                       const std::vector<index_t>& cells);
@@ -186,6 +295,9 @@ protected:
     /// Size of the extension
     std::vector<unsigned> m_ext;
 
+    /// Error statistics per element of the finest level
+    cellErrorMap m_cellErrors;
+
     using gsFitting<T>::m_param_values;
     using gsFitting<T>::m_points;
     using gsFitting<T>::m_basis;
@@ -279,7 +391,8 @@ bool gsHFitting<d, T>::nextIteration(T tolerance, T err_threshold,
             // if err_treshold is -1 we refine the m_ref percent of the whole domain
             T threshold = (err_threshold >= 0) ? err_threshold : setRefineThreshold(m_pointErrors);
 
-            std::vector<index_t> boxes = getBoxes(m_pointErrors, threshold);
+            // An element is marked iff its maximum error exceeds the threshold
+            std::vector<index_t> boxes = getBoxes(threshold);
             if(boxes.size()==0)
                 return false;
 
@@ -339,6 +452,210 @@ void gsHFitting<d, T>::iterativeRefine(int numIterations, T tolerance, T err_thr
     }
 }
 
+template<short_t d, class T>
+bool gsHFitting<d, T>::nextIteration(gsPointCloudReader<T> & reader,
+                                     T tolerance, T err_threshold)
+{
+    // INVARIANT
+    // look at iterativeRefine(reader,...)
+
+    if ( m_cellErrors.size() != 0 )
+    {
+        if ( m_max_error > tolerance )
+        {
+            T threshold = err_threshold;
+            if ( err_threshold < 0 )
+            {
+                std::vector<T> errors;
+                errors.reserve(m_cellErrors.size());
+                for (typename cellErrorMap::const_iterator it = m_cellErrors.begin();
+                     it != m_cellErrors.end(); ++it)
+                    errors.push_back(it->second.maxErr);
+                threshold = setRefineThreshold(errors);
+            }
+
+            std::vector<index_t> boxes = getBoxes(threshold);
+            if(boxes.size()==0)
+                return false;
+
+            gsHTensorBasis<d, T>* basis = static_cast<gsHTensorBasis<d,T> *> (this->m_basis);
+            basis->refineElements(boxes);
+
+            gsDebug << "inserted " << boxes.size() / (2 * d + 1) << " boxes.\n";
+        }
+        else
+        {
+            gsDebug << "Tolerance reached.\n";
+            return false;
+        }
+    }
+
+    // We run one fitting step and compute the errors
+    this->compute(reader, m_lambda);
+    this->computeErrors(reader);
+
+    return true;
+}
+
+template<short_t d, class T>
+void gsHFitting<d, T>::iterativeRefine(gsPointCloudReader<T> & reader, int numIterations,
+                                       T tolerance, T err_threshold)
+{
+    // INVARIANT:
+    // m_cellErrors contains the element-wise errors of the fitting
+    // therefore: if it is empty, there was no fitting up to this point
+
+    if ( m_cellErrors.size() == 0 )
+    {
+        this->compute(reader, m_lambda);
+        this->computeErrors(reader);
+    }
+
+    bool newIteration;
+    for( int i = 0; i < numIterations; i++ )
+    {
+        newIteration = nextIteration( reader, tolerance, err_threshold );
+        if( m_max_error <= tolerance )
+        {
+            gsDebug << "Tolerance reached at iteration: " << i << "\n";
+            break;
+        }
+        if( !newIteration )
+        {
+            gsDebug << "No more Boxes to insert at iteration: " << i << "\n";
+            break;
+        }
+    }
+}
+
+template<short_t d, class T>
+void gsHFitting<d, T>::compute(gsPointCloudReader<T> & reader, T lambda)
+{
+    GISMO_ASSERT(reader.parDim() == d, "Wrong dimension of the parameters.");
+
+    gsSparseMatrix<T> A_mat;
+    gsMatrix<T> B, params, points;
+    this->initSystem(reader.geoDim(), A_mat, B);
+
+    reader.rewind();
+    while ( reader.next(params, points) )
+    {
+        points.transposeInPlace();
+        this->assembleSystem(params, points, A_mat, B);
+    }
+
+    this->solveSystem(lambda, A_mat, B);
+}
+
+template<short_t d, class T>
+void gsHFitting<d, T>::computeErrors(gsPointCloudReader<T> & reader)
+{
+    GISMO_ASSERT(m_result != NULL, "No fitting result available.");
+
+    m_cellErrors.clear();
+    m_max_error = m_min_error = 0;
+
+    gsMatrix<T> params, points, values;
+    bool first = true;
+
+    reader.rewind();
+    while ( reader.next(params, points) )
+    {
+        m_result->eval_into(params, values);
+
+        for (index_t k = 0; k != params.cols(); ++k)
+        {
+            const T err = (points.col(k) - values.col(k)).norm();
+
+            if ( first || err > m_max_error ) m_max_error = err;
+            if ( first || err < m_min_error ) m_min_error = err;
+            first = false;
+
+            addCellError(cellIndex(params.col(k)), params.col(k), err);
+        }
+    }
+}
+
+template<short_t d, class T>
+void gsHFitting<d, T>::computeErrors()
+{
+    gsFitting<T>::computeErrors();
+    computeCellErrors();
+}
+
+template<short_t d, class T>
+void gsHFitting<d, T>::computeMaxNormErrors()
+{
+    gsFitting<T>::computeMaxNormErrors();
+    computeCellErrors();
+}
+
+template<short_t d, class T>
+void gsHFitting<d, T>::computeCellErrors()
+{
+    m_cellErrors.clear();
+
+    const index_t num_points = m_param_values.cols();
+    std::vector<size_t> cells(num_points);
+
+#pragma omp parallel for
+    for (index_t k = 0; k < num_points; ++k)
+        cells[k] = cellIndex(m_param_values.col(k));
+
+    for (index_t k = 0; k != num_points; ++k)
+        addCellError(cells[k], m_param_values.col(k), m_pointErrors[k]);
+}
+
+template<short_t d, class T>
+void gsHFitting<d, T>::addCellError(size_t cell, const gsVector<T>& param, T err)
+{
+    cellError & ce = m_cellErrors[cell];
+    if ( 0 == ce.numPoints || ce.maxErr < err )
+    {
+        ce.maxErr = err;
+        ce.param  = param;
+    }
+    ce.sqErr += err * err;
+    ++ce.numPoints;
+}
+
+template <short_t d, class T>
+std::vector<index_t> gsHFitting<d, T>::getBoxes(const T threshold)
+{
+    // boxes contains elements marked for refinement from differnet levels,
+    // format: { level lower-corners  upper-corners ... }
+    std::vector<index_t> boxes, cells;
+
+    // note: the marked elements are distinct by construction
+    for (typename cellErrorMap::const_iterator it = m_cellErrors.begin();
+         it != m_cellErrors.end(); ++it)
+    {
+        if (threshold <= it->second.maxErr)
+        {
+            cells.clear();
+            appendBox(boxes, cells, it->second.param);
+        }
+    }
+
+    return boxes;
+}
+
+template <short_t d, class T>
+size_t gsHFitting<d, T>::cellIndex(const gsVector<T>& parameter) const
+{
+    const gsTHBSplineBasis<d, T>* basis = static_cast<const gsTHBSplineBasis<d,T>*> (this->m_basis);
+    const tensorBasis & tBasis = *(basis->getBases()[basis->maxLevel()]);
+
+    size_t result = 0, stride = 1;
+    for (short_t dim = 0; dim != d; dim++)
+    {
+        const gsKnotVector<T> & kv = tBasis.component(dim).knots();
+        result += stride * kv.uFind(parameter(dim)).uIndex();
+        stride *= kv.numElements();
+    }
+    return result;
+}
+
 template <short_t d, class T>
 std::vector<index_t> gsHFitting<d, T>::getBoxes(const std::vector<T>& errors,
                                                  const T threshold)
@@ -17,6 +17,7 @@
 
 #include <gsIO/gsXml.h>
 #include <gsIO/gsXmlGenericUtils.hpp>
+#include <gsUtils/gsProfiler.h>
 
 namespace gismo
 {
@@ -421,6 +422,7 @@ void gsHTensorBasis<d,T>::refine(gsMatrix<T> const & boxes)
 template<short_t d, class T>
 void gsHTensorBasis<d,T>::refineElements(std::vector<index_t> const & boxes)
 {
+    GISMO_PROFILE("gsHTensorBasis::refineElements");
     point i1;
     point i2;
 
@@ -918,39 +920,27 @@ void gsHTensorBasis<d,T>::initialize_class(gsBasis<T> const&  tbasis)
 template<short_t d, class T>
 void gsHTensorBasis<d,T>::active_into(const gsMatrix<T> & u, gsMatrix<index_t>& result) const
 {
-    gsMatrix<T> currPoint;
     point low, upp, cur;
     const int maxLevel = m_tree.getMaxInsLevel();
 
-    std::vector<std::vector<index_t> > temp_output;//collects the outputs
-    temp_output.resize( u.cols() );
+    // The actives of all points are collected consecutively in one
+    // buffer, point p owns the range [offset[p], offset[p+1])
+    std::vector<index_t> temp_output;//collects the outputs
+    std::vector<size_t>  offset(u.cols()+1);
+    offset[0] = 0;
     size_t sz = 0;
 
-    //gsMatrix<index_t> activesLvl;
-
     for(index_t p = 0; p < u.cols(); p++) //for all input points
     {
-        currPoint = u.col(p);
-        
         for(short_t i = 0; i != d; ++i)
-            low[i] = m_bases[maxLevel]->knots(i).uFind( currPoint(i,0) ).uIndex();
+            low[i] = m_bases[maxLevel]->knots(i).uFind( u(i,p) ).uIndex();
         
         // Identify the level of the point
         const int lvl = m_tree.levelOf(low, maxLevel);
 
         for(int i = 0; i <= lvl; i++)
         {
-            /*
-              m_bases[i]->active_into(currPoint, activesLvl);
-              
-              std::set_intersection(m_xmatrix[i].begin(), m_xmatrix[i].end(),
-              activesLvl.data(), activesLvl.data() + activesLvl.size(),
-              std::back_inserter( temp_output[p] ) );
-              +++ Renumbering to H-basis indexing
-            // */                                 
-
-            // /*
-            m_bases[i]->active_cwise(currPoint, low, upp);
+            m_bases[i]->active_cwise(u.col(p), low, upp);
             cur = low;
             do
             {
@@ -959,26 +949,27 @@ void gsHTensorBasis<d,T>::active_into(const gsMatrix<T> & u, gsMatrix<index_t>&
 
                 if( it != m_xmatrix[i].end() )// if index is found
                 {
-                    temp_output[p].push_back(
+                    temp_output.push_back(
                         this->m_xmatrix_offset[i] + (it - m_xmatrix[i].begin() )
                         );
                 }
             }
             while( nextCubePoint(cur,low,upp) );
-            //*/
         }
 
         // update result size
-        if ( temp_output[p].size() > sz )
-            sz = temp_output[p].size();
+        offset[p+1] = temp_output.size();
+        if ( offset[p+1] - offset[p] > sz )
+            sz = offset[p+1] - offset[p];
     }
 
     result.resize(sz, u.cols() );
     for(index_t i = 0; i < result.cols(); i++)
     {
-        result.col(i).topRows(temp_output[i].size())
-            = gsAsConstVector<index_t>(temp_output[i]);
-        result.col(i).bottomRows(sz-temp_output[i].size()).setZero();
+        const size_t numAct = offset[i+1] - offset[i];
+        result.col(i).topRows(numAct)
+            = gsAsConstVector<index_t>(temp_output.data() + offset[i], numAct);
+        result.col(i).bottomRows(sz-numAct).setZero();
     }
 }
 
@@ -1046,6 +1037,7 @@ void gsHTensorBasis<d,T>::evalAllDers_into(const gsMatrix<T> & u, int n,
 template<short_t d, class T>
 void gsHTensorBasis<d,T>::uniformRefine(int numKnots, int mul)
 {
+    GISMO_PROFILE("gsHTensorBasis::uniformRefine");
     GISMO_UNUSED(numKnots);
     GISMO_ASSERT(numKnots == 1, "Only implemented for numKnots = 1");
 
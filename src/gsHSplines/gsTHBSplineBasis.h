@@ -21,6 +21,8 @@
 namespace gismo
 {  
 
+template<short_t d, class T> class gsTHBSplineEvaluator;
+
 /**
  * \brief
  * Truncated hierarchical B-spline basis.
@@ -131,6 +133,14 @@ public:
 
     // Look at gsBasis class for documentation
     void deriv_into(const gsMatrix<T>& u, gsMatrix<T>& result) const;
+
+    // Look at gsBasis class for documentation
+    void evalAllDers_into(const gsMatrix<T> & u, int n,
+                          std::vector<gsMatrix<T> >& result) const;
+
+    // Look at gsBasis class for documentation
+    typename gsBasisEvaluator<T>::uPtr makeEvaluator() const
+    { return typename gsBasisEvaluator<T>::uPtr(new gsTHBSplineEvaluator<d,T>(*this)); }
  
     // Look at gsBasis class for documentation
     void derivSingle_into(index_t i,
@@ -391,6 +401,8 @@ public:
 
 private:
 
+    friend class gsTHBSplineEvaluator<d,T>;
+
     unsigned getPresLevelOfBasisFun(const unsigned index) const
     {
         if (m_is_truncated[index] == -1)
@@ -727,6 +739,49 @@ private:
  * End of class gsTHBSplineBasis definition
  */
 
+/**
+ * \brief Evaluator of a truncated hierarchical B-spline basis.
+ *
+ * Every level which is needed is evaluated once on all the points,
+ * and the (truncated) basis functions are combined from the values
+ * of the levels. The values and the evaluators of the levels are kept
+ * between calls.
+ *
+ * \ingroup HSplines
+ */
+template<short_t d, class T>
+class gsTHBSplineEvaluator : public gsBasisEvaluator<T>
+{
+public:
+    explicit gsTHBSplineEvaluator(const gsTHBSplineBasis<d,T> & basis)
+    : gsBasisEvaluator<T>(basis), m_thb(&basis)
+    { }
+
+    ~gsTHBSplineEvaluator() { freeAll(m_levelEval); }
+
+    // Look at gsBasisEvaluator class for documentation
+    void evalAllDers_into(const gsMatrix<T> & u, int n,
+                          std::vector<gsMatrix<T> >& result);
+
+private:
+    gsTHBSplineEvaluator(const gsTHBSplineEvaluator &);
+    gsTHBSplineEvaluator & operator=(const gsTHBSplineEvaluator &);
+
+private:
+    const gsTHBSplineBasis<d,T> * m_thb;
+
+    // Active functions of the basis at the points
+    gsMatrix<index_t> m_actives;
+
+    // Per level: evaluator, active functions and values/derivatives
+    std::vector<gsBasisEvaluator<T>*>         m_levelEval;
+    std::vector<gsMatrix<index_t> >           m_levelActives;
+    std::vector<std::vector<gsMatrix<T> > >   m_levelValues;
+
+    // Levels needed for the current points
+    std::vector<char> m_needed;
+};
+
 
 } // namespace gismo
 
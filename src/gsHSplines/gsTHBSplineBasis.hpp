@@ -1140,6 +1140,113 @@ void gsTHBSplineBasis<d,T>::deriv_into(const gsMatrix<T>& u, gsMatrix<T>& result
 }
 
 
+template<short_t d, class T>
+void gsTHBSplineBasis<d,T>::evalAllDers_into(const gsMatrix<T> & u, int n,
+                                             std::vector<gsMatrix<T> >& result) const
+{
+    gsTHBSplineEvaluator<d,T> ev(*this);
+    ev.evalAllDers_into(u, n, result);
+}
+
+template<short_t d, class T>
+void gsTHBSplineEvaluator<d,T>::evalAllDers_into(const gsMatrix<T> & u, int n,
+                                                 std::vector<gsMatrix<T> >& result)
+{
+    GISMO_ASSERT(n>-2, "gsTHBSplineBasis::evalAllDers() is implemented only for -2<n: -1 means no value, 0 values only, ... " );
+    if (n==-1)
+    {
+        result.resize(0);
+        return;
+    }
+
+    const gsTHBSplineBasis<d,T> & thb = *m_thb;
+    const size_t nLevels = thb.m_bases.size();
+
+    thb.active_into(u, m_actives);
+    const index_t numAct = m_actives.rows();
+
+    result.resize(n+1);
+    for (int k = 0; k <= n; ++k)
+        result[k].setZero(numAct * numCompositions(k,d), u.cols());
+
+    // Find the levels which are needed for the points
+    m_needed.assign(nLevels, 0);
+    for (index_t p = 0; p < m_actives.cols(); ++p)
+        for (index_t j = 0; j < numAct; ++j)
+        {
+            const index_t index = m_actives(j, p);
+            if (j != 0 && index == 0)
+                break;
+            m_needed[thb.getPresLevelOfBasisFun(index)] = 1;
+        }
+
+    // Evaluate the needed levels on all points
+    if ( m_levelEval.size() < nLevels )
+    {
+        m_levelEval   .resize(nLevels, NULL);
+        m_levelActives.resize(nLevels);
+        m_levelValues .resize(nLevels);
+    }
+    for (size_t lvl = 0; lvl != nLevels; ++lvl)
+    {
+        if (!m_needed[lvl]) continue;
+
+        // The levels change when the basis is refined
+        if ( NULL == m_levelEval[lvl] ||
+             &m_levelEval[lvl]->basis() != thb.m_bases[lvl] )
+        {
+            delete m_levelEval[lvl];
+            m_levelEval[lvl] = thb.m_bases[lvl]->makeEvaluator().release();
+        }
+        m_levelEval[lvl]->evalAllDers_into(u, n, m_levelValues[lvl]);
+        thb.m_bases[lvl]->active_into(u, m_levelActives[lvl]);
+    }
+
+    // Combine the values of the levels
+    for (index_t p = 0; p < m_actives.cols(); ++p)
+    {
+        for (index_t j = 0; j < numAct; ++j)
+        {
+            const index_t index = m_actives(j, p);
+            if (j != 0 && index == 0)
+                break;
+
+            const unsigned lvl = thb.getPresLevelOfBasisFun(index);
+            const gsMatrix<index_t> & act = m_levelActives[lvl];
+            const std::vector<gsMatrix<T> > & vals = m_levelValues[lvl];
+
+            if (thb.m_is_truncated[index] == -1)
+            {
+                const index_t flatTenIndx = thb.flatTensorIndexOf(index, lvl);
+                index_t r = 0;
+                while ( r != act.rows() && act(r, p) != flatTenIndx ) ++r;
+                GISMO_ASSERT( r != act.rows(), "Basis function is not active on its level." );
+
+                for (int k = 0; k <= n; ++k)
+                {
+                    const index_t nd = numCompositions(k,d);
+                    result[k].block(j*nd, p, nd, 1) = vals[k].block(r*nd, p, nd, 1);
+                }
+            }
+            else // basis function is truncated
+            {
+                const gsSparseVector<T> & coefs = thb.getCoefs(index);
+                for (index_t r = 0; r != act.rows(); ++r)
+                {
+                    const T c = coefs.coeff(act(r, p));
+                    if (0 == c) continue;
+                    for (int k = 0; k <= n; ++k)
+                    {
+                        const index_t nd = numCompositions(k,d);
+                        result[k].block(j*nd, p, nd, 1).noalias() +=
+                            c * vals[k].block(r*nd, p, nd, 1);
+                    }
+                }
+            }
+        }
+    }
+}
+
 template<short_t d, class T>
 void gsTHBSplineBasis<d,T>::derivSingle_into(index_t i,
                                              const gsMatrix<T> & u,
@@ -14,6 +14,11 @@ CLASS_TEMPLATE_INST gsTHBSplineBasis <2,real_t>;
 CLASS_TEMPLATE_INST gsTHBSplineBasis <3,real_t>;
 CLASS_TEMPLATE_INST gsTHBSplineBasis <4,real_t>;
 
+CLASS_TEMPLATE_INST gsTHBSplineEvaluator <1,real_t>;
+CLASS_TEMPLATE_INST gsTHBSplineEvaluator <2,real_t>;
+CLASS_TEMPLATE_INST gsTHBSplineEvaluator <3,real_t>;
+CLASS_TEMPLATE_INST gsTHBSplineEvaluator <4,real_t>;
+
 CLASS_TEMPLATE_INST gsTHBSpline      <1,real_t>;
 CLASS_TEMPLATE_INST gsTHBSpline      <2,real_t>;
 CLASS_TEMPLATE_INST gsTHBSpline      <3,real_t>;
@@ -39,6 +39,7 @@
 
 #include <gzstream/gzstream.h>
 #include <gsIO/gsFileManager.h>
+#include <gsUtils/gsProfiler.h>
 
 namespace gismo {
 
@@ -97,6 +98,7 @@ gsFileData<T>::addComment(std::string const & message)
 template<class T> void
 gsFileData<T>::save(std::string const & fname, bool compress)  const
 {
+    GISMO_PROFILE("gsFileData::save");
     gsXmlNode * comment = internal::makeComment("This file was created by G+Smo "
                                                 GISMO_VERSION, *data);
     data->prepend_node(comment);
@@ -157,6 +159,7 @@ gsFileData<T>::ioError(int lineNumber, const std::string& str)
 template<class T>
 bool gsFileData<T>::read(String const & fn)
 {
+    GISMO_PROFILE("gsFileData::read");
 
     m_lastPath = gsFileManager::find(fn);
     if ( m_lastPath.empty() )
@@ -0,0 +1,140 @@
+/** @file gsPointCloudReader.h
+
+    @brief Reads parametrized point clouds from files in chunks
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <gsCore/gsLinearAlgebra.h>
+
+namespace gismo
+{
+
+/**
+  \brief Reads a parametrized point cloud from a file in chunks of
+  bounded size, so that point clouds which do not fit in memory can
+  be processed (e.g. by gsHFitting).
+
+  Every record of the file consists of \a parDim parameter values
+  followed by \a geoDim point coordinates. Two formats are supported:
+  - text (CSV): one record per line, values separated by commas,
+    semicolons, tabs or spaces. Empty lines and lines starting with
+    '#' are skipped.
+  - binary: the records are stored consecutively as raw values of
+    type \a T.
+
+  \tparam T arithmetic type
+
+  \ingroup IO
+ */
+template<class T = real_t>
+class gsPointCloudReader
+{
+public:
+
+    /// Opens the file \a fn for reading records of \a parDim
+    /// parameter values and \a geoDim coordinates, in chunks of at
+    /// most \a chunkSize points
+    gsPointCloudReader(std::string const & fn, short_t parDim, short_t geoDim,
+                       index_t chunkSize = 100000, bool binary = false)
+    : m_fn(fn), m_parDim(parDim), m_geoDim(geoDim),
+      m_chunkSize(chunkSize), m_binary(binary)
+    {
+        GISMO_ASSERT(chunkSize > 0, "Chunk size must be positive.");
+        rewind();
+    }
+
+public:
+
+    /// Restarts reading from the beginning of the file
+    void rewind()
+    {
+        m_file.close();
+        m_file.clear();
+        m_file.open(m_fn.c_str(), m_binary ? std::ios::in|std::ios::binary
+                                           : std::ios::in);
+        GISMO_ENSURE(m_file.is_open(), "Problem opening file "<<m_fn);
+    }
+
+    /// Reads the next chunk of parameters (columns of \a params) and
+    /// points (columns of \a points). Returns false if the end of the
+    /// file was reached and no more points are available.
+    bool next(gsMatrix<T> & params, gsMatrix<T> & points)
+    {
+        params.resize(m_parDim, m_chunkSize);
+        points.resize(m_geoDim, m_chunkSize);
+        const index_t rs = m_parDim + m_geoDim;
+        gsVector<T> rec(rs);
+
+        index_t n = 0;
+        while ( n != m_chunkSize && (m_binary ? readBinary(rec) : readLine(rec)) )
+        {
+            params.col(n) = rec.head(m_parDim);
+            points.col(n) = rec.tail(m_geoDim);
+            ++n;
+        }
+
+        params.conservativeResize(Eigen::NoChange, n);
+        points.conservativeResize(Eigen::NoChange, n);
+        return 0 != n;
+    }
+
+    /// Dimension of the parameters
+    short_t parDim() const { return m_parDim; }
+
+    /// Dimension of the points
+    short_t geoDim() const { return m_geoDim; }
+
+    /// Maximum number of points per chunk
+    index_t chunkSize() const { return m_chunkSize; }
+
+private:
+
+    bool readBinary(gsVector<T> & rec)
+    {
+        m_file.read(reinterpret_cast<char*>(rec.data()), rec.size()*sizeof(T));
+        return m_file.gcount() == static_cast<std::streamsize>(rec.size()*sizeof(T));
+    }
+
+    bool readLine(gsVector<T> & rec)
+    {
+        while ( std::getline(m_file, m_line) )
+        {
+            std::replace(m_line.begin(), m_line.end(), ',', ' ');
+            std::replace(m_line.begin(), m_line.end(), ';', ' ');
+            std::istringstream str(m_line);
+            str >> std::ws;
+            if ( str.eof() || '#' == str.peek() )
+                continue;
+
+            index_t i = 0;
+            for (; i != rec.size() && (str >> rec[i]); ++i) ;
+            GISMO_ENSURE(i == rec.size(), "Incomplete record in "<<m_fn
+                         <<": \""<<m_line<<"\"");
+            return true;
+        }
+        return false;
+    }
+
+private:
+
+    std::string   m_fn;
+    std::ifstream m_file;
+    std::string   m_line;
+
+    short_t m_parDim, m_geoDim;
+    index_t m_chunkSize;
+    bool    m_binary;
+};
+
+} // namespace gismo
@@ -1398,12 +1398,13 @@ void gsWriteParaviewSolid(gsSolid<T> const& sl,
     // for( typename gsSolid<T>::const_face_iterator it = sl.begin();
     //      it != sl.end(); ++it)
 
+    // The faces are tessellated and written in parallel
+#pragma omp parallel for schedule(dynamic)
+    for ( index_t i=0; i<static_cast<index_t>(n) ; i++)
+        writeSingleTrimSurface(*sl.face[i]->surf, fn + util::to_string(i), numSamples);
+
     for ( size_t i=0; i<n ; i++)
-    {
-        std::string fnBase = fn + util::to_string(i);
-        writeSingleTrimSurface(*sl.face[i]->surf, fnBase, numSamples);
-        collection.addPart(fnBase, ".vtp");
-    }
+        collection.addPart(fn + util::to_string(i), ".vtp");
 
     // Write out the collection file
     collection.save();
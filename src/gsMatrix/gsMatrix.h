@@ -98,6 +98,11 @@ public:
     // copied into a gsMatrix
     typedef const Eigen::Ref<const Base> constRef;
 
+    // Type refering (without a copy) to a (const) row of a matrix,
+    // of a map or of a block
+    typedef const Eigen::Ref<const Eigen::Matrix<T,1,_Cols>, 0,
+                             Eigen::InnerStride<> > constRowRef;
+
     /// Shared pointer for gsMatrix
     typedef memory::shared_ptr<gsMatrix> Ptr;
 
@@ -51,13 +51,16 @@ void gaussElim()
 
 /**
   * \brief Inversion for small matrices using Cramer's Rule
+  *
+  * The result has at most 4x4 entries and is stored without heap
+  * allocation.
   */
-inline Matrix<Scalar, Dynamic, Dynamic> cramerInverse() const
+inline Matrix<Scalar, Dynamic, Dynamic, ColMajor, 4, 4> cramerInverse() const
 {
     const Derived & M = derived();
     eigen_assert(M.rows() == M.cols() && "Matrix is not square.");
 
-    Matrix<Scalar, Dynamic, Dynamic> rvo1(M.rows(), M.rows());
+    Matrix<Scalar, Dynamic, Dynamic, ColMajor, 4, 4> rvo1(M.rows(), M.rows());
     switch (M.rows())
     {
         case 1:
@@ -83,6 +86,5 @@ inline Matrix<Scalar, Dynamic, Dynamic> cramerInverse() const
   */
 inline void cramerInverseInPlace()
 {
-//    derived() = cramerInverse().eval();
-    derived().swap(cramerInverse().eval());
+    derived() = cramerInverse();
 }
\ No newline at end of file
@@ -0,0 +1,139 @@
+/** @file gsWorkspace.h
+
+    @brief Arena of scratch memory for matrices which are re-sized in
+    every iteration of an element loop
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+# pragma once
+
+// Assumes that Eigen library has been already included
+
+#include <new>
+
+namespace gismo
+{
+
+/** \brief Bump allocator for the temporaries of an element loop.
+
+    Matrices are handed out as gsAsMatrix views of consecutive chunks
+    of a memory block. The views stay valid until the next call of
+    reset(), which makes all the memory available again. Typically,
+    reset() is called once per element. After the first few elements
+    the block is large enough for all the temporaries of an element,
+    and the loop runs without any heap allocation, regardless of the
+    varying number of active functions (eg. for hierarchical bases).
+
+    A copy of a workspace starts empty, so that the thread-private
+    copies of a visitor, created in a parallel element loop, own their
+    memory.
+
+    \code
+    ws.reset();
+    ws.bind(localMat, numActive, numActive);
+    localMat.setZero();
+    \endcode
+
+    \tparam T coefficient type
+    \ingroup Matrix
+*/
+template<class T>
+class gsWorkspace
+{
+public:
+
+    gsWorkspace() : m_block(0), m_used(0), m_allocs(0) { }
+
+    gsWorkspace(const gsWorkspace &) : m_block(0), m_used(0), m_allocs(0) { }
+
+    ~gsWorkspace() { release(); }
+
+    gsWorkspace & operator=(const gsWorkspace &) { return *this; }
+
+public:
+
+    /// Returns a pointer to \a n consecutive (uninitialized)
+    /// coefficients
+    T * allocate(const index_t n)
+    {
+        if (0 == n) return NULL;
+
+        for (; m_block != m_blocks.size(); ++m_block, m_used = 0)
+            if ( m_used + n <= m_blocks[m_block].second )
+            {
+                T * result = m_blocks[m_block].first + m_used;
+                m_used += n;
+                return result;
+            }
+
+        // Grow geometrically, so that few blocks are needed until the
+        // workspace reaches its steady-state size
+        const size_t sz = math::max( math::max((size_t)n, 2 * capacity()), (size_t)256 );
+        m_blocks.push_back( std::make_pair(new T[sz], sz) );
+        ++m_allocs;
+        m_used = n;
+        return m_blocks.back().first;
+    }
+
+    /// Returns a \a rows x \a cols (uninitialized) matrix
+    gsAsMatrix<T> matrix(const index_t rows, const index_t cols)
+    { return gsAsMatrix<T>(allocate(rows*cols), rows, cols); }
+
+    /// Makes \a m a view of a \a rows x \a cols (uninitialized) matrix
+    void bind(gsAsMatrix<T> & m, const index_t rows, const index_t cols)
+    { new (&m) gsAsMatrix<T>(allocate(rows*cols), rows, cols); }
+
+    /// Makes all the memory available again. The matrices handed out
+    /// before are not valid anymore.
+    void reset()
+    {
+        // Merge the blocks into one, so that a single block is used
+        // in the steady state
+        if ( m_blocks.size() > 1 )
+        {
+            const size_t sz = capacity();
+            release();
+            m_blocks.push_back( std::make_pair(new T[sz], sz) );
+            ++m_allocs;
+        }
+        m_block = 0;
+        m_used  = 0;
+    }
+
+    /// Number of coefficients that fit in the workspace
+    size_t capacity() const
+    {
+        size_t result = 0;
+        for (size_t i = 0; i != m_blocks.size(); ++i)
+            result += m_blocks[i].second;
+        return result;
+    }
+
+    /// Number of heap allocations performed by the workspace so far
+    index_t allocations() const { return m_allocs; }
+
+private:
+
+    void release()
+    {
+        for (size_t i = 0; i != m_blocks.size(); ++i)
+            delete[] m_blocks[i].first;
+        m_blocks.clear();
+    }
+
+private:
+
+    std::vector<std::pair<T*,size_t> > m_blocks;
+
+    size_t m_block; // current block
+    size_t m_used;  // coefficients used in the current block
+
+    index_t m_allocs;
+};
+
+} // namespace gismo
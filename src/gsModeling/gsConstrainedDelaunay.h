@@ -0,0 +1,194 @@
+/** @file gsConstrainedDelaunay.h
+
+    @brief Provides a constrained Delaunay triangulation of planar
+    point sets and polygonal domains.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsCore/gsLinearAlgebra.h>
+#include <gsUtils/gsMesh/gsMesh.h>
+
+namespace gismo
+{
+
+/**
+   \brief Constrained Delaunay triangulation of a set of points in
+   the plane.
+
+   The points are inserted incrementally (Lawson flips), in a spatially
+   sorted order, so that point location by walking is cheap and the
+   triangulation takes O(n log n) time for well-distributed points.
+   Afterwards the constrained segments are recovered by edge flips
+   (Sloan's algorithm) and the Delaunay property is restored away
+   from them.
+
+   If the segments form closed loops, the triangles outside the
+   domain bounded by the loops (e.g. in holes) can be removed, using
+   the even-odd rule.
+
+   Example:
+   \code
+   gsConstrainedDelaunay<T> cdt;
+   cdt.addLoop(outer);   // 2 x n matrix of consecutive points
+   cdt.addLoop(hole);
+   cdt.addPoints(inner); // Steiner points
+   cdt.compute();
+   typename gsMesh<T>::uPtr mesh = cdt.toMesh();
+   \endcode
+
+   \tparam T coordinate type
+
+   \ingroup Modeling
+*/
+template<class T>
+class gsConstrainedDelaunay
+{
+private:
+
+    /// A triangle of the triangulation, counter-clockwise oriented.
+    /// Edge k is the one opposite to vertex v[k], nb[k] is the
+    /// neighbor across edge k (or -1) and cs[k] tells whether the edge
+    /// is constrained.
+    struct triangle
+    {
+        index_t v[3];
+        index_t nb[3];
+        bool    cs[3];
+    };
+
+    typedef std::pair<index_t,index_t> edge;
+
+public:
+
+    /// Empty constructor
+    gsConstrainedDelaunay() { }
+
+public:
+
+    /// Adds a point with coordinates (x,y), returns its index
+    index_t addPoint(T x, T y);
+
+    /// Adds the columns of \a pts as points, returns the index of the
+    /// first one
+    index_t addPoints(gsMatrix<T> const & pts);
+
+    /// Adds a constrained segment between the points \a i and \a j
+    void addSegment(index_t i, index_t j);
+
+    /// Adds the columns of \a pts as points, together with the
+    /// segments joining consecutive points and the last point to the
+    /// first one. Returns the index of the first point.
+    index_t addLoop(gsMatrix<T> const & pts);
+
+    /// Computes the triangulation. If \a removeOutside is true, only
+    /// the triangles enclosed by the segments (by the even-odd rule)
+    /// are kept.
+    void compute(bool removeOutside = true);
+
+    /// Number of points
+    index_t numPoints() const { return m_coords.size() / 2; }
+
+    /// Number of triangles, available after compute()
+    index_t numTriangles() const { return m_result.size() / 3; }
+
+    /// Returns the points as the columns of a matrix
+    gsAsConstMatrix<T> points() const
+    { return gsAsConstMatrix<T>(m_coords, 2, numPoints()); }
+
+    /// Returns the point indices of the triangles (three per
+    /// triangle, counter-clockwise), available after compute()
+    const std::vector<index_t> & triangles() const { return m_result; }
+
+    /// Returns the triangulation as a mesh (unused points are omitted)
+    typename gsMesh<T>::uPtr toMesh() const;
+
+private:
+
+    // Geometric predicates (zero is returned if the result is not
+    // certain in floating point arithmetic)
+    T orient(index_t a, index_t b, index_t c) const;
+    T inCircle(index_t a, index_t b, index_t c, index_t d) const;
+
+    void superTriangle();
+    void insertPoint(index_t p);
+    index_t locate(index_t p, index_t t) const;
+    void splitTriangle(index_t t, index_t p);
+    void splitEdge(index_t t, short_t k, index_t p);
+    void legalizePoint(std::vector<std::pair<index_t,short_t> > & stack);
+    void legalizeEdges(std::vector<edge> & stack);
+    void flip(index_t t, short_t k);
+    void insertSegment(index_t a, index_t b);
+    bool findEdge(index_t x, index_t y, index_t & t, short_t & k) const;
+    void setConstrained(index_t t, short_t k);
+    void classify(std::vector<bool> & inside) const;
+
+    short_t position(index_t t, index_t v) const
+    {
+        const triangle & tr = m_tri[t];
+        return tr.v[0]==v ? 0 : (tr.v[1]==v ? 1 : 2);
+    }
+
+    short_t neighborIndex(index_t t, index_t u) const
+    {
+        const triangle & tr = m_tri[t];
+        return tr.nb[0]==u ? 0 : (tr.nb[1]==u ? 1 : 2);
+    }
+
+    void replaceNeighbor(index_t t, index_t from, index_t to)
+    {
+        if ( -1 != t )
+            m_tri[t].nb[neighborIndex(t,from)] = to;
+    }
+
+    void setTriangle(index_t t, index_t a, index_t b, index_t c,
+                     index_t na, index_t nb, index_t nc,
+                     bool ca, bool cb, bool cc)
+    {
+        triangle & tr = m_tri[t];
+        tr.v [0] = a ; tr.v [1] = b ; tr.v [2] = c ;
+        tr.nb[0] = na; tr.nb[1] = nb; tr.nb[2] = nc;
+        tr.cs[0] = ca; tr.cs[1] = cb; tr.cs[2] = cc;
+        m_vt[a] = m_vt[b] = m_vt[c] = t;
+    }
+
+private:
+
+    /// Point coordinates (x0,y0,x1,y1,...), followed by the
+    /// vertices of the super-triangle during compute()
+    std::vector<T> m_coords;
+
+    /// Constrained segments
+    std::vector<edge> m_segments;
+
+    /// Triangles
+    std::vector<triangle> m_tri;
+
+    /// A triangle incident to each vertex
+    std::vector<index_t> m_vt;
+
+    /// Vertex that represents each point (points that coincide with
+    /// an existing vertex are not inserted)
+    std::vector<index_t> m_map;
+
+    /// Resulting triangles
+    std::vector<index_t> m_result;
+
+    /// Triangle where the last insertion took place
+    index_t m_last;
+
+    /// Tolerance for coinciding points
+    T m_tol;
+};
+
+} // namespace gismo
+
+#ifndef GISMO_BUILD_LIB
+#include GISMO_HPP_HEADER(gsConstrainedDelaunay.hpp)
+#endif
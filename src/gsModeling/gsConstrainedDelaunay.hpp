@@ -0,0 +1,576 @@
+/** @file gsConstrainedDelaunay.hpp
+
+    @brief Provides implementation of the gsConstrainedDelaunay class.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsModeling/gsConstrainedDelaunay.h>
+
+#include <deque>
+
+namespace gismo
+{
+
+template<class T>
+index_t gsConstrainedDelaunay<T>::addPoint(T x, T y)
+{
+    m_coords.push_back(x);
+    m_coords.push_back(y);
+    return numPoints() - 1;
+}
+
+template<class T>
+index_t gsConstrainedDelaunay<T>::addPoints(gsMatrix<T> const & pts)
+{
+    GISMO_ASSERT(pts.rows() == 2, "Expecting points in the plane.");
+    const index_t first = numPoints();
+    m_coords.reserve(m_coords.size() + pts.size());
+    for (index_t i = 0; i != pts.cols(); ++i)
+        addPoint(pts(0,i), pts(1,i));
+    return first;
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::addSegment(index_t i, index_t j)
+{
+    GISMO_ASSERT(i < numPoints() && j < numPoints(), "Invalid point index.");
+    m_segments.push_back( edge(i,j) );
+}
+
+template<class T>
+index_t gsConstrainedDelaunay<T>::addLoop(gsMatrix<T> const & pts)
+{
+    const index_t first = addPoints(pts);
+    const index_t n = pts.cols();
+    for (index_t i = 0; i != n; ++i)
+        addSegment(first + i, first + (i+1) % n);
+    return first;
+}
+
+template<class T>
+T gsConstrainedDelaunay<T>::orient(index_t a, index_t b, index_t c) const
+{
+    const T * pa = &m_coords[2*a], * pb = &m_coords[2*b], * pc = &m_coords[2*c];
+    const T detleft  = (pa[0] - pc[0]) * (pb[1] - pc[1]);
+    const T detright = (pa[1] - pc[1]) * (pb[0] - pc[0]);
+    const T det = detleft - detright;
+
+    // Error bound of the floating point evaluation (Shewchuk)
+    static const T eps = std::numeric_limits<T>::epsilon() / 2;
+    const T bound = (3 + 16 * eps) * eps * (math::abs(detleft) + math::abs(detright));
+    return math::abs(det) > bound ? det : T(0);
+}
+
+template<class T>
+T gsConstrainedDelaunay<T>::inCircle(index_t a, index_t b, index_t c, index_t d) const
+{
+    const T * pa = &m_coords[2*a], * pb = &m_coords[2*b],
+            * pc = &m_coords[2*c], * pd = &m_coords[2*d];
+    const T adx = pa[0] - pd[0], ady = pa[1] - pd[1];
+    const T bdx = pb[0] - pd[0], bdy = pb[1] - pd[1];
+    const T cdx = pc[0] - pd[0], cdy = pc[1] - pd[1];
+
+    const T bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    const T cdxady = cdx * ady, adxcdy = adx * cdy;
+    const T adxbdy = adx * bdy, bdxady = bdx * ady;
+    const T alift = adx * adx + ady * ady;
+    const T blift = bdx * bdx + bdy * bdy;
+    const T clift = cdx * cdx + cdy * cdy;
+
+    const T det = alift * (bdxcdy - cdxbdy)
+                + blift * (cdxady - adxcdy)
+                + clift * (adxbdy - bdxady);
+
+    // Error bound of the floating point evaluation (Shewchuk)
+    static const T eps = std::numeric_limits<T>::epsilon() / 2;
+    const T permanent = (math::abs(bdxcdy) + math::abs(cdxbdy)) * alift
+                      + (math::abs(cdxady) + math::abs(adxcdy)) * blift
+                      + (math::abs(adxbdy) + math::abs(bdxady)) * clift;
+    const T bound = (10 + 96 * eps) * eps * permanent;
+    return math::abs(det) > bound ? det : T(0);
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::compute(bool removeOutside)
+{
+    const index_t n = numPoints();
+    GISMO_ENSURE(n > 2, "At least three points are needed.");
+
+    m_tri.clear();
+    m_tri.reserve(2*n + 1);
+    m_result.clear();
+    m_vt.assign(n+3, -1);
+    m_map.resize(n);
+
+    superTriangle();
+
+    // Insertion order: points sorted along horizontal strips, in a
+    // snake-like pattern, so that consecutive points are close
+    gsAsConstMatrix<T> pts(m_coords, 2, n);
+    const T ymin = pts.row(1).minCoeff();
+    const T ysz  = pts.row(1).maxCoeff() - ymin + m_tol;
+    const index_t ns = math::max( index_t(1), cast<T,index_t>(math::sqrt(T(n)/2)) );
+    std::vector<std::pair<std::pair<index_t,T>,index_t> > order(n);
+    for (index_t i = 0; i != n; ++i)
+    {
+        const index_t s = cast<T,index_t>( (pts(1,i)-ymin) / ysz * ns );
+        order[i].first.first  = s;
+        order[i].first.second = (s % 2 ? -1 : 1) * pts(0,i);
+        order[i].second       = i;
+    }
+    std::sort(order.begin(), order.end());
+
+    m_last = 0;
+    for (index_t i = 0; i != n; ++i)
+        insertPoint(order[i].second);
+
+    for (size_t s = 0; s != m_segments.size(); ++s)
+        insertSegment(m_map[m_segments[s].first], m_map[m_segments[s].second]);
+
+    std::vector<bool> inside;
+    if ( removeOutside )
+        classify(inside);
+
+    m_result.reserve(3*m_tri.size());
+    for (size_t t = 0; t != m_tri.size(); ++t)
+    {
+        const triangle & tr = m_tri[t];
+        if ( tr.v[0] >= n || tr.v[1] >= n || tr.v[2] >= n ) // super-triangle
+            continue;
+        if ( removeOutside && !inside[t] )
+            continue;
+        m_result.insert(m_result.end(), tr.v, tr.v+3);
+    }
+
+    // Release the work data
+    m_coords.resize(2*n);
+    std::vector<triangle>().swap(m_tri);
+    std::vector<index_t>().swap(m_vt);
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::superTriangle()
+{
+    const index_t n = numPoints();
+    gsAsConstMatrix<T> pts(m_coords, 2, n);
+    const gsVector<T,2> lo = pts.rowwise().minCoeff();
+    const gsVector<T,2> hi = pts.rowwise().maxCoeff();
+    const gsVector<T,2> c  = (lo + hi) / 2;
+    const T d = math::max( (hi - lo).maxCoeff(), T(1e-12) );
+    m_tol = d * 1e-12;
+
+    addPoint(c[0] - 20 * d, c[1] - 10 * d);
+    addPoint(c[0] + 20 * d, c[1] - 10 * d);
+    addPoint(c[0]         , c[1] + 20 * d);
+
+    m_tri.resize(1);
+    setTriangle(0, n, n+1, n+2, -1, -1, -1, false, false, false);
+}
+
+template<class T>
+index_t gsConstrainedDelaunay<T>::locate(index_t p, index_t t) const
+{
+    // Visibility walk, the starting edge rotates to avoid cycles
+    for (index_t step = 0; ; ++step)
+    {
+        const triangle & tr = m_tri[t];
+        short_t k = 0;
+        for (; k != 3; ++k)
+        {
+            const short_t e = (k + step) % 3;
+            if ( orient(tr.v[(e+1)%3], tr.v[(e+2)%3], p) < 0 )
+            {
+                t = tr.nb[e];
+                GISMO_ASSERT(-1 != t, "Point outside of the triangulation.");
+                break;
+            }
+        }
+        if ( 3 == k )
+            return t;
+    }
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::insertPoint(index_t p)
+{
+    const index_t t = locate(p, m_last);
+    const triangle & tr = m_tri[t];
+    const T * pp = &m_coords[2*p];
+
+    // Coinciding point?
+    for (short_t k = 0; k != 3; ++k)
+    {
+        const T * pv = &m_coords[2*tr.v[k]];
+        if ( math::abs(pp[0]-pv[0]) <= m_tol && math::abs(pp[1]-pv[1]) <= m_tol )
+        {
+            m_map[p] = tr.v[k];
+            return;
+        }
+    }
+
+    m_map[p] = p;
+    for (short_t k = 0; k != 3; ++k)
+        if ( 0 == orient(tr.v[(k+1)%3], tr.v[(k+2)%3], p) )
+        {
+            splitEdge(t, k, p);
+            return;
+        }
+
+    splitTriangle(t, p);
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::splitTriangle(index_t t, index_t p)
+{
+    const triangle old = m_tri[t];
+    const index_t a = old.v[0], b = old.v[1], c = old.v[2];
+    const index_t t1 = m_tri.size(), t2 = t1 + 1;
+    m_tri.resize(t2 + 1);
+
+    setTriangle(t , a, b, p, t1, t2, old.nb[2], false, false, old.cs[2]);
+    setTriangle(t1, b, c, p, t2, t , old.nb[0], false, false, old.cs[0]);
+    setTriangle(t2, c, a, p, t , t1, old.nb[1], false, false, old.cs[1]);
+    replaceNeighbor(old.nb[0], t, t1);
+    replaceNeighbor(old.nb[1], t, t2);
+
+    std::vector<std::pair<index_t,short_t> > stack;
+    stack.push_back( std::make_pair(t , 2) );
+    stack.push_back( std::make_pair(t1, 2) );
+    stack.push_back( std::make_pair(t2, 2) );
+    legalizePoint(stack);
+    m_last = t;
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::splitEdge(index_t t, short_t k, index_t p)
+{
+    // t = (c,a,b) with edge k = (a,b), u = (d,b,a) across it
+    const triangle ot = m_tri[t];
+    const index_t c = ot.v[k], a = ot.v[(k+1)%3], b = ot.v[(k+2)%3];
+    const index_t u = ot.nb[k];
+    GISMO_ASSERT(-1 != u, "Point on the boundary of the triangulation.");
+    const triangle ou = m_tri[u];
+    const short_t j = neighborIndex(u, t);
+    const index_t d = ou.v[j];
+    const bool cs = ot.cs[k];
+
+    const index_t t2 = m_tri.size(), u2 = t2 + 1;
+    m_tri.resize(u2 + 1);
+
+    setTriangle(t , c, a, p, u2, t2, ot.nb[(k+2)%3], cs, false, ot.cs[(k+2)%3]);
+    setTriangle(t2, c, p, b, u , ot.nb[(k+1)%3], t , cs, ot.cs[(k+1)%3], false);
+    setTriangle(u , d, b, p, t2, u2, ou.nb[(j+2)%3], cs, false, ou.cs[(j+2)%3]);
+    setTriangle(u2, d, p, a, t , ou.nb[(j+1)%3], u , cs, ou.cs[(j+1)%3], false);
+    replaceNeighbor(ot.nb[(k+1)%3], t, t2);
+    replaceNeighbor(ou.nb[(j+1)%3], u, u2);
+
+    std::vector<std::pair<index_t,short_t> > stack;
+    stack.push_back( std::make_pair(t , 2) );
+    stack.push_back( std::make_pair(t2, 1) );
+    stack.push_back( std::make_pair(u , 2) );
+    stack.push_back( std::make_pair(u2, 1) );
+    legalizePoint(stack);
+    m_last = t;
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::flip(index_t t, short_t k)
+{
+    // t = (p,a,b) with edge k = (a,b), u = (q,b,a) across it
+    const triangle ot = m_tri[t];
+    const index_t u = ot.nb[k];
+    const triangle ou = m_tri[u];
+    const short_t j = neighborIndex(u, t);
+    const index_t p = ot.v[k], a = ot.v[(k+1)%3], b = ot.v[(k+2)%3];
+    const index_t q = ou.v[j];
+
+    // New triangles t = (p,a,q) and u = (q,b,p)
+    setTriangle(t, p, a, q, ou.nb[(j+1)%3], u, ot.nb[(k+2)%3],
+                ou.cs[(j+1)%3], false, ot.cs[(k+2)%3]);
+    setTriangle(u, q, b, p, ot.nb[(k+1)%3], t, ou.nb[(j+2)%3],
+                ot.cs[(k+1)%3], false, ou.cs[(j+2)%3]);
+    replaceNeighbor(ou.nb[(j+1)%3], u, t);
+    replaceNeighbor(ot.nb[(k+1)%3], t, u);
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::legalizePoint(std::vector<std::pair<index_t,short_t> > & stack)
+{
+    // Edges opposite to the inserted point p = v[k]
+    while ( !stack.empty() )
+    {
+        const index_t t = stack.back().first;
+        const short_t k = stack.back().second;
+        stack.pop_back();
+
+        const triangle & tr = m_tri[t];
+        const index_t u = tr.nb[k];
+        if ( -1 == u || tr.cs[k] )
+            continue;
+        const index_t q = m_tri[u].v[neighborIndex(u, t)];
+        if ( inCircle(tr.v[0], tr.v[1], tr.v[2], q) > 0 )
+        {
+            flip(t, k);
+            stack.push_back( std::make_pair(t, 0) );
+            stack.push_back( std::make_pair(u, 2) );
+        }
+    }
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::legalizeEdges(std::vector<edge> & stack)
+{
+    index_t t;
+    short_t k;
+    while ( !stack.empty() )
+    {
+        const edge e = stack.back();
+        stack.pop_back();
+        if ( !findEdge(e.first, e.second, t, k) )
+            continue;
+
+        const triangle & tr = m_tri[t];
+        const index_t u = tr.nb[k];
+        if ( -1 == u || tr.cs[k] )
+            continue;
+        const index_t q = m_tri[u].v[neighborIndex(u, t)];
+        if ( inCircle(tr.v[0], tr.v[1], tr.v[2], q) > 0 )
+        {
+            const index_t p = tr.v[k], a = tr.v[(k+1)%3], b = tr.v[(k+2)%3];
+            flip(t, k);
+            stack.push_back( edge(a, q) );
+            stack.push_back( edge(p, a) );
+            stack.push_back( edge(b, p) );
+            stack.push_back( edge(q, b) );
+        }
+    }
+}
+
+template<class T>
+bool gsConstrainedDelaunay<T>::findEdge(index_t x, index_t y, index_t & t, short_t & k) const
+{
+    // Turn around x
+    const index_t start = m_vt[x];
+    t = start;
+    do
+    {
+        const triangle & tr = m_tri[t];
+        const short_t i = position(t, x);
+        if ( tr.v[(i+1)%3] == y )
+        {
+            k = (i+2)%3;
+            return true;
+        }
+        if ( tr.v[(i+2)%3] == y )
+        {
+            k = (i+1)%3;
+            return true;
+        }
+        t = tr.nb[(i+1)%3];
+    }
+    while ( t != start && -1 != t );
+    return false;
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::setConstrained(index_t t, short_t k)
+{
+    m_tri[t].cs[k] = true;
+    const index_t u = m_tri[t].nb[k];
+    if ( -1 != u )
+        m_tri[u].cs[neighborIndex(u, t)] = true;
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::insertSegment(index_t a, index_t b)
+{
+    if ( a == b )
+        return;
+
+    index_t t;
+    short_t k;
+    if ( findEdge(a, b, t, k) )
+    {
+        setConstrained(t, k);
+        return;
+    }
+
+    // 1. Find the triangle around a which is crossed by the segment
+    index_t v1 = -1, v2 = -1;
+    const T * pa = &m_coords[2*a], * pb = &m_coords[2*b];
+    const index_t start = m_vt[a];
+    t = start;
+    bool found = false;
+    do
+    {
+        const triangle & tr = m_tri[t];
+        const short_t i = position(t, a);
+        v1 = tr.v[(i+1)%3];
+        v2 = tr.v[(i+2)%3];
+        const T o1 = orient(a, b, v1), o2 = orient(a, b, v2);
+        for (short_t s = 0; s != 2; ++s)
+        {
+            // A vertex on the segment splits it in two
+            const index_t w = s ? v2 : v1;
+            const T * pw = &m_coords[2*w];
+            if ( 0 == (s ? o2 : o1) &&
+                 (pw[0]-pa[0])*(pb[0]-pa[0]) + (pw[1]-pa[1])*(pb[1]-pa[1]) > 0 )
+            {
+                insertSegment(a, w);
+                insertSegment(w, b);
+                return;
+            }
+        }
+        if ( o1 < 0 && o2 > 0 )
+        {
+            found = true;
+            break;
+        }
+        t = tr.nb[(i+1)%3];
+    }
+    while ( t != start && -1 != t );
+    GISMO_ENSURE(found, "gsConstrainedDelaunay: segment not found around its vertex.");
+
+    // 2. Walk along the segment and collect the crossed edges
+    std::deque<edge> crossing;
+    index_t end = b;
+    index_t cur = t;                         // triangle before the crossed edge
+    for (;;)
+    {
+        short_t e;                           // crossed edge (v1,v2) in cur
+        for (e = 0; e != 3; ++e)
+            if ( m_tri[cur].v[e] != v1 && m_tri[cur].v[e] != v2 )
+                break;
+        crossing.push_back( edge(v1, v2) );
+        const index_t next = m_tri[cur].nb[e];
+        const index_t w = m_tri[next].v[neighborIndex(next, cur)];
+        if ( w == b )
+            break;
+        const T o = orient(a, b, w);
+        if ( 0 == o ) // w lies on the segment
+        {
+            end = w;
+            break;
+        }
+        if ( o < 0 )
+            v1 = w;
+        else
+            v2 = w;
+        cur = next;
+    }
+
+    // 3. Remove the crossings by flipping (Sloan)
+    std::vector<edge> created;
+    const size_t maxIter = 100 * crossing.size() + 100;
+    for (size_t it = 0; !crossing.empty(); ++it)
+    {
+        if ( it > maxIter )
+        {
+            gsWarn<<"gsConstrainedDelaunay: could not recover a segment.\n";
+            return;
+        }
+        const edge ed = crossing.front();
+        crossing.pop_front();
+        if ( !findEdge(ed.first, ed.second, t, k) )
+            continue;
+
+        const triangle & tr = m_tri[t];
+        const index_t u = tr.nb[k];
+        const index_t p = tr.v[k], x = tr.v[(k+1)%3], y = tr.v[(k+2)%3];
+        const index_t q = m_tri[u].v[neighborIndex(u, t)];
+
+        // Convex quadrilateral?
+        if ( !(orient(p, q, x) < 0 && orient(p, q, y) > 0) )
+        {
+            crossing.push_back(ed);
+            continue;
+        }
+
+        flip(t, k);
+        const T op = orient(a, end, p), oq = orient(a, end, q);
+        if ( p != a && p != end && q != a && q != end && op * oq < 0 )
+            crossing.push_back( edge(p, q) );
+        else
+            created.push_back( edge(p, q) );
+    }
+
+    // 4. Mark the segment and restore the Delaunay property
+    if ( findEdge(a, end, t, k) )
+        setConstrained(t, k);
+    legalizeEdges(created);
+
+    if ( end != b )
+        insertSegment(end, b);
+}
+
+template<class T>
+void gsConstrainedDelaunay<T>::classify(std::vector<bool> & inside) const
+{
+    // Flood fill starting outside (at the super-triangle), the depth
+    // increases by one when a constrained edge is crossed
+    const index_t nt = m_tri.size();
+    std::vector<index_t> depth(nt, -1);
+    std::vector<index_t> front(1, m_vt[numPoints()-1]), next;
+    depth[front[0]] = 0;
+
+    for (index_t level = 0; !front.empty(); ++level)
+    {
+        while ( !front.empty() )
+        {
+            const index_t t = front.back();
+            front.pop_back();
+            for (short_t k = 0; k != 3; ++k)
+            {
+                const index_t u = m_tri[t].nb[k];
+                if ( -1 == u || -1 != depth[u] )
+                    continue;
+                if ( m_tri[t].cs[k] )
+                    next.push_back(u);
+                else
+                {
+                    depth[u] = level;
+                    front.push_back(u);
+                }
+            }
+        }
+        for (size_t i = 0; i != next.size(); ++i)
+            if ( -1 == depth[next[i]] )
+            {
+                depth[next[i]] = level + 1;
+                front.push_back(next[i]);
+            }
+        next.clear();
+    }
+
+    inside.resize(nt);
+    for (index_t t = 0; t != nt; ++t)
+        inside[t] = (1 == depth[t] % 2);
+}
+
+template<class T>
+typename gsMesh<T>::uPtr gsConstrainedDelaunay<T>::toMesh() const
+{
+    typename gsMesh<T>::uPtr mesh(new gsMesh<T>());
+    std::vector<index_t> id(numPoints(), -1);
+    index_t nv = 0;
+    for (size_t i = 0; i != m_result.size(); ++i)
+        if ( -1 == id[m_result[i]] )
+        {
+            const index_t p = m_result[i];
+            mesh->addVertex(m_coords[2*p], m_coords[2*p+1]);
+            id[p] = nv++;
+        }
+
+    for (size_t i = 0; i != m_result.size(); i += 3)
+        mesh->addFace(id[m_result[i]], id[m_result[i+1]], id[m_result[i+2]]);
+    return mesh;
+}
+
+} // namespace gismo
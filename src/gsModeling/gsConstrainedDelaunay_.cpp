@@ -0,0 +1,11 @@
+#include <gsCore/gsTemplateTools.h>
+
+#include <gsModeling/gsConstrainedDelaunay.h>
+#include <gsModeling/gsConstrainedDelaunay.hpp>
+
+namespace gismo
+{
+
+CLASS_TEMPLATE_INST gsConstrainedDelaunay<real_t> ;
+
+}
@@ -47,6 +47,9 @@ public:
     gsCoonsPatch(const gsMultiPatch<T> & boundary) : Base(boundary)
     { }
 
+    /// Empty constructor, the boundaries are given to compute(boundary)
+    gsCoonsPatch() { }
+
 public:
 
     // Look at gsPatchGenerator
@@ -42,6 +42,9 @@ public:
     gsCrossApPatch(const gsMultiPatch<T> & boundary): Base(boundary)
     { }
 
+    /// Empty constructor, the boundaries are given to compute(boundary)
+    gsCrossApPatch() { }
+
 public:
 
     /// \brief Main routine that performs the computation
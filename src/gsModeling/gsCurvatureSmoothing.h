@@ -118,13 +118,29 @@ private:
     gsMatrix<T> m_param_values;
     /// the points of the original point cloud
     gsMatrix<T> m_points;
+    /// the basis values and derivatives at the parameter values, and the active functions
+    std::vector<gsMatrix<T> > m_basisDers;
+    gsMatrix<index_t> m_actives;
 
     /// computes all values and derivatives (up to three) at the parameter values u for the given coefs
     void compute_AllValues(gsBSplineBasis<T> * basis, gsMatrix<T> u, gsMatrix<T> *coefs, gsMatrix<T> & values0, gsMatrix<T> & values1, gsMatrix<T> & values2, gsMatrix<T> & values3);
 
+    /// computes the values and derivatives (up to three) of the basis at the parameter values, used by compute_Gradient
+    void compute_BasisValues(gsBSplineBasis<T> * basis);
+
+    /// computes the gradient of the objective function (see compute_ObjectiveFunction) w.r.t. the free coefficients of the closed curve
+    /// (gradient has to be initialized with the number of free coefficients as rows)
+    void compute_Gradient(const gsMatrix<T> & coefs, const T omega1, const T omega2, gsMatrix<T> & gradient);
+
     /// computes the objective function for given coefs and omega1 and omega2 -- objective function = omega1*ApproximationFunction + omega2*CurvatureFunction
     void compute_ObjectiveFunction(gsBSplineBasis<T> * basis, gsMatrix<T> *coefs, const T omega1, const T omega2, T &value);
 
+    /// the mask of the Hadenfeld smoother for the given smoothing degree (2, 3 or 4)
+    static void compute_HadenfeldMask(const unsigned smooth_degree, T mask[4]);
+
+    /// applies the Hadenfeld mask to the neighbours of the i-th coefficient of the closed curve (without the equal last coefficients)
+    static void compute_SmoothedCoef(const gsMatrix<T> & coefs, const T mask[4], const index_t i, T & value0, T & value1);
+
     /// set the smooth curve to the the original curve
     // TODO: What is exactly the purpose of this function; why do we want to change output?
     void reset(gsBSpline<T> * newCurve)
@@ -20,6 +20,8 @@
 
 #include <gsModeling/gsCurvatureSmoothing.h>
 
+#include <set>
+
 namespace gismo
 {
 
@@ -36,26 +38,17 @@ void gsCurvatureSmoothing<T>::smoothTotalVariation(const T omega1, const T omega
     index_t num_rows=current_coefs.rows()-m_degree; //number of rows of the coefficients
     index_t num_cols=current_coefs.cols();  // number of columns of the coefficients
 
-    gsMatrix<T> deriv_coefs1; //needed later for numerical differentiation to construct the gradient (upper value)
-    gsMatrix<T> deriv_coefs2; //needed later for numerical differentiation to construct the gradient (lower value)
-
     gsMatrix<T> m_gradient(num_rows,num_cols); // the gradient in each step be aware that we have a closed curve that means the first coefficients are equal to the last one
 
 
-    gsMatrix<T> deriv_coefs3; //needed later for numerical differentiation to construct the gradient (upper value) in the lamda*gradient direction (for the backtracking line search method)
-    gsMatrix<T> deriv_coefs4; //needed later for numerical differentiation to construct the gradient (lower value) in the lamda*gradient direction (for the backtracking line search method)
-
     gsMatrix<T> m_gradient2(num_rows,num_cols); // the gradient in the lamda*gradient direction (for line search method)
 
-    T delta=0.0000001; // for numerical differentiation
-
     // the needed basis -- needed for constructing the derivatives
     gsBSplineBasis<T> * basis = new gsBSplineBasis<T>(m_knots);
+    compute_BasisValues(basis);
 
     //needed for computing the objective value and the derivatives
     T m_value0=0;
-    T m_value1=0;
-    T m_value2=0;
 
     // for the iteration step for the different lamdas later
     T lamda_value;
@@ -75,28 +68,8 @@ void gsCurvatureSmoothing<T>::smoothTotalVariation(const T omega1, const T omega
 
     for(unsigned i=0;i<iter;i++){
         // gradient descent method
-        //computes the gradient with the help of numerical differentiation (2 point formula)
-        for(index_t j=0;j<num_rows;j++){
-            for(index_t k=0;k<num_cols;k++){
-                deriv_coefs1 = current_coefs;
-                deriv_coefs1(j,k)+=delta;
-                deriv_coefs2 = current_coefs;
-                deriv_coefs2(j,k)-=delta;
-
-                //because of closed curve -- some first and last are equal
-                if(j<m_degree){
-                    deriv_coefs1(j+num_rows,k)+=delta;
-                    deriv_coefs2(j+num_rows,k)-=delta;
-                }
-
-                // compute the objective function for numerical differentiation by means of the 2 point formula
-                compute_ObjectiveFunction(basis,&deriv_coefs1,omega1,omega2,m_value1);
-                compute_ObjectiveFunction(basis,&deriv_coefs2,omega1,omega2,m_value2);
-
-                //initialize the gradient
-                m_gradient(j,k)=(m_value1-m_value2)/(2*delta);
-            }
-        }
+        //computes the gradient analytically, using the basis values at the parameters
+        compute_Gradient(current_coefs,omega1,omega2,m_gradient);
 
 
         // we have to find the right lamda --> with line searching method!!
@@ -119,28 +92,7 @@ void gsCurvatureSmoothing<T>::smoothTotalVariation(const T omega1, const T omega
             compute_ObjectiveFunction(basis,&different_coefs,omega1,omega2,lamda_value);
 
             /* second step computing the gradient in the lamda*gradient direction */
-            //computes the gradient in the lamda*gradient direction with the help of numerical differentiation (2 point formula)
-            for(index_t j=0;j<num_rows;j++){
-                for(index_t k=0;k<num_cols;k++){
-                    deriv_coefs3 = different_coefs;
-                    deriv_coefs3(j,k)+=delta;
-                    deriv_coefs4 = different_coefs;
-                    deriv_coefs4(j,k)-=delta;
-
-                    //because of closed curve -- some first and last are equal
-                    if(j<m_degree){
-                        deriv_coefs3(j+num_rows,k)+=delta;
-                        deriv_coefs4(j+num_rows,k)-=delta;
-                    }
-
-                    // compute the objective function for numerical differentiation by means of the 2 point formula
-                    compute_ObjectiveFunction(basis,&deriv_coefs3,omega1,omega2,m_value1);
-                    compute_ObjectiveFunction(basis,&deriv_coefs4,omega1,omega2,m_value2);
-
-                    //initialize the gradient
-                    m_gradient2(j,k)=(m_value1-m_value2)/(2*delta);
-                }
-            }
+            compute_Gradient(different_coefs,omega1,omega2,m_gradient2);
 
             /* third step initialising the different sides of the Armijio-Goldstein (Wolfe) conditions */
             cond11=lamda_value;
@@ -212,20 +164,14 @@ void gsCurvatureSmoothing<T>::smoothTotalVariationSelectLamda(const T omega1, co
     index_t num_rows=current_coefs.rows()-m_degree; //number of rows of the coefficients
     index_t num_cols=current_coefs.cols();  // number of columns of the coefficients
 
-    gsMatrix<T> deriv_coefs1; //needed later for numerical differentiation to construct the gradient (upper value)
-    gsMatrix<T> deriv_coefs2; //needed later for numerical differentiation to construct the gradient (lower value)
-
     gsMatrix<T> m_gradient(num_rows,num_cols); // the gradient in each step be aware that we have a closed curve that means the first coefficients are equal to the last one
 
-    T delta=0.0000001; // for numerical differentiation
-
     // the needed basis -- needed for constructing the derivatives
     gsBSplineBasis<T> * basis = new gsBSplineBasis<T>(m_knots);
+    compute_BasisValues(basis);
 
 
     T m_value0=0;
-    T m_value1=0;
-    T m_value2=0;
 
     // for the iteration step for the different lamdas later
     T lamda_value;
@@ -238,28 +184,8 @@ void gsCurvatureSmoothing<T>::smoothTotalVariationSelectLamda(const T omega1, co
 
     for(unsigned i=0;i<iter;i++){
         // gradient descent method
-        //computes the gradient with the help of numerical differentiation (2 point formula)
-        for(index_t j=0;j<num_rows;j++){
-            for(index_t k=0;k<num_cols;k++){
-                deriv_coefs1 = current_coefs;
-                deriv_coefs1(j,k)+=delta;
-                deriv_coefs2 = current_coefs;
-                deriv_coefs2(j,k)-=delta;
-
-                //because of closed curve -- some first and last are equal
-                if(j<m_degree){
-                    deriv_coefs1(j+num_rows,k)+=delta;
-                    deriv_coefs2(j+num_rows,k)-=delta;
-                }
-
-                // compute the objective function for numerical differentiation by means of the 2 point formula
-                compute_ObjectiveFunction(basis,&deriv_coefs1,omega1,omega2,m_value1);
-                compute_ObjectiveFunction(basis,&deriv_coefs2,omega1,omega2,m_value2);
-
-                //initialize the gradient
-                m_gradient(j,k)=(m_value1-m_value2)/(2*delta);
-            }
-        }
+        //computes the gradient analytically, using the basis values at the parameters
+        compute_Gradient(current_coefs,omega1,omega2,m_gradient);
 
         //iteration steps for different lamdas
         //we have first to break down to non-multiple coefficients and then the iteration step and then again generate the multiple coefficients
@@ -320,20 +246,14 @@ void gsCurvatureSmoothing<T>::smoothTotalVariationSelectLamda(const T omega1, co
     index_t num_rows=current_coefs.rows()-m_degree; //number of rows of the coefficients
     index_t num_cols=current_coefs.cols();  // number of columns of the coefficients
 
-    gsMatrix<T> deriv_coefs1; //needed later for numerical differentiation to construct the gradient (upper value)
-    gsMatrix<T> deriv_coefs2; //needed later for numerical differentiation to construct the gradient (lower value)
-
     gsMatrix<T> m_gradient(num_rows,num_cols); // the gradient in each step be aware that we have a closed curve that means the first coefficients are equal to the last one
 
-    T delta=0.0000001; // for numerical differentiation
-
     // the needed basis -- needed for constructing the derivatives
     gsBSplineBasis<T> * basis = new gsBSplineBasis<T>(m_knots);
+    compute_BasisValues(basis);
 
 
     T m_value0=0;
-    T m_value1=0;
-    T m_value2=0;
 
     // the objective function for the current coefficients
     // here computed for the first iteration step - for the next steps it will be computed already in the end of the loop
@@ -341,28 +261,8 @@ void gsCurvatureSmoothing<T>::smoothTotalVariationSelectLamda(const T omega1, co
 
     for(unsigned i=0;i<iter;i++){
         // gradient descent method
-        //computes the gradient with the help of numerical differentiation (2 point formula)
-        for(index_t j=0;j<num_rows;j++){
-            for(index_t k=0;k<num_cols;k++){
-                deriv_coefs1 = current_coefs;
-                deriv_coefs1(j,k)+=delta;
-                deriv_coefs2 = current_coefs;
-                deriv_coefs2(j,k)-=delta;
-
-                //because of closed curve -- some first and last are equal
-                if(j<m_degree){
-                    deriv_coefs1(j+num_rows,k)+=delta;
-                    deriv_coefs2(j+num_rows,k)-=delta;
-                }
-
-                // compute the objective function for numerical differentiation by means of the 2 point formula
-                compute_ObjectiveFunction(basis,&deriv_coefs1,omega1,omega2,m_value1);
-                compute_ObjectiveFunction(basis,&deriv_coefs2,omega1,omega2,m_value2);
-
-                //initialize the gradient
-                m_gradient(j,k)=(m_value1-m_value2)/(2*delta);
-            }
-        }
+        //computes the gradient analytically, using the basis values at the parameters
+        compute_Gradient(current_coefs,omega1,omega2,m_gradient);
         //iteration step for a given lamda
         //we have first to break down to non-multiple coefficients and then the iteration step and then again generate the multiple coefficients
         current_coefs.conservativeResize(num_rows,num_cols);
@@ -412,63 +312,39 @@ void gsCurvatureSmoothing<T>::smoothHadenfeld(const unsigned smooth_degree, cons
     gsVector<index_t> m_iterated(num_rows);
     m_iterated.setZero();
 
-    T max_value,coef0,coef1,current0,current1,dist_value,m_smooth1,m_smooth2,m_smooth3,m_smooth4;
+    T max_value,coef0,coef1;
     index_t index=0;
 
     // the degree of smoothing inplies the smoother (i.e. the mask for smoothing)
-    if(smooth_degree==2){
-        m_smooth1=(43.0/95.0);
-        m_smooth2=(16.0/95.0);
-        m_smooth3=-(11.0/95.0);
-        m_smooth4=-(1.0/190.0);
-    }
-    else if (smooth_degree==4){
-        m_smooth1=(4.0/5.0);
-        m_smooth2=-(2.0/5.0);
-        m_smooth3=(4.0/35.0);
-        m_smooth4=-(1.0/70.0);
+    T m_mask[4];
+    compute_HadenfeldMask(smooth_degree,m_mask);
+
+    // the smoothed coefficients and their distances to the current ones. Changing one
+    // coefficient only affects the smoothed coefficients of its neighbours, therefore
+    // they are kept in a queue (largest distance first, then smallest index) and updated locally
+    gsMatrix<T> m_current(num_rows,2);
+    gsVector<T> m_dist(num_rows);
+    std::set<std::pair<T,index_t> > m_queue;
+
+#   pragma omp parallel for
+    for(index_t i=0;i<num_rows;i++){
+        compute_SmoothedCoef(m_coefs,m_mask,i,m_current(i,0),m_current(i,1));
+        m_dist(i)=(m_current.row(i)-m_coefs.row(i)).norm();
     }
-    else { // smooth degree 3 -- default smooth degree
-        m_smooth1=(17.0/25.0);
-        m_smooth2=-(4.0/25.0);
-        m_smooth3=-(1.0/25.0);
-        m_smooth4=(1.0/50.0);
-    }
-
+    if(iter_step>0)
+        for(index_t i=0;i<num_rows;i++)
+            m_queue.insert(std::make_pair(-m_dist(i),i));
 
     // Hadenfelds algorithm (for more detail see his PhD thesis)
-    for(index_t j=0;j<m_iter_total;j++){
-        max_value=-100;
-        coef0=0;
-        coef1=0;
-        index=0;
-
-       for(index_t i=0;i<num_rows;i++){
-            if(m_iterated(i)<iter_step){ // aks if the iter_step for one coefficient is already reached
-                // computation of the new coefficients
-                current0=m_smooth1*m_coefs((num_rows+i-1)%num_rows,0)+m_smooth1*m_coefs((i+1)%num_rows,0)+m_smooth2*m_coefs((num_rows+i-2)%num_rows,0)
-                        +m_smooth2*m_coefs((i+2)%num_rows,0)+m_smooth3*m_coefs((num_rows+i-3)%num_rows,0)+m_smooth3*m_coefs((i+3)%num_rows,0)
-                        +m_smooth4*m_coefs((num_rows+i-4)%num_rows,0)+m_smooth4*m_coefs((i+4)%num_rows,0);
-                current1=m_smooth1*m_coefs((num_rows+i-1)%num_rows,1)+m_smooth1*m_coefs((i+1)%num_rows,1)+m_smooth2*m_coefs((num_rows+i-2)%num_rows,1)
-                        +m_smooth2*m_coefs((i+2)%num_rows,1)+m_smooth3*m_coefs((num_rows+i-3)%num_rows,1)+m_smooth3*m_coefs((i+3)%num_rows,1)
-                        +m_smooth4*m_coefs((num_rows+i-4)%num_rows,1)+m_smooth4*m_coefs((i+4)%num_rows,1);
-
-                // the distance of the new cofficient compared to the older one from last step
-                dist_value=sqrt((current0-m_coefs(i,0))*(current0-m_coefs(i,0))+(current1-m_coefs(i,1))*(current1-m_coefs(i,1)));
-                // for this setting the distance is the largest until now => change values
-                if(dist_value>max_value){
-                    coef0=current0;
-                    coef1=current1;
-                    index=i;
-                    max_value=dist_value;
-                }
+    for(index_t j=0;j<m_iter_total && !m_queue.empty();j++){
+        index=m_queue.begin()->second;
+        coef0=m_current(index,0);
+        coef1=m_current(index,1);
 
-            }
-        }
        // for the coefficient index the iterator will be increased by one
        m_iterated(index)++;
        // computes locally the new coefficient depending on how large the distance has been -< checks if the new values are not too far away from the original curve
-       max_value=sqrt((coef0-m_coefs_original(index,0))*(coef0-m_coefs_original(index,0))+(coef1-m_coefs_original(index,1))*(coef1-m_coefs_original(index,1)));
+       max_value=math::sqrt((coef0-m_coefs_original(index,0))*(coef0-m_coefs_original(index,0))+(coef1-m_coefs_original(index,1))*(coef1-m_coefs_original(index,1)));
        if(max_value>delta){
            m_coefs(index,0)= m_coefs_original(index,0)+(delta/max_value)*(coef0-m_coefs_original(index,0));
            m_coefs(index,1)= m_coefs_original(index,1)+(delta/max_value)*(coef1-m_coefs_original(index,1));
@@ -478,6 +354,19 @@ void gsCurvatureSmoothing<T>::smoothHadenfeld(const unsigned smooth_degree, cons
            m_coefs(index,0)=coef0;
            m_coefs(index,1)=coef1;
        }
+
+       // update the smoothed coefficients in the support of the mask around index
+       const index_t first = (num_rows>9 ? index-4 : 0);
+       const index_t last  = (num_rows>9 ? index+4 : num_rows-1);
+       for(index_t l=first;l<=last;l++){
+           const index_t i=(num_rows+l)%num_rows;
+           m_queue.erase(std::make_pair(-m_dist(i),i));
+           if(m_iterated(i)<iter_step){ // aks if the iter_step for one coefficient is already reached
+               compute_SmoothedCoef(m_coefs,m_mask,i,m_current(i,0),m_current(i,1));
+               m_dist(i)=(m_current.row(i)-m_coefs.row(i)).norm();
+               m_queue.insert(std::make_pair(-m_dist(i),i));
+           }
+       }
     }
 
    // coefficient for the closed curve again
@@ -503,46 +392,18 @@ void gsCurvatureSmoothing<T>::smoothAllHadenfeld(const unsigned smooth_degree, c
     gsMatrix<T> m_coefs=m_curve_smooth->coefs(); // get the coefficients
     index_t num_rows=m_coefs.rows()-m_degree; // the last for coefficients are equal
     m_coefs.conservativeResize(num_rows,2); // the coefficients without the last equal points
-    gsMatrix<T> m_A(num_rows,num_rows);
-    m_A.setZero(); // ensure that all entries are zero in the beginning
-
-
-    T m_smooth1, m_smooth2, m_smooth3, m_smooth4;
-    // the degree of smoothing inplies the smoother (i.e. the matrix for smoothing)
-    if(smooth_degree==2){
-        m_smooth1=(43.0/95.0);
-        m_smooth2=(16.0/95.0);
-        m_smooth3=-(11.0/95.0);
-        m_smooth4=-(1.0/190.0);
-    }
-    else if(smooth_degree==4){
-        m_smooth1=(4.0/5.0);
-        m_smooth2=-(2.0/5.0);
-        m_smooth3=(4.0/35.0);
-        m_smooth4=-(1.0/70.0);
-    }
-    else {  // smooth degree 3 -- also default smooth degree
-        m_smooth1=(17.0/25.0);
-        m_smooth2=-(4.0/25.0);
-        m_smooth3=-(1.0/25.0);
-        m_smooth4=(1.0/50.0);
-    }
+    gsMatrix<T> m_next(num_rows,2);
 
-    // set the smoothing matrix
-    for (index_t i=0;i<num_rows;i++){
-        m_A(i,(num_rows+i-1)%num_rows)=m_smooth1;
-        m_A(i,(i+1)%num_rows)=m_smooth1;
-        m_A(i,(num_rows+i-2)%num_rows)=m_smooth2;
-        m_A(i,(i+2)%num_rows)=m_smooth2;
-        m_A(i,(num_rows+i-3)%num_rows)=m_smooth3;
-        m_A(i,(i+3)%num_rows)=m_smooth3;
-        m_A(i,(num_rows+i-4)%num_rows)=m_smooth4;
-        m_A(i,(i+4)%num_rows)=m_smooth4;
-    }
+    // the degree of smoothing inplies the smoother (i.e. the mask for smoothing)
+    T m_mask[4];
+    compute_HadenfeldMask(smooth_degree,m_mask);
 
-    // smoothing
+    // smoothing -- all coefficients at once, the mask is applied row by row
     for(unsigned k=0;k<iter;k++){
-        m_coefs=m_A*m_coefs;
+#       pragma omp parallel for
+        for(index_t i=0;i<num_rows;i++)
+            compute_SmoothedCoef(m_coefs,m_mask,i,m_next(i,0),m_next(i,1));
+        m_coefs.swap(m_next);
     }
 
 
@@ -561,6 +422,42 @@ void gsCurvatureSmoothing<T>::smoothAllHadenfeld(const unsigned smooth_degree, c
 
 }
 
+template<class T>
+void gsCurvatureSmoothing<T>::compute_HadenfeldMask(const unsigned smooth_degree, T mask[4])
+{
+    if(smooth_degree==2){
+        mask[0]=(43.0/95.0);
+        mask[1]=(16.0/95.0);
+        mask[2]=-(11.0/95.0);
+        mask[3]=-(1.0/190.0);
+    }
+    else if(smooth_degree==4){
+        mask[0]=(4.0/5.0);
+        mask[1]=-(2.0/5.0);
+        mask[2]=(4.0/35.0);
+        mask[3]=-(1.0/70.0);
+    }
+    else {  // smooth degree 3 -- also default smooth degree
+        mask[0]=(17.0/25.0);
+        mask[1]=-(4.0/25.0);
+        mask[2]=-(1.0/25.0);
+        mask[3]=(1.0/50.0);
+    }
+}
+
+template<class T>
+void gsCurvatureSmoothing<T>::compute_SmoothedCoef(const gsMatrix<T> & coefs, const T mask[4], const index_t i, T & value0, T & value1)
+{
+    const index_t n=coefs.rows();
+    value0=0;
+    value1=0;
+    for(index_t l=1;l<=4;l++){
+        const index_t im=((i-l)%n+n)%n;
+        const index_t ip=(i+l)%n;
+        value0+=mask[l-1]*coefs(im,0)+mask[l-1]*coefs(ip,0);
+        value1+=mask[l-1]*coefs(im,1)+mask[l-1]*coefs(ip,1);
+    }
+}
 template< class T>
 void gsCurvatureSmoothing<T>::write(std::ostream &os)
 {
@@ -682,6 +579,83 @@ void gsCurvatureSmoothing<T>::compute_AllValues(gsBSplineBasis<T> * basis, gsMat
 }
 
 
+template<class T>
+void gsCurvatureSmoothing<T>::compute_BasisValues(gsBSplineBasis<T> * basis)
+{
+    const gsMatrix<T> u = m_param_values.transpose();
+    basis->evalAllDers_into(u,3,m_basisDers);
+    basis->active_into(u,m_actives);
+}
+
+
+template<class T>
+void gsCurvatureSmoothing<T>::compute_Gradient(const gsMatrix<T> & coefs, const T omega1, const T omega2, gsMatrix<T> & gradient)
+{
+    // uses the basis values of compute_BasisValues; the derivatives of
+    // the objective with respect to the curve values at each parameter
+    // are computed first, and then distributed to the (degree+1) active
+    // coefficients, which makes the gradient linear in the number of
+    // parameters
+    const index_t npts=m_param_values.rows();
+    const index_t num=m_actives.rows();
+    const T w2=omega2/(0.0+npts);
+
+    // derivatives of the objective w.r.t. the values and the first three derivatives of the curve (x and y component)
+    gsMatrix<T> m_dvalues(8,npts);
+
+#   pragma omp parallel for
+    for(index_t i=0;i<npts;i++){
+        T v[8]={0,0,0,0,0,0,0,0};
+        for(index_t k=0;k<num;k++){
+            const index_t a=m_actives(k,i);
+            for(index_t d=0;d<4;d++){
+                v[2*d]  +=coefs(a,0)*m_basisDers[d](k,i);
+                v[2*d+1]+=coefs(a,1)*m_basisDers[d](k,i);
+            }
+        }
+        const T x1=v[2], y1=v[3], x2=v[4], y2=v[5], x3=v[6], y3=v[7];
+
+        // approximation term
+        m_dvalues(0,i)=omega1*2*(v[0]-m_points(i,0));
+        m_dvalues(1,i)=omega1*2*(v[1]-m_points(i,1));
+
+        // curvature term |g|/(2 s^{2.5}), see compute_ObjectiveFunction
+        const T s=x1*x1+y1*y1;
+        const T A=y1*x2-x1*y2;
+        const T B=x1*x2+y1*y2;
+        const T C=x1*y3-y1*x3;
+        const T g=6.0*A*B+2*s*C;
+        const T sg=(g<0 ? -1 : 1)*w2/(2*math::pow(s,(T)2.5));
+        const T ds=-w2*1.25*math::abs(g)/math::pow(s,(T)3.5);
+
+        m_dvalues(2,i)=sg*(6.0*(A*x2-B*y2)+2*(2*x1*C+s*y3))+ds*2*x1;
+        m_dvalues(3,i)=sg*(6.0*(A*y2+B*x2)+2*(2*y1*C-s*x3))+ds*2*y1;
+        m_dvalues(4,i)=sg*6.0*(A*x1+B*y1);
+        m_dvalues(5,i)=sg*6.0*(A*y1-B*x1);
+        m_dvalues(6,i)=-sg*2*s*y1;
+        m_dvalues(7,i)= sg*2*s*x1;
+    }
+
+    // distribute to the coefficients
+    const index_t num_rows=gradient.rows();
+    gsMatrix<T> m_full(coefs.rows(),2);
+    m_full.setZero();
+    for(index_t i=0;i<npts;i++)
+        for(index_t k=0;k<num;k++){
+            const index_t a=m_actives(k,i);
+            for(index_t d=0;d<4;d++){
+                m_full(a,0)+=m_dvalues(2*d,i)*m_basisDers[d](k,i);
+                m_full(a,1)+=m_dvalues(2*d+1,i)*m_basisDers[d](k,i);
+            }
+        }
+
+    //because of closed curve -- the last coefficients are equal to the first ones
+    gradient=m_full.topRows(num_rows);
+    for(index_t j=num_rows;j<coefs.rows();j++)
+        gradient.row(j-num_rows)+=m_full.row(j);
+}
+
+
 template<class T>
 void gsCurvatureSmoothing<T>::compute_ObjectiveFunction(gsBSplineBasis<T> *basis, gsMatrix<T> *coefs, const T omega1, const T omega2, T & value)
 {
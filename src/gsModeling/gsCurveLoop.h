@@ -151,6 +151,13 @@ public:
     // to do: replace return type with std::multimap<int,T>
     std::vector<T> lineIntersections(int const & direction , T const & abscissa);
 
+    /// Computes the intersections with the axis-aligned lines with
+    /// constant values \a abscissae in \a direction; the i-th entry
+    /// of the result holds the intersections with the line at
+    /// abscissae[i]. The lines are processed in parallel.
+    std::vector<std::vector<T> > lineIntersections(int const & direction,
+                                                   std::vector<T> const & abscissae);
+
     std::vector< gsCurve<T> *> & curves() { return m_curves; }
 
     gsCurve<T> & curve(int i)
@@ -174,6 +181,13 @@ public:
     /// Sample \a npoints uniformly distributed (in parameter domain) points on the loop
     gsMatrix<T> sample(int npoints = 50, int numEndPoints=2) const;
 
+    /// Samples the loop adaptively: the segments between consecutive
+    /// samples are at most \a maxLength long and deviate at most
+    /// (approximately) \a tol from the curves, so that more points are
+    /// placed where the curvature is high. The last point of every
+    /// curve (the first of the next one) is not repeated.
+    gsMatrix<T> adaptiveSample(T maxLength, T tol) const;
+
     gsMatrix<T> getBoundingBox();
 
     /// Computes the corners of a polygon that matches the specified angles and
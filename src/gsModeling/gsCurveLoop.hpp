@@ -17,6 +17,7 @@
 # include <gsNurbs/gsKnotVector.h>
 # include <gsNurbs/gsBSpline.h>
 # include <gsNurbs/gsBSplineSolver.h>
+# include <gsUtils/gsPointGrid.h>
 # include <gsModeling/gsModelingUtils.hpp>
 
 namespace gismo
@@ -207,6 +208,25 @@ std::vector<T> gsCurveLoop<T>::lineIntersections(int const & direction , T const
     return std::vector<T>();
 }
 
+template <class T>
+std::vector<std::vector<T> >
+gsCurveLoop<T>::lineIntersections(int const & direction, std::vector<T> const & abscissae)
+{
+    // For now only Curve loops with ONE curve are supported
+    gsBSplineSolver<T> slv;
+    typename gsBSpline<T>::uPtr c = memory::convert_ptr<gsBSpline<T> >(singleCurve());
+
+    std::vector<std::vector<T> > result;
+    if ( c )
+    {
+        slv.allRoots(*c, result, direction, abscissae);
+        return result;
+    }
+    gsWarn<<"Could not get intersection for this type of curve!\n";
+    result.resize(abscissae.size());
+    return result;
+}
+
 template <class T>
 gsMatrix<T> gsCurveLoop<T>::sample(int npoints, int numEndPoints) const
 {
@@ -252,6 +272,54 @@ gsMatrix<T> gsCurveLoop<T>::sample(int npoints, int numEndPoints) const
     return u;
 }
   
+template <class T>
+gsMatrix<T> gsCurveLoop<T>::adaptiveSample(T maxLength, T tol) const
+{
+    std::vector<T> result;
+    gsMatrix<T> u, x, um, xm, nu, nx;
+    for ( typename std::vector< gsCurve<T> *>::const_iterator it = m_curves.begin();
+          it != m_curves.end(); ++it )
+    {
+        const gsMatrix<T> range = (*it)->parameterRange();
+        u = gsPointGrid<T>(range(0,0), range(0,1), 9);
+        (*it)->eval_into(u, x);
+
+        // Bisect the parameter intervals which are too long or too curved
+        for (index_t level = 0; level != 20; ++level)
+        {
+            const index_t n = u.cols();
+            um = ( u.leftCols(n-1) + u.rightCols(n-1) ) / 2;
+            (*it)->eval_into(um, xm);
+
+            nu.resize(1, 2*n-1);
+            nx.resize(x.rows(), 2*n-1);
+            index_t m = 0;
+            for (index_t k = 0; k != n-1; ++k)
+            {
+                nu(0,m) = u(0,k);
+                nx.col(m++) = x.col(k);
+                const T len = (x.col(k+1) - x.col(k)).norm();
+                const T dev = (xm.col(k) - (x.col(k+1) + x.col(k)) / 2).norm();
+                if ( len > maxLength || dev > tol )
+                {
+                    nu(0,m) = um(0,k);
+                    nx.col(m++) = xm.col(k);
+                }
+            }
+            nu(0,m) = u(0,n-1);
+            nx.col(m++) = x.col(n-1);
+
+            if ( m == n )
+                break;
+            u  = nu.leftCols(m);
+            x  = nx.leftCols(m);
+        }
+
+        result.insert(result.end(), x.data(), x.data() + 2 * (x.cols() - 1));
+    }
+    return gsAsMatrix<T>(result, 2, result.size() / 2);
+}
+
 template <class T>
 gsMatrix<T> gsCurveLoop<T>::getBoundingBox()
 {
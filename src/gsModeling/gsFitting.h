@@ -51,10 +51,10 @@ public:
     void compute(T lambda = 0);
 
     /// Computes the euclidean error for each point
-    void computeErrors();
+    virtual void computeErrors();
 
     /// Computes the maximum norm error for each point
-    void computeMaxNormErrors();
+    virtual void computeMaxNormErrors();
 
     /// Computes the approximation error of the fitted curve to the original point cloud
     void computeApproxError(T & error, int type = 0) const;
@@ -93,6 +93,12 @@ public:
     /// Assembles system for the least square fit.
     void assembleSystem(gsSparseMatrix<T>& A_mat, gsMatrix<T>& B);
 
+    /// Adds to the system for the least square fit the contribution
+    /// of the points (rows of) \a points, parametrized by (the
+    /// columns of) \a params.
+    void assembleSystem(const gsMatrix<T>& params, const gsMatrix<T>& points,
+                        gsSparseMatrix<T>& A_mat, gsMatrix<T>& B) const;
+
 
 public:
 
@@ -127,10 +133,26 @@ public:
     void setConstraints(const std::vector<index_t>& indices,
 			const std::vector<gsMatrix<T> >& coefs);
 
+protected:
+    /// Allocates the (empty) system for the least square fit of
+    /// points with \a dimension coordinates.
+    void initSystem(index_t dimension, gsSparseMatrix<T>& A_mat, gsMatrix<T>& B) const;
+
+    /// Applies smoothing and constraints to the assembled system,
+    /// solves it and stores the resulting geometry.
+    void solveSystem(T lambda, gsSparseMatrix<T>& A_mat, gsMatrix<T>& B);
+
 private:
     /// Extends the system of equations by taking constraints into account.
     void extendSystem(gsSparseMatrix<T>& A_mat, gsMatrix<T>& m_B);
 
+    /// Evaluates the fitted geometry at all parameter values. The
+    /// evaluation is split in contiguous blocks, one per thread.
+    void evalResult_into(gsMatrix<T> & values) const;
+
+    /// Updates m_min_error and m_max_error from m_pointErrors
+    void updateMinMaxErrors();
+
 protected:
 
     /// the parameter values of the point cloud
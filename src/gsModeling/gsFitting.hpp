@@ -18,6 +18,8 @@
 #include <gsCore/gsLinearAlgebra.h>
 #include <gsTensor/gsTensorDomainIterator.h>
 
+#include <numeric>
+
 
 namespace gismo
 {
@@ -44,16 +46,30 @@ gsFitting<T>::  gsFitting(gsMatrix<T> const & param_values,
 template<class T>
 void gsFitting<T>::compute(T lambda)
 {
-    // Wipe out previous result
-    if ( m_result )
-        delete m_result;
+    gsSparseMatrix<T> A_mat;
+    gsMatrix<T> m_B;
+
+    initSystem(m_points.cols(), A_mat, m_B);
+
+    // building the matrix A and the vector b of the system of linear
+    // equations A*x==b
+
+    assembleSystem(A_mat, m_B);
+
+    solveSystem(lambda, A_mat, m_B);
+}
 
+
+template<class T>
+void gsFitting<T>::initSystem(index_t dimension,
+                              gsSparseMatrix<T>& A_mat,
+                              gsMatrix<T>& m_B) const
+{
     const int num_basis=m_basis->size();
-    const short_t dimension=m_points.cols();
 
     //left side matrix
     //gsMatrix<T> A_mat(num_basis,num_basis);
-    gsSparseMatrix<T> A_mat(num_basis + m_constraintsLHS.rows(), num_basis + m_constraintsLHS.rows());
+    A_mat.resize(num_basis + m_constraintsLHS.rows(), num_basis + m_constraintsLHS.rows());
     //gsMatrix<T>A_mat(num_basis,num_basis);
     //To optimize sparse matrix an estimation of nonzero elements per
     //column can be given here
@@ -65,13 +81,21 @@ void gsFitting<T>::compute(T lambda)
     A_mat.reservePerColumn( nonZerosPerCol );
 
     //right side vector (more dimensional!)
-    gsMatrix<T> m_B(num_basis + m_constraintsRHS.rows(), dimension);
+    m_B.resize(num_basis + m_constraintsRHS.rows(), dimension);
     m_B.setZero(); // enusure that all entries are zero in the beginning
+}
 
-    // building the matrix A and the vector b of the system of linear
-    // equations A*x==b
 
-    assembleSystem(A_mat, m_B);
+template<class T>
+void gsFitting<T>::solveSystem(T lambda,
+                               gsSparseMatrix<T>& A_mat,
+                               gsMatrix<T>& m_B)
+{
+    // Wipe out previous result
+    if ( m_result )
+        delete m_result;
+
+    const int num_basis=m_basis->size();
 
     // --- Smoothing matrix computation
     //test degree >=3
@@ -114,7 +138,17 @@ template <class T>
 void gsFitting<T>::assembleSystem(gsSparseMatrix<T>& A_mat,
                                   gsMatrix<T>& m_B)
 {
-    const int num_points = m_points.rows();
+    assembleSystem(m_param_values, m_points, A_mat, m_B);
+}
+
+
+template <class T>
+void gsFitting<T>::assembleSystem(const gsMatrix<T>& params,
+                                  const gsMatrix<T>& points,
+                                  gsSparseMatrix<T>& A_mat,
+                                  gsMatrix<T>& m_B) const
+{
+    const int num_points = points.rows();
 
     //for computing the value of the basis function
     gsMatrix<T> value, curr_point;
@@ -122,7 +156,7 @@ void gsFitting<T>::assembleSystem(gsSparseMatrix<T>& A_mat,
 
     for(index_t k = 0; k != num_points; ++k)
     {
-        curr_point = m_param_values.col(k);
+        curr_point = params.col(k);
 
         //computing the values of the basis functions at the current point
         m_basis->eval_into(curr_point, value);
@@ -135,7 +169,7 @@ void gsFitting<T>::assembleSystem(gsSparseMatrix<T>& A_mat,
         for (index_t i = 0; i != numActive; ++i)
         {
             const index_t ii = actives.at(i);
-            m_B.row(ii) += value.at(i) * m_points.row(k);
+            m_B.row(ii) += value.at(i) * points.row(k);
             for (index_t j = 0; j != numActive; ++j)
                 A_mat(ii, actives.at(j)) += value.at(i) * value.at(j);
         }
@@ -241,47 +275,76 @@ void gsFitting<T>::applySmoothing(T lambda, gsSparseMatrix<T> & A_mat)
 }
 
 template<class T>
-void gsFitting<T>::computeErrors()
+void gsFitting<T>::evalResult_into(gsMatrix<T> & values) const
 {
-    m_pointErrors.clear();
+    const index_t num_points = m_param_values.cols();
+    values.resize(m_result->targetDim(), num_points);
 
-    gsMatrix<T> val_i;
-    //m_result->eval_into(m_param_values.col(0), val_i);
-    m_result->eval_into(m_param_values, val_i);
-    m_pointErrors.push_back( (m_points.row(0) - val_i.col(0).transpose()).norm() );
-    m_max_error = m_min_error = m_pointErrors.back();
+#pragma omp parallel
+{
+#ifdef _OPENMP
+    const index_t tid = omp_get_thread_num();
+    const index_t nt  = omp_get_num_threads();
+#else
+    const index_t tid = 0, nt = 1;
+#endif
+    // Contiguous block of points evaluated by this thread
+    const index_t chunk = (num_points + nt - 1) / nt;
+    const index_t first = math::min(num_points, tid * chunk);
+    const index_t last  = math::min(num_points, first + chunk);
+
+    if ( first != last )
+    {
+        gsMatrix<T> val_i;
+        m_result->eval_into(m_param_values.middleCols(first, last - first), val_i);
+        values.middleCols(first, last - first) = val_i;
+    }
+}//omp parallel
+}
 
-    for (index_t i = 1; i < m_points.rows(); i++)
+template<class T>
+void gsFitting<T>::updateMinMaxErrors()
+{
+    if ( m_pointErrors.empty() )
     {
-        //m_result->eval_into(m_param_values.col(i), val_i);
+        m_max_error = m_min_error = 0;
+        return;
+    }
+    m_max_error = *std::max_element(m_pointErrors.begin(), m_pointErrors.end());
+    m_min_error = *std::min_element(m_pointErrors.begin(), m_pointErrors.end());
+}
 
-        const T err = (m_points.row(i) - val_i.col(i).transpose()).norm() ;
+template<class T>
+void gsFitting<T>::computeErrors()
+{
+    gsMatrix<T> val_i;
+    evalResult_into(val_i);
 
-        m_pointErrors.push_back(err);
+    const index_t num_points = m_points.rows();
+    m_pointErrors.resize(num_points);
 
-        if ( err > m_max_error ) m_max_error = err;
-        if ( err < m_min_error ) m_min_error = err;
-    }
+#pragma omp parallel for
+    for (index_t i = 0; i < num_points; i++)
+        m_pointErrors[i] = (m_points.row(i) - val_i.col(i).transpose()).norm();
+
+    updateMinMaxErrors();
 }
 
 
 template<class T>
 void gsFitting<T>::computeMaxNormErrors()
 {
-    m_pointErrors.clear();
-
     gsMatrix<T> values;
-    m_result->eval_into(m_param_values, values);
+    evalResult_into(values);
 
-    for (index_t i = 0; i != m_points.rows(); i++)
-    {
-        const T err = (m_points.row(i) - values.col(i).transpose()).cwiseAbs().maxCoeff();
+    const index_t num_points = m_points.rows();
+    m_pointErrors.resize(num_points);
 
-        m_pointErrors.push_back(err);
+#pragma omp parallel for
+    for (index_t i = 0; i < num_points; i++)
+        m_pointErrors[i] = (m_points.row(i) - values.col(i).transpose()).cwiseAbs().maxCoeff();
 
-        if ( i == 0 || m_max_error < err ) m_max_error = err;
-        if ( i == 0 || err < m_min_error ) m_min_error = err;
-    }
+    updateMinMaxErrors();
 }
 
 
@@ -290,57 +353,52 @@ template<class T>
 void gsFitting<T>::computeApproxError(T& error, int type) const
 {
     gsMatrix<T> results;
-    m_result->eval_into(m_param_values, results);
-    error = 0;
+    evalResult_into(results);
 
     //computing the approximation error = sum_i ||x(u_i)-p_i||^2
 
-    for (index_t i = 0; i != m_points.rows(); ++i)
+    if ( type != 0 && type != 1 )
     {
-        const T err = (m_points.row(i) - results.col(i).transpose()).squaredNorm();
+        gsWarn << "Unknown type in computeApproxError(error, type)...\n";
+        error = 0;
+        return;
+    }
 
-        switch (type) {
-        case 0:
-            error += err;
-            break;
-        case 1:
-            error += sqrt(err);
-            break;
-        default:
-            gsWarn << "Unknown type in computeApproxError(error, type)...\n";
-            break;
-        }
+    const index_t num_points = m_points.rows();
+    std::vector<T> errors(num_points);
+
+#pragma omp parallel for
+    for (index_t i = 0; i < num_points; ++i)
+    {
+        const T err = (m_points.row(i) - results.col(i).transpose()).squaredNorm();
+        errors[i] = (0 == type ? err : math::sqrt(err) );
     }
+
+    // Summed in fixed order, independently of the number of threads
+    error = std::accumulate(errors.begin(), errors.end(), T(0));
 }
 
 template<class T>
 void gsFitting<T>::get_Error(std::vector<T>& errors, int type) const
 {
     errors.clear();
+    if ( type != 0 && type != 1 )
+    {
+        gsWarn << "Unknown type in get_Error(errors, type)...\n";
+        return;
+    }
+
     gsMatrix<T> results;
-    m_result->eval_into(m_param_values,results);
-    results.transposeInPlace();
+    evalResult_into(results);
 
-    for (index_t row = 0; row != m_points.rows(); row++)
-    {
-        T err = 0;
-        for (index_t col = 0; col != m_points.cols(); col++)
-        {
-            err += math::pow(m_points(row, col) - results(row, col), 2);
-        }
+    const index_t num_points = m_points.rows();
+    errors.resize(num_points);
 
-        switch (type)
-        {
-        case 0:
-            errors.push_back(err);
-            break;
-        case 1:
-            errors.push_back(sqrt(err));
-            break;
-        default:
-            gsWarn << "Unknown type in get_Error(errors, type)...\n";
-            break;
-        }
+#pragma omp parallel for
+    for (index_t row = 0; row < num_points; row++)
+    {
+        const T err = (m_points.row(row) - results.col(row).transpose()).squaredNorm();
+        errors[row] = (0 == type ? err : math::sqrt(err) );
     }
 }
 
@@ -132,6 +132,9 @@ private:
                            const size_t vertexIndex,
                            const bool innerVertex = 1);
 
+        /// Empty constructor
+        LocalNeighbourhood() : m_vertexIndex(0) { }
+
         /**
          * @brief Get vertex index
          *
@@ -221,13 +224,16 @@ private:
                              const LocalNeighbourhood &localNeighbourhood,
                              const size_t parametrizationMethod = 2);
 
+        /// Empty constructor
+        LocalParametrization() : m_vertexIndex(0) { }
+
         /**
          * @brief Get lambdas
-         * The lambdas are returned.
+         * The non-zero lambdas are returned, as pairs of the vertex index - 1 and the value, sorted by the index.
          *
          * @return lambdas
          */
-        const std::vector<T> &getLambdas() const;
+        const std::vector<std::pair<size_t, T> > &getLambdas() const;
 
     private:
         /**
@@ -239,8 +245,13 @@ private:
          */
         void calculateLambdas(const size_t N, VectorType& points);
 
+        /**
+         * @brief Sorts the lambdas by their indices and sums up the lambdas with equal indices.
+         */
+        void mergeLambdas();
+
         size_t m_vertexIndex; ///< vertex index
-        std::vector<T> m_lambdas; ///< lambdas
+        std::vector<std::pair<size_t, T> > m_lambdas; ///< non-zero lambdas (vertex index - 1, lambda)
 
     };
 
@@ -260,6 +271,7 @@ private:
      *
      * An object is constructed from a gsHalfEdgeMesh object and the desired parametrization method, that can be chosen from 'uniform', 'shape' and 'distance'.
      * Basically the construction is just about constructing the MeshInfo object, the vector of localParametrization objects and the vector of LocalNeighbourhood objects.
+     * These are computed in parallel, if OpenMP is enabled.
      *
      * There are getter functions for all information that is needed to formulate the equation system. E. g. one can get the number of vertices, number of inner vertices, boundary length, number of boundary halfedges, halfedge lengths and lambdas.
      * Furthermore there are functions to find the boundary corner points according to the method.
@@ -290,11 +302,12 @@ private:
         /**
          * @brief Get vector of lambdas
          *
-         * This method returns a vector that stores the lambdas.
+         * This method returns a vector that stores the non-zero lambdas of the i-th inner vertex,
+         * as pairs of the vertex index - 1 and the value.
          *
          * @return vector of lambdas
          */
-        const std::vector<T> &getLambdas(const size_t i) const;
+        const std::vector<std::pair<size_t, T> > &getLambdas(const size_t i) const;
 
         /**
          * @brief Get boundary corners depending on the method
@@ -344,7 +357,7 @@ private:
     *  a(i,i) = 1
     *  a(i,j) = -lambda(i,j) for j!=i
     * and the right hand side is calculated using the boundary parameters found beforehand. The parameter values are multiplied with corresponding lambda values and summed up.
-    * In the last step the system is solved and the parameter points are stored in m_parameterPoints.
+    * In the last step the (sparse) system is solved and the parameter points are stored in m_parameterPoints.
     *
     * @param[in] neighbourhood const Neighbourhood& - neighbourhood information of the mesh
     * @param[in] n const int - number of inner vertices and therefore size of the square matrix
@@ -121,31 +121,46 @@ void gsParametrization<T>::constructAndSolveEquationSystem(const Neighbourhood &
                                                            const size_t n,
                                                            const size_t N)
 {
-    gsMatrix<T> A;
-    A.resize(n, n);
-    std::vector<T> lambdas;
+    gsSparseMatrix<T> A(n, n);
+    gsSparseEntries<T> entries;
     gsVector<T> b1(n), b2(n);
     b1.setZero(); b2.setZero();
 
     for (size_t i = 0; i < n; i++)
     {
-        lambdas = neighbourhood.getLambdas(i);
-        for (size_t j = 0; j < n; j++)
+        const std::vector<std::pair<size_t, T> > & lambdas = neighbourhood.getLambdas(i);
+        entries.add(i, i, T(1));
+        for (typename std::vector<std::pair<size_t, T> >::const_iterator it = lambdas.begin(); it != lambdas.end(); ++it)
         {
-            A(i, j) = ( i==j ? T(1) : -lambdas[j] );
-        }
-
-        for (size_t j = n; j < N; j++)
-        {
-            b1(i) += (lambdas[j]) * (m_parameterPoints[j][0]);
-            b2(i) += (lambdas[j]) * (m_parameterPoints[j][1]);
+            const size_t j = it->first;
+            if (j < n)
+            {
+                if (j != i)
+                    entries.add(i, j, -it->second);
+            }
+            else if (j < N)
+            {
+                b1(i) += (it->second) * (m_parameterPoints[j][0]);
+                b2(i) += (it->second) * (m_parameterPoints[j][1]);
+            }
         }
     }
+    A.setFrom(entries);
+    A.makeCompressed();
 
     gsVector<T> u(n), v(n);
-    Eigen::PartialPivLU<typename gsMatrix<T>::Base> LU = A.partialPivLu();
-    u = LU.solve(b1);
-    v = LU.solve(b2);
+    typename gsSparseSolver<T>::LU solver(A);
+    if (solver.info() != Eigen::Success)
+    {
+        gsWarn << "gsParametrization::constructAndSolveEquationSystem: The system is singular.\n";
+        u.setConstant(std::numeric_limits<T>::quiet_NaN());
+        v.setConstant(std::numeric_limits<T>::quiet_NaN());
+    }
+    else
+    {
+        u = solver.solve(b1);
+        v = solver.solve(b2);
+    }
 
     for (size_t i = 0; i < n; i++)
         m_parameterPoints[i] << u(i), v(i);
@@ -247,21 +262,26 @@ T gsParametrization<T>::findLengthOfPositionPart(const size_t position,
 template<class T>
 gsParametrization<T>::Neighbourhood::Neighbourhood(const gsHalfEdgeMesh<T> & meshInfo, const size_t parametrizationMethod)  : m_basicInfos(meshInfo)
 {
-    m_localParametrizations.reserve(meshInfo.getNumberOfInnerVertices());
-    for(size_t i=1; i <= meshInfo.getNumberOfInnerVertices(); i++)
+    const index_t n = meshInfo.getNumberOfInnerVertices();
+    const index_t B = meshInfo.getNumberOfVertices() - n;
+    m_localParametrizations.resize(n);
+    m_localBoundaryNeighbourhoods.resize(B);
+
+#   pragma omp parallel for schedule(dynamic, 256)
+    for(index_t i=0; i < n; i++)
     {
-        m_localParametrizations.push_back(LocalParametrization(meshInfo, LocalNeighbourhood(meshInfo, i), parametrizationMethod));
+        m_localParametrizations[i] = LocalParametrization(meshInfo, LocalNeighbourhood(meshInfo, i+1), parametrizationMethod);
     }
 
-    m_localBoundaryNeighbourhoods.reserve(meshInfo.getNumberOfVertices() - meshInfo.getNumberOfInnerVertices());
-    for(size_t i=meshInfo.getNumberOfInnerVertices()+1; i<= meshInfo.getNumberOfVertices(); i++)
+#   pragma omp parallel for schedule(dynamic, 256)
+    for(index_t i=0; i < B; i++)
     {
-        m_localBoundaryNeighbourhoods.push_back(LocalNeighbourhood(meshInfo, i,0));
+        m_localBoundaryNeighbourhoods[i] = LocalNeighbourhood(meshInfo, n+i+1, 0);
     }
 }
 
 template<class T>
-const std::vector<T>& gsParametrization<T>::Neighbourhood::getLambdas(const size_t i) const
+const std::vector<std::pair<size_t, T> >& gsParametrization<T>::Neighbourhood::getLambdas(const size_t i) const
 {
     return m_localParametrizations[i].getLambdas();
 }
@@ -548,16 +568,13 @@ gsParametrization<T>::LocalParametrization::LocalParametrization(const gsHalfEdg
         }
             break;
         case 2:
-            m_lambdas.reserve(meshInfo.getNumberOfVertices());
-            for(size_t j=1; j <= meshInfo.getNumberOfVertices(); j++)
-            {
-                m_lambdas.push_back(0); // Lambda(m_vertexIndex, j, 0)
-            }
+            m_lambdas.reserve(d);
             while(!indices.empty())
             {
-                m_lambdas[indices.front()-1] += (1./d);
+                m_lambdas.push_back(std::make_pair(indices.front()-1, (T)(1./d)));
                 indices.pop_front();
             }
+            mergeLambdas();
             break;
         case 3:
         {
@@ -568,16 +585,13 @@ gsParametrization<T>::LocalParametrization::LocalParametrization(const gsHalfEdg
                 sumOfDistances += *it;
             }
             T sumOfDistancesInv = 1./sumOfDistances;
-            m_lambdas.reserve(meshInfo.getNumberOfVertices());
-            for(size_t j=1; j <= meshInfo.getNumberOfVertices(); j++)
-            {
-                m_lambdas.push_back(0); //Lambda(m_vertexIndex, j, 0)
-            }
+            m_lambdas.reserve(d);
             for(typename std::list<T>::iterator it = neighbourDistances.begin(); it != neighbourDistances.end(); it++)
             {
-                m_lambdas[indices.front()-1] += ((*it)*sumOfDistancesInv);
+                m_lambdas.push_back(std::make_pair(indices.front()-1, (*it)*sumOfDistancesInv));
                 indices.pop_front();
             }
+            mergeLambdas();
         }
             break;
         default:
@@ -586,7 +600,7 @@ gsParametrization<T>::LocalParametrization::LocalParametrization(const gsHalfEdg
 }
 
 template<class T>
-const std::vector<T>& gsParametrization<T>::LocalParametrization::getLambdas() const
+const std::vector<std::pair<size_t, T> >& gsParametrization<T>::LocalParametrization::getLambdas() const
 {
     return m_lambdas;
 }
@@ -600,14 +614,11 @@ const std::vector<T>& gsParametrization<T>::LocalParametrization::getLambdas() c
 template<class T>
 void gsParametrization<T>::LocalParametrization::calculateLambdas(const size_t N, VectorType& points)
 {
-    m_lambdas.reserve(N);
-    for(size_t j=1; j <= N; j++)
-    {
-        m_lambdas.push_back(0); //Lambda(m_vertexIndex, j, 0)
-    }
+    GISMO_UNUSED(N);
     Point2D p(0, 0, 0);
     size_t d = points.size();
     std::vector<T> my(d, 0);
+    std::vector<T> lambdas(d, 0); // lambdas of the neighbours, in the order of points
     size_t l=1;
     size_t steps = 0;
     //size_t checkOption = 0;
@@ -642,20 +653,42 @@ void gsParametrization<T>::LocalParametrization::calculateLambdas(const size_t N
         }
         for(size_t k = 1; k <= d; k++)
         {
-            m_lambdas[points[k-1].getVertexIndex()-1] += (my[k-1]);
+            lambdas[k-1] += (my[k-1]);
         }
         std::fill(my.begin(), my.end(), 0);
         l++;
     }
-    for(typename std::vector<T>::iterator it=m_lambdas.begin(); it != m_lambdas.end(); it++)
+    m_lambdas.reserve(d);
+    for(size_t k = 0; k < d; k++)
     {
-        *it /= d;
+        m_lambdas.push_back(std::make_pair((size_t)points[k].getVertexIndex()-1, lambdas[k]));
     }
-    for(typename std::vector<T>::iterator it=m_lambdas.begin(); it != m_lambdas.end(); it++)
+    mergeLambdas();
+    for(typename std::vector<std::pair<size_t, T> >::iterator it=m_lambdas.begin(); it != m_lambdas.end(); it++)
     {
-        if(*it < 0)
-            gsInfo << *it << "\n";
+        it->second /= d;
+    }
+    for(typename std::vector<std::pair<size_t, T> >::iterator it=m_lambdas.begin(); it != m_lambdas.end(); it++)
+    {
+        if(it->second < 0)
+            gsInfo << it->second << "\n";
+    }
+}
+
+template<class T>
+void gsParametrization<T>::LocalParametrization::mergeLambdas()
+{
+    std::sort(m_lambdas.begin(), m_lambdas.end());
+    size_t k = 0;
+    for(size_t j = 1; j < m_lambdas.size(); j++)
+    {
+        if(m_lambdas[j].first == m_lambdas[k].first)
+            m_lambdas[k].second += m_lambdas[j].second;
+        else
+            m_lambdas[++k] = m_lambdas[j];
     }
+    if(!m_lambdas.empty())
+        m_lambdas.resize(k+1);
 }
 
 //*******************************************************************************************
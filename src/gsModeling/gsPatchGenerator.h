@@ -310,4 +310,37 @@ void gsPatchGenerator<T>::preparePatch(gsTensorBSplineBasis<d,T> & resultBasis,
 }
 
 
+/**
+   \brief Computes one patch for each set of boundaries in \a
+   boundaries, using the patch generator \a Generator (e.g.
+   gsCoonsPatch or gsSpringPatch).
+
+   The patches are computed in parallel, every thread owning one
+   generator, so that data kept by a generator (such as the
+   factorization of gsSpringPatch) is reused by the patches handled
+   by the same thread. The resulting patches are stored in the order
+   of the input.
+
+   \ingroup Modeling
+*/
+template <class Generator, typename T>
+gsMultiPatch<T> computePatches(const std::vector< gsMultiPatch<T> > & boundaries)
+{
+    const index_t n = boundaries.size();
+    typename gsMultiPatch<T>::PatchContainer patches(n);
+
+#pragma omp parallel
+    {
+        Generator gen;
+        gsPatchGenerator<T> & pgen = gen;
+
+#pragma omp for schedule(dynamic)
+        for ( index_t i = 0; i < n; ++i )
+            patches[i] = pgen.compute(boundaries[i]).clone().release();
+    }//omp parallel
+
+    return gsMultiPatch<T>(patches);
+}
+
+
 }// namespace gismo
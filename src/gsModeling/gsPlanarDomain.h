@@ -184,6 +184,7 @@ public:
     /// @name inDomain
     /// given a matrix of points \param u, returns true if they are inside the planar domain
     ///\param direction sets to 0 states we are performing our checking running parallel to the x-axis
+    /// \sa gsPlanarDomainClassifier for classifying many points
     bool inDomain( gsMatrix<T> const & u, int direction = 0);
 
     ///@name onBoundary
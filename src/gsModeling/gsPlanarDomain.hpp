@@ -20,6 +20,7 @@
 #include <gsNurbs/gsNurbsCreator.h>
 
 #include <gsUtils/gsMesh/gsMesh.h>
+#include <gsModeling/gsConstrainedDelaunay.h>
 
 #include <gsModeling/gsTraceCurve.hpp>
 #include <gsModeling/gsTemplate.h>
@@ -245,419 +246,109 @@ void gsPlanarDomain<T>::sampleCurve_into( int loopID, int curveID, int npoints,
 
 /// Return a triangulation of the planar domain
 template <class T>
-memory::unique_ptr<gsMesh<T> > gsPlanarDomain<T>::toMesh(int npoints) const     // FOR NOW ONLY ONE LOOP
+memory::unique_ptr<gsMesh<T> > gsPlanarDomain<T>::toMesh(int npoints) const
 {
-    typename gsMesh<T>::uPtr m(new gsMesh<T>());
-    // Typedefs
-    typedef typename gsVertex<T>::gsVertexHandle VertexHandle;
-    //typedef std::deque<VertexHandle>            VertexList;
-    //typedef typename std::deque<VertexHandle>::iterator  VertexListIter;
-
     GISMO_ASSERT(npoints > 0, "Number of points must be positive.");
 
-#if FALSE
-    T h_x = (m_bbox(0,1) - m_bbox(0,0) ) / (npoints-1) ,
-            h_y = (m_bbox(1,1) - m_bbox(1,0) ) / (npoints-1) ;
-
-    //========== 1. Compute y-parallel segments
-    VertexList x_seg_begin; // Starting points of y-parallel segments
-    VertexList x_seg_end;   // Endpoints  of y-parallel segments
-
-    T xi = m_bbox(0,1);
-    std::vector<T> tmp = m_loops[0]->lineIntersections(0, xi );// segments
-    gsDebug<<"----- INTs:  "<<tmp.size()<<"( "<<xi<<") \n";
-    gsAsMatrix<T> xxi(tmp);
-    gsMatrix<T> xev;
-    m_loops[0]->curve(0).eval_into(xxi, xev );// Push forward onto the curve: xev.row(1)==xi
-    gsVector<T> x_seg = xev.row(1) ;// xev.row(0)==xi
-    std::sort( x_seg.data(), x_seg.data()+x_seg.size() );
+    // Target edge length: npoints per unit length, and at least 25
+    // points along the bounding box
+    const T h = math::min( T(1) / npoints,
+                           (m_bbox.col(1) - m_bbox.col(0)).maxCoeff() / 25 );
+    const T x0 = m_bbox(0,0), y0 = m_bbox(1,0);
+    const index_t nc = cast<T,index_t>( (m_bbox(0,1) - x0) / h ) + 3;
 
-    for ( index_t j= 0; j!= x_seg.size(); j+=2 )
-    {
-        VertexHandle v = m->addVertex( xi, x_seg[j] );
-        if ( x_seg[j] < x_seg[j+1] )
-        {
-            x_seg_begin.push_back( v );
-            v = m->addVertex( xi, x_seg[j+1] );
-            x_seg_end.push_back ( v );
-        }
-        else
-        {
-            x_seg_end.push_back( v );
-            v = m->addVertex( xi, x_seg[j+1] );
-            x_seg_begin.push_back ( v );
-        }
-    }
+    gsConstrainedDelaunay<T> cdt;
 
-    xi = m_bbox(0,0);
-    for ( int i = 0; i!= npoints-1; ++i )
+    //========== 1. Boundary loops, sampled adaptively to the curvature
+    std::vector<T> bnd; // coordinates of the boundary samples
+    std::vector<std::pair<index_t,index_t> > cells; // (cell, sample) pairs
+    for (size_t j = 0; j != m_loops.size(); ++j)
     {
-        tmp = m_loops[0]->lineIntersections(0, xi );
-        gsDebug<<"----- INTs:  "<<tmp.size()<<"( "<<xi<<") \n";
-        //gsDebug<<"----- INTs x:  "<<tmp.size()<<", i="<<i<<"\n";
-        gsAsMatrix<T> xxi(tmp);
-        m_loops[0]->curve(0).eval_into(xxi, xev );
-        x_seg = xev.row(1) ;// xev.row(0)==xi
-        std::sort( x_seg.data(), x_seg.data()+x_seg.size() );
-
-        for ( index_t j= 0; j!= x_seg.size(); j+=2 )
+        const gsMatrix<T> pts = m_loops[j]->adaptiveSample(h, h / 20);
+        cdt.addLoop(pts);
+        for (index_t k = 0; k != pts.cols(); ++k)
         {
-            VertexHandle v = m->addVertex( xi, x_seg[j] );
-            if ( x_seg[j] < x_seg[j+1] )
-            {
-                x_seg_begin.push_back( v );
-                v = m->addVertex( xi, x_seg[j+1] );
-                x_seg_end.push_back ( v );
-            }
-            else
-            {
-                x_seg_end.push_back( v );
-                v = m->addVertex( xi, x_seg[j+1] );
-                x_seg_begin.push_back ( v );
-            }
+            const index_t cx = cast<T,index_t>( math::floor((pts(0,k) - x0) / h) ) + 1;
+            const index_t cy = cast<T,index_t>( math::floor((pts(1,k) - y0) / h) ) + 1;
+            cells.push_back( std::make_pair(cx + nc * cy, index_t(bnd.size() / 2)) );
+            bnd.push_back(pts(0,k));
+            bnd.push_back(pts(1,k));
         }
-        xi += h_x;
     }
+    std::sort(cells.begin(), cells.end());
 
-    //========== 2. Sort the segments wrt both endpoints
-    std::sort( x_seg_begin.begin(), x_seg_begin.end(), Yless<T> );
-    std::sort( x_seg_end.begin()  , x_seg_end.end()  , Yless<T> );
-
-    gsDebug<<"x-segments: "<<x_seg_begin.size()<<", "<<x_seg_end.size()<<"\n";
-
-    //========== 3. March on x-parallel segments
-    bool SegStart(false), SegEnd(false);
-    VertexList line0; // x-sorted
+    //========== 2. Interior points on a triangular lattice, on the
+    // parts of the lines y=yi which lie inside the domain
 
-    VertexListIter ss = x_seg_begin.begin(),
-            es = x_seg_end.begin();
-    T yi = m_bbox(1,0);
-    VertexList Yprev;
+    const T dy = h * math::sqrt(T(3)) / 2;
+    const index_t ny = cast<T,index_t>( (m_bbox(1,1) - y0) / dy );
+    std::vector<T> y_levels(ny);
+    for (index_t i = 0; i != ny; ++i)
+        y_levels[i] = y0 + (i + T(0.5)) * dy;
 
-    for ( int i = 0; i!= npoints; ++i )
+    // Intersections of every loop with all the lines y=yi
+    std::vector<std::vector<T> > x_all(ny);
+    gsMatrix<T> e;
+    for (size_t j = 0; j != m_loops.size(); ++j)
     {
-        tmp = m_loops[0]->lineIntersections(1, yi );
-        //gsDebug<<"----- INTs y: "<<tmp.size()<<"\n";
-
-        if ( ! tmp.empty() ) // Intersection event
+        std::vector<std::vector<T> > par = m_loops[j]->lineIntersections(1, y_levels);
+        typename gsCurve<T>::uPtr curve = m_loops[j]->singleCurve();
+        for (index_t i = 0; i != ny; ++i)
         {
-            gsDebug<<"---  Intersection event "<<i<<"( "<<yi<<" )\n";
-
-            // Compute intersections with y=yi
-            gsAsMatrix<T> yyi(tmp);
-            gsMatrix<T> yev;
-            m_loops[0]->curve(0).eval_into(yyi, yev );
-            gsVector<T> y_seg = yev.row(0) ;// yev.row(1)==yi
-            std::sort( y_seg.data(), y_seg.data()+y_seg.size() );
-            VertexHandle v;
-            VertexList line1;
-
-            // Look for SegEnd events
-            while( es != x_seg_end.end() &&  (*es)->y() < yi )
-            {// Property: every line has unique points wrt x-coord
-                gsDebug<<"SegEnd: "<< **es ;
-                SegEnd=true;
-
-                for ( VertexListIter it= line0.begin(); it!= line0.end(); ++it )
-                    if (  (*it)->x() == (*es)->x() )
-                    {
-                        gsDebug<<"SegEnd: removed "<< **it ;
-                        line0.erase( it );
-                        break;
-                    }
-                es++;
-            }
-
-            // Mirror previous lines
-            for ( VertexListIter it= line0.begin(); it!= line0.end(); ++it )
-            {
-                v = m->addVertex( (*it)->x(),  yi );
-                line1.push_back(v);
-            }
-
-            // Look for SegStart events
-            while( ss != x_seg_begin.end() &&  (*ss)->y() < yi )
-            {
-                SegStart=true;
-                gsDebug<<"SegStart: added "<< (*ss)->x() <<".\n";
-                line0.push_back(*(ss) );
-                v = m->addVertex( (*ss)->x(),  yi );
-                line1.push_back(v);
-                ss++;
-            }
-
-            std::sort( line0.begin(), line0.end(), Xless<T> );
-            std::sort( line1.begin(), line1.end(), Xless<T> );
-
-            gsDebug<<"line0  has "<< line0.size()  <<" points\n";
-            gsDebug<<"line1  has "<< line1.size()  <<" points\n";
-
-            // add faces
-            if ( ! line1.empty() && line1.size() == line0.size() )
-            {
-                gsDebug<<"Tiling row "<<i<<".\n";
-                VertexListIter it0=line0.begin();
-                for ( VertexListIter it1= line1.begin(); it1!= line1.end()-1; ++it1, ++it0 )
-                    m->addFace( *it0, *it1,  *(it1+1), *(it0+1) );
-            }
-            else
-            {
-                gsDebug<<"Trouble..\n";
-                VertexListIter it0=line0.begin();
-                for ( VertexListIter it1= line1.begin(); it1!= line1.end(); ++it1, ++it0 )
-                    gsDebug<< (*it0)->x() <<" - "<< (*it1)->x()  <<" \n";
-                while ( it0 != line0.end() )
-                    gsDebug<< (*it0++)->x() <<" -     * " <<" \n";
-
-            }
-
-            gsDebug<<"Connecting endpoints.\n";
-
-            VertexList Yseg;
-            // Make boundary vertices on y=yi
-            Yseg.push_back( m->addVertex( y_seg[0]             , yi ) );
-            Yseg.push_back( m->addVertex( y_seg[y_seg.size()-1], yi ) );
-
-            if (SegStart )
-            {
-                // connect x-boundary point to level 0
-                if ( Yprev.size() )
-                {
-                    m->addFace( Yprev[0],  line0.front(), line0[1] );
-                    m->addFace( Yprev[1],  line0.back() , line0[line0.size()-2] );
-                }
-                // connect x-boundary point to level 1
-                m->addFace( Yseg[0],  line1.front(), line0.front() );
-                m->addFace( Yseg[1],  line1.back(), line0.back() );
-            }
-            else if ( Yprev.size() )
-            {
-                // Connect y-boundary points
-                m->addFace( line1.front(),  line0.front(), Yprev[0], Yseg[0] );
-                m->addFace( line1.back() ,  line0.back() , Yprev[1], Yseg[1] );
-            }
-
-            Yprev = Yseg;
-            line0 = line1;
-            SegStart=SegEnd=false;
-        }
-        else // No intersection event
-        {
-            Yprev.clear();
-            line0.clear();
+            if ( par[i].empty() )
+                continue;
+            curve->eval_into( gsAsMatrix<T>(par[i], 1, par[i].size()), e );
+            for (index_t k = 0; k != e.cols(); ++k)
+                x_all[i].push_back( e(0,k) );
         }
-
-        // next y-line
-        yi += h_y;
-    }
-
-    // repeat for yi=m_bbox(1,1)
-
-    return m;
-#endif
-    T bbox_length_y =m_bbox(1,1)-m_bbox(1,0);
-    int yPoints = cast<T,int>( npoints*bbox_length_y) ;
-    int lb_yPoints=25;
-    if(yPoints<lb_yPoints)
-    {
-        if ( yPoints > 0 )
-            npoints *= lb_yPoints / yPoints;
-        else
-            npoints *= lb_yPoints / 2;
-        
-        yPoints  = lb_yPoints;
     }
 
-    // vector of y-coords of npoints lines parrallel to x-axis
-    // IDEA: Also use these as x_sample_guides !!!
-    gsMatrix<T> y_samples = gsPointGrid<T>( m_bbox(1,0), m_bbox(1,1), yPoints);
-
-    // x-coords of sampling points on the line y=yi (if any)
-    // int: yi index,
-    //gsVector *: a pointer to a vector of npoints x-coords of sample points on the line y=yi
-    //std::vector<index_t>: a vector of indices that indicate
-    //the line segments of y=yi that intesect the domain
-
-    std::vector<std::vector< VertexHandle > >samples;
-    std::vector<std::vector< VertexHandle > >intersections;
-
-    //    std::map<int,
-    //            std::pair<
-    //            std::vector< VertexHandle >,
-    //            std::vector<T>
-    //            >
-    //            > x_samples;
-    for ( int i = 0; i!= yPoints; ++i )
+    const T minDist2 = T(0.49) * h * h; // squared distance to the boundary samples
+    for (index_t i = 0; i != ny; ++i)
     {
-        std::vector<T> x_all;
-        //gsDebug<<" --- before intersections  " << i <<", y="<< y_samples(0,i)  <<"\n";
-        for (size_t j=0;j<m_loops.size();j++)
+        std::vector<T> & x = x_all[i];
+        std::sort(x.begin(), x.end());
+        if ( x.size() % 2 ) // tangent, row skipped
+            continue;
+
+        const T y = y_levels[i];
+        const index_t cy = cast<T,index_t>( math::floor((y - y0) / h) ) + 1;
+        for (size_t s = 0; s < x.size(); s += 2)
         {
-            std::vector<T> x = m_loops[j]->lineIntersections(1, y_samples(0,i) );
-            if ( ! x.empty() )
+            const T shift = (i % 2 ? T(0.5) : T(0) );
+            for (index_t k = cast<T,index_t>( math::ceil((x[s] - x0) / h - shift) );
+                 x0 + (k + shift) * h < x[s+1]; ++k)
             {
-                typename gsCurve<T>::uPtr curve = m_loops[j]->singleCurve() ; // TO BE REMOVED later
-
-                if ( x.size() == 1 )
-                {
-                    x.push_back(x[0]);
-                    gsWarn<<"lineIntersection yielded a tangent"<<'\n';
-                }
-                else if (x.size()%2==1)
-                {
-                    x.push_back(x[0]);
-                    gsWarn<<"lineIntersection yielded a tangent and more intersections, try another number of points"<<'\n';
-                }
+                const T xk = x0 + (k + shift) * h;
+                const index_t cx = cast<T,index_t>( math::floor((xk - x0) / h) ) + 1;
 
-                gsAsMatrix<T> xx(x);
-                gsMatrix<T> e = curve->eval( xx );
-                for (size_t k=0;k<x.size();k++)
+                // Skip points too close to the boundary
+                bool farAway = true;
+                for (index_t c = -1; farAway && c != 2; ++c)
                 {
-                    x_all.push_back(e(0,k));
-                }
-            }
-        }
-        std::sort(x_all.begin(), x_all.end() );
-        gsVector<int> numPoints( x_all.size() / 2 );
-        int k(0);
-        for ( typename std::vector<T>::const_iterator it = x_all.begin();
-              it < x_all.end(); it += 2 )
-            numPoints[k++] = cast<T,int>( (*(it+1) - *it)* npoints );
-
-        std::vector<VertexHandle> x_line;
-        std::vector<VertexHandle> intersection_vec;
-        for(index_t j=0;j<numPoints.size();j++)
-        {
-            x_line.push_back(m->addVertex(x_all[j*2],y_samples(0,i)));
-            intersection_vec.push_back(m->addVertex(x_all[j*2],y_samples(0,i)));
-
-            for(k=0; k<numPoints[j]; k++)
-            {
-                x_line.push_back(m->addVertex(x_all[j*2]*(numPoints[j]-k)/(numPoints[j]+1)+x_all[j*2+1]*(k+1)/(numPoints[j]+1),y_samples(0,i)));
-            }
-            x_line.push_back(m->addVertex(x_all[j*2+1],y_samples(0,i)));
-            intersection_vec.push_back(m->addVertex(x_all[j*2+1],y_samples(0,i)));
-        }
-        samples.push_back(x_line);
-        intersections.push_back(intersection_vec);
-    }
-    T checkDist=(y_samples(0,1)-y_samples(0,0))*5;
-    for(size_t i=0;i<intersections.size()-1;i++)
-    {
-        size_t currentTop=0;
-        size_t currentBot=0;
-
-        T topToBotDist=0;
-        T botToTopDist=0;
-        if(samples[i].size()>0&&samples[i+1].size()>0)
-        {
-            while (currentTop!=samples[i].size()-1||currentBot!=samples[i+1].size()-1)
-            {
-                if(currentTop==samples[i].size()-1)
-                {
-                    VertexHandle v1=samples[i][currentTop];
-                    VertexHandle v2=samples[i+1][currentBot];
-                    VertexHandle v3=samples[i+1][currentBot+1];
-                    if(getDistance(v1,v2)<checkDist&&getDistance(v1,v3)<checkDist&&getDistance(v2,v3)<checkDist)
-                        m->addFace(v1,v2,v3);
-                    currentBot++;
-                }
-                else if(currentBot==samples[i+1].size()-1)
-                {
-                    VertexHandle v1=samples[i][currentTop];
-                    VertexHandle v2=samples[i+1][currentBot];
-                    VertexHandle v3=samples[i][currentTop+1];
-                    if(getDistance(v1,v2)<checkDist&&getDistance(v1,v3)<checkDist&&getDistance(v2,v3)<checkDist)
-                        m->addFace(v1,v2,v3);
-                    currentTop++;
-                }
-                else
-                {
-                    topToBotDist=getDistance(samples[i][currentTop],samples[i+1][currentBot+1]);
-                    botToTopDist=getDistance(samples[i][currentTop+1],samples[i+1][currentBot]);
-                    if (topToBotDist<botToTopDist)
+                    const index_t key = cx - 1 + nc * (cy + c);
+                    typename std::vector<std::pair<index_t,index_t> >::const_iterator
+                        it = std::lower_bound(cells.begin(), cells.end(),
+                                              std::make_pair(key, index_t(0)));
+                    for (; it != cells.end() && it->first <= key + 2; ++it)
                     {
-                        VertexHandle v1=samples[i][currentTop];
-                        VertexHandle v2=samples[i+1][currentBot];
-                        VertexHandle v3=samples[i+1][currentBot+1];
-                        if(getDistance(v1,v2)<checkDist&&getDistance(v1,v3)<checkDist&&getDistance(v2,v3)<checkDist)
-                            m->addFace(v1,v2,v3);
-                        currentBot++;
-                    }
-                    else
-                    {
-                        VertexHandle v1=samples[i][currentTop];
-                        VertexHandle v2=samples[i+1][currentBot];
-                        VertexHandle v3=samples[i][currentTop+1];
-                        if(getDistance(v1,v2)<checkDist&&getDistance(v1,v3)<checkDist&&getDistance(v2,v3)<checkDist)
-                            m->addFace(v1,v2,v3);
-                        currentTop++;
+                        const T ddx = bnd[2*it->second] - xk, ddy = bnd[2*it->second+1] - y;
+                        if ( ddx * ddx + ddy * ddy < minDist2 )
+                        {
+                            farAway = false;
+                            break;
+                        }
                     }
                 }
+                if ( farAway )
+                    cdt.addPoint(xk, y);
             }
         }
-
     }
 
-
-    //            // generate the Mesh vertices.
-    //            k = npoints - x.size(); // points to distribute to the (interior of) the segments
-    //            std::vector< VertexHandle > x_line;
-    //            x_line.reserve(npoints);
-    //            for (size_t v=0; v< x.size(); v+=2 )
-    //            {
-    //                x_line.push_back( m->addVertex(x[v], y_samples(0,i)) );
-    //                // TO DO
-    //                // ( ll[v/2] / ltotal )*k samples here
-    //                for( int j = 1; j!= k+1; ++j)
-    //                    x_line.push_back( m->addVertex(x[v] + T(j) * ll[v/2] / T(k+1), y_samples(0,i)) );
-
-    //                x_line.push_back( m->addVertex(x[v+1], y_samples(0,i) ) );
-    //            }
-    //            //gsDebug<<"i: "<< i<< ", sz="<< x_line.size() <<", ints="<< x.size() <<"\n";
-    //            //gsDebug<<"x= "<< x[0] <<", "<< x[1] <<"(y="<< y_samples(0,i) <<"\n";
-
-    //            x_samples.insert( make_pair(i,make_pair( x_line, x ) ) ); // i-th sample line
-
-
-    //    }
-
-    //gsDebug<<" --- mesh DONE  "<< *m  <<"\n";
-    // for ( int i = 0; i!= 25; ++i )
-    //gsDebug<<"--"<<* m->vertex[i] ;
-
-    // Zig-zag connection
-    //    for ( int i = 0; i!= npoints-1; ++i )
-    //    {
-    //        typename std::map<int,std::pair<std::vector<VertexHandle>, std::vector<T> > >::const_iterator
-    //            it0 = x_samples.find(i);
-
-    //        if ( it0 != x_samples.end() ) // Check whether intersection with line 0 exists
-    //        {
-    //            typename std::map<int,std::pair<std::vector<VertexHandle>, std::vector<T> > >:: const_iterator
-    //                it1 = x_samples.find(i+1);
-    //            if ( it1 != x_samples.end() ) // Check whether intersection with line 1 exists
-    //            {
-    //                //typename std::vector<T>::const_iterator s0 = it0->second.second.begin();
-    //                //typename std::vector<T>::const_iterator s1 = it1->second.second.begin();
-    //                typename std::vector<VertexHandle>::const_iterator f1 = it1->second.first.begin();
-    //                // Run through the sample points at line 0
-    //                for ( typename std::vector<VertexHandle>::const_iterator f0 =
-    //                        it0->second.first.begin();
-    //                        f0 != it0->second.first.end()-1 ; ++f0 )
-    //                {
-    //                    // TO DO
-    //                    //if ( *f0 == *s0 )// start segment level 0
-    //                    // if ( *f1 == *s1 )// start segment level 1
-    //                    m->addFace( *f0    , *f1    , *(f1+1), *(f0+1) ) ;
-    //                    f1++;
-    //                }
-    //            }
-    //        }
-    //    }
-    //gsDebug<<*m;
-    return m;
-
+    //========== 3. Constrained Delaunay triangulation
+    cdt.compute();
+    return cdt.toMesh();
 }
 
 
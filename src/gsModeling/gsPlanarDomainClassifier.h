@@ -0,0 +1,140 @@
+/** @file gsPlanarDomainClassifier.h
+
+    @brief Provides fast inside/outside classification of many points
+    with respect to a gsPlanarDomain.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsModeling/gsPlanarDomain.h>
+#include <gsNurbs/gsBSpline.h>
+
+namespace gismo
+{
+
+/**
+   \brief Classifies batches of points as inside or outside of a
+   planar domain.
+
+   gsPlanarDomain::inDomain merges the boundary loops and computes the
+   intersections of every loop with a line through the point, for each
+   query. This class does the expensive part once:
+
+   - every boundary curve is approximated by a polygon, which is
+   refined until its distance to the curve (measured at interior
+   samples of every segment) is below the tolerance,
+   - the segments are stored in a uniform grid, both per cell (with
+   a margin of two times the tolerance) and per horizontal band.
+
+   A point that is not within two tolerances of the polygon is then
+   classified by the even-odd rule on the segments of its band. The
+   remaining points, close to the boundary, are classified exactly
+   like in gsPlanarDomain::inDomain, with one batched root finding per
+   loop.
+
+   Example:
+   \code
+   gsPlanarDomainClassifier<T> pdc(domain);
+   gsVector<index_t> inside;
+   pdc.inDomain_into(points, inside); // points is a 2 x n matrix
+   \endcode
+
+   \tparam T coordinate type
+
+   \ingroup Modeling
+*/
+template<class T>
+class gsPlanarDomainClassifier
+{
+public:
+
+    /// Preprocesses \a domain. The tolerance \a tol of the polygonal
+    /// approximation is relative to the diagonal of the bounding box
+    /// of the domain.
+    explicit gsPlanarDomainClassifier(const gsPlanarDomain<T> & domain, T tol = 1e-4);
+
+public:
+
+    /// Sets result[i] to 1 if the point u.col(i) lies inside the
+    /// domain and to 0 otherwise. The points are processed in
+    /// parallel. Returns the number of points that were tested
+    /// exactly, since they are close to the boundary.
+    index_t inDomain_into(gsMatrix<T> const & u, gsVector<index_t> & result) const;
+
+    /// Returns true if the point \a u (a column) lies inside the domain
+    bool inDomain(gsMatrix<T> const & u) const
+    {
+        gsVector<index_t> result;
+        inDomain_into(u, result);
+        return 1 == result[0];
+    }
+
+    /// Returns the number of segments of the polygonal approximation
+    index_t numSegments() const { return m_start.cols(); }
+
+    /// Returns the (absolute) tolerance of the polygonal approximation
+    T tolerance() const { return m_tol; }
+
+    /// Returns the points of the polygonal approximation of loop \a
+    /// loopNumber, as columns
+    gsMatrix<T> polygon(index_t loopNumber) const
+    { return m_start.middleCols(m_loopStart[loopNumber], m_loopStart[loopNumber+1] - m_loopStart[loopNumber]); }
+
+private:
+
+    /// Appends to \a par the parameters in (t0,t1] of the polygonal
+    /// approximation of \a curve between the points \a p0 = curve(t0)
+    /// and \a p1 = curve(t1)
+    void sampleSegment(const gsCurve<T> & curve, T t0, T t1,
+                       const gsMatrix<T> & p0, const gsMatrix<T> & p1,
+                       int depth, std::vector<T> & par) const;
+
+    /// Squared distance of (x,y) to the segment from (ax,ay) to (bx,by)
+    static T segmentDistance2(T ax, T ay, T bx, T by, T x, T y);
+
+    /// Builds the cell and band lists of the segments
+    void buildGrid();
+
+    /// Returns the cell containing (x,y), or -1 if (x,y) lies
+    /// outside the grid
+    index_t cellOf(T x, T y) const;
+
+    /// Tells whether (x,y) is closer than m_band to some segment
+    bool nearBoundary(T x, T y) const;
+
+    /// Classifies (x,y) with respect to the polygon (even-odd rule)
+    bool insidePolygon(T x, T y) const;
+
+    /// Classifies exactly the columns of \a u with the indices \a ind
+    void exactTest(gsMatrix<T> const & u, const std::vector<index_t> & ind,
+                   gsVector<index_t> & result) const;
+
+private:
+
+    gsMatrix<T> m_start, m_end;        ///< start and end points of the segments
+    std::vector<index_t> m_loopStart;  ///< the segments of loop i are m_loopStart[i],...,m_loopStart[i+1]-1
+
+    T m_tol;                           ///< tolerance of the polygonal approximation
+    T m_band;                          ///< points closer to the polygon are tested exactly
+
+    gsMatrix<T,2,2> m_box;             ///< bounding box of the grid
+    index_t m_nx, m_ny;                ///< number of cells in x- and y-direction
+    T m_hx, m_hy;                      ///< size of the cells
+
+    std::vector<index_t> m_cellStart, m_cellSegments; ///< segments near each cell (compressed)
+    std::vector<index_t> m_rowStart,  m_rowSegments;  ///< segments in each horizontal band (compressed)
+
+    std::vector<gsBSpline<T> > m_loops; ///< the loops as single curves, for the exact test
+};
+
+} // namespace gismo
+
+#ifndef GISMO_BUILD_LIB
+#include GISMO_HPP_HEADER(gsPlanarDomainClassifier.hpp)
+#endif
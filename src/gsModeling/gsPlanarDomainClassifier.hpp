@@ -0,0 +1,296 @@
+/** @file gsPlanarDomainClassifier.hpp
+
+    @brief Provides implementation of the gsPlanarDomainClassifier class.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsNurbs/gsBSplineSolver.h>
+
+namespace gismo
+{
+
+template<class T>
+gsPlanarDomainClassifier<T>::gsPlanarDomainClassifier(const gsPlanarDomain<T> & domain, T tol)
+{
+    const gsMatrix<T> bb = domain.boundingBox();
+    m_tol  = tol * (bb.col(1) - bb.col(0)).norm();
+    m_band = 2 * m_tol;
+
+    // Polygonal approximation of the loops; the last point of every
+    // curve is the first one of the next curve
+    std::vector<gsMatrix<T> > points;
+    std::vector<T> par;
+    gsMatrix<T> t(1,1), p0, p1, pts;
+    index_t total = 0;
+    m_loopStart.push_back(0);
+    for (index_t l = 0; l < domain.numLoops(); ++l)
+    {
+        const gsCurveLoop<T> & loop = domain.loop(l);
+        for (int c = 0; c < loop.numCurves(); ++c)
+        {
+            const gsCurve<T> & curve = loop.curve(c);
+            const gsMatrix<T> supp = curve.support();
+            const index_t n0 = math::max(4, (int)curve.coefsSize());
+            par.clear();
+            par.push_back(supp(0,0));
+            t(0,0) = supp(0,0);
+            curve.eval_into(t, p0);
+            for (index_t k = 1; k <= n0; ++k)
+            {
+                t(0,0) = supp(0,0) + (supp(0,1) - supp(0,0)) * k / n0;
+                curve.eval_into(t, p1);
+                sampleSegment(curve, par.back(), t(0,0), p0, p1, 0, par);
+                p0.swap(p1);
+            }
+            par.pop_back();
+            curve.eval_into(gsAsMatrix<T>(par, 1, par.size()), pts);
+            points.push_back(pts);
+            total += pts.cols();
+        }
+        m_loopStart.push_back(total);
+    }
+
+    m_start.resize(2, total);
+    m_end.resize(2, total);
+    index_t k = 0;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        m_start.middleCols(k, points[i].cols()) = points[i];
+        k += points[i].cols();
+    }
+    for (size_t l = 0; l + 1 < m_loopStart.size(); ++l)
+    {
+        const index_t first = m_loopStart[l], last = m_loopStart[l+1] - 1;
+        m_end.middleCols(first, last - first) = m_start.middleCols(first + 1, last - first);
+        m_end.col(last) = m_start.col(first);
+    }
+
+    buildGrid();
+
+    // The loops as single B-splines, for the exact test
+    for (index_t l = 0; l < domain.numLoops(); ++l)
+    {
+        typename gsCurve<T>::uPtr curve = domain.loop(l).singleCurve();
+        const gsBSpline<T> * bsp = dynamic_cast<const gsBSpline<T> *>(curve.get());
+        if (NULL == bsp)
+        {
+            gsWarn << "gsPlanarDomainClassifier: Loop " << l << " is not a B-spline, "
+                   << "the points near the boundary are classified by the polygon.\n";
+            m_loops.clear();
+            break;
+        }
+        m_loops.push_back(*bsp);
+    }
+}
+
+template<class T>
+void gsPlanarDomainClassifier<T>::sampleSegment(const gsCurve<T> & curve, T t0, T t1,
+                                                const gsMatrix<T> & p0, const gsMatrix<T> & p1,
+                                                int depth, std::vector<T> & par) const
+{
+    gsMatrix<T> t(1,3), e;
+    for (index_t i = 0; i != 3; ++i)
+        t(0,i) = t0 + (t1 - t0) * (i + 1) / 4;
+    curve.eval_into(t, e);
+
+    T dev = 0;
+    for (index_t i = 0; i != 3; ++i)
+        dev = math::max(dev, segmentDistance2(p0(0,0), p0(1,0), p1(0,0), p1(1,0), e(0,i), e(1,i)));
+
+    if (dev > m_tol * m_tol && depth < 20)
+    {
+        sampleSegment(curve, t0, t(0,1), p0, e.col(1), depth + 1, par);
+        sampleSegment(curve, t(0,1), t1, e.col(1), p1, depth + 1, par);
+    }
+    else
+        par.push_back(t1);
+}
+
+template<class T>
+T gsPlanarDomainClassifier<T>::segmentDistance2(T ax, T ay, T bx, T by, T x, T y)
+{
+    const T dx = bx - ax, dy = by - ay;
+    const T l2 = dx * dx + dy * dy;
+    T s = 0;
+    if (l2 > 0)
+        s = math::min((T)(1), math::max((T)(0), ((x - ax) * dx + (y - ay) * dy) / l2));
+    const T ex = ax + s * dx - x, ey = ay + s * dy - y;
+    return ex * ex + ey * ey;
+}
+
+template<class T>
+void gsPlanarDomainClassifier<T>::buildGrid()
+{
+    const index_t ns = m_start.cols();
+    m_box.col(0) = m_start.rowwise().minCoeff().array() - m_band;
+    m_box.col(1) = m_start.rowwise().maxCoeff().array() + m_band;
+
+    m_nx = m_ny = math::min((index_t)1024, math::max((index_t)1, (index_t)math::ceil(math::sqrt((T)ns))));
+    m_hx = (m_box(0,1) - m_box(0,0)) / m_nx;
+    m_hy = (m_box(1,1) - m_box(1,0)) / m_ny;
+
+    // Cells and bands overlapped by the (enlarged) bounding box of each segment
+    gsMatrix<index_t> range(4, ns); // i0, i1, j0, j1
+    for (index_t s = 0; s < ns; ++s)
+    {
+        const T x0 = math::min(m_start(0,s), m_end(0,s)), x1 = math::max(m_start(0,s), m_end(0,s));
+        const T y0 = math::min(m_start(1,s), m_end(1,s)), y1 = math::max(m_start(1,s), m_end(1,s));
+        range(0,s) = math::max((index_t)0, (index_t)math::floor((x0 - m_band - m_box(0,0)) / m_hx));
+        range(1,s) = math::min(m_nx - 1, (index_t)math::floor((x1 + m_band - m_box(0,0)) / m_hx));
+        range(2,s) = math::max((index_t)0, (index_t)math::floor((y0 - m_band - m_box(1,0)) / m_hy));
+        range(3,s) = math::min(m_ny - 1, (index_t)math::floor((y1 + m_band - m_box(1,0)) / m_hy));
+    }
+
+    m_cellStart.assign(m_nx * m_ny + 1, 0);
+    for (index_t s = 0; s < ns; ++s)
+        for (index_t j = range(2,s); j <= range(3,s); ++j)
+            for (index_t i = range(0,s); i <= range(1,s); ++i)
+                ++m_cellStart[j * m_nx + i + 1];
+    for (index_t c = 0; c < m_nx * m_ny; ++c)
+        m_cellStart[c + 1] += m_cellStart[c];
+    m_cellSegments.resize(m_cellStart.back());
+    std::vector<index_t> pos(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (index_t s = 0; s < ns; ++s)
+        for (index_t j = range(2,s); j <= range(3,s); ++j)
+            for (index_t i = range(0,s); i <= range(1,s); ++i)
+                m_cellSegments[pos[j * m_nx + i]++] = s;
+
+    // The bands only need the segments that meet them
+    m_rowStart.assign(m_ny + 1, 0);
+    for (index_t s = 0; s < ns; ++s)
+    {
+        range(2,s) = cellOf(m_box(0,0), math::min(m_start(1,s), m_end(1,s))) / m_nx;
+        range(3,s) = cellOf(m_box(0,0), math::max(m_start(1,s), m_end(1,s))) / m_nx;
+        for (index_t j = range(2,s); j <= range(3,s); ++j)
+            ++m_rowStart[j + 1];
+    }
+    for (index_t j = 0; j < m_ny; ++j)
+        m_rowStart[j + 1] += m_rowStart[j];
+    m_rowSegments.resize(m_rowStart.back());
+    pos.assign(m_rowStart.begin(), m_rowStart.end() - 1);
+    for (index_t s = 0; s < ns; ++s)
+        for (index_t j = range(2,s); j <= range(3,s); ++j)
+            m_rowSegments[pos[j]++] = s;
+}
+
+template<class T>
+index_t gsPlanarDomainClassifier<T>::cellOf(T x, T y) const
+{
+    if (x < m_box(0,0) || x > m_box(0,1) || y < m_box(1,0) || y > m_box(1,1))
+        return -1;
+    const index_t i = math::min(m_nx - 1, (index_t)math::floor((x - m_box(0,0)) / m_hx));
+    const index_t j = math::min(m_ny - 1, (index_t)math::floor((y - m_box(1,0)) / m_hy));
+    return j * m_nx + i;
+}
+
+template<class T>
+bool gsPlanarDomainClassifier<T>::nearBoundary(T x, T y) const
+{
+    const index_t c = cellOf(x, y);
+    for (index_t k = m_cellStart[c]; k != m_cellStart[c + 1]; ++k)
+    {
+        const index_t s = m_cellSegments[k];
+        if (segmentDistance2(m_start(0,s), m_start(1,s), m_end(0,s), m_end(1,s), x, y) <= m_band * m_band)
+            return true;
+    }
+    return false;
+}
+
+template<class T>
+bool gsPlanarDomainClassifier<T>::insidePolygon(T x, T y) const
+{
+    const index_t j = cellOf(x, y) / m_nx;
+    bool inside = false;
+    for (index_t k = m_rowStart[j]; k != m_rowStart[j + 1]; ++k)
+    {
+        const index_t s = m_rowSegments[k];
+        const T ax = m_start(0,s), ay = m_start(1,s), bx = m_end(0,s), by = m_end(1,s);
+        if ( (ay > y) != (by > y) && x < ax + (y - ay) * (bx - ax) / (by - ay) )
+            inside = !inside;
+    }
+    return inside;
+}
+
+template<class T>
+index_t gsPlanarDomainClassifier<T>::inDomain_into(gsMatrix<T> const & u, gsVector<index_t> & result) const
+{
+    GISMO_ASSERT(u.rows() == 2, "Expecting points in the plane as columns");
+    const index_t n = u.cols();
+    result.resize(n);
+
+#   pragma omp parallel for
+    for (index_t i = 0; i < n; ++i)
+    {
+        const T x = u(0,i), y = u(1,i);
+        if (cellOf(x, y) < 0)
+            result[i] = 0;
+        else if (nearBoundary(x, y))
+            result[i] = -1;
+        else
+            result[i] = insidePolygon(x, y) ? 1 : 0;
+    }
+
+    std::vector<index_t> ind;
+    for (index_t i = 0; i < n; ++i)
+        if (result[i] < 0)
+            ind.push_back(i);
+    if (!ind.empty())
+        exactTest(u, ind, result);
+    return ind.size();
+}
+
+template<class T>
+void gsPlanarDomainClassifier<T>::exactTest(gsMatrix<T> const & u, const std::vector<index_t> & ind,
+                                            gsVector<index_t> & result) const
+{
+    const index_t m = ind.size();
+    if (m_loops.empty())
+    {
+        for (index_t k = 0; k < m; ++k)
+            result[ind[k]] = insidePolygon(u(0,ind[k]), u(1,ind[k])) ? 1 : 0;
+        return;
+    }
+
+    // Same as gsPlanarDomain::inDomain: inside the outer loop (odd
+    // number of intersections above the point) and outside all holes
+    std::vector<T> abscissae(m);
+    for (index_t k = 0; k < m; ++k)
+        abscissae[k] = u(0,ind[k]);
+
+    gsBSplineSolver<T> slv;
+    std::vector<std::vector<T> > roots;
+    for (size_t l = 0; l < m_loops.size(); ++l)
+    {
+        slv.allRoots(m_loops[l], roots, 0, abscissae);
+
+#       pragma omp parallel for
+        for (index_t k = 0; k < m; ++k)
+        {
+            const index_t i = ind[k];
+            if (0 == l)
+                result[i] = 1;
+            else if (0 == result[i])
+                continue;
+            index_t count = 0;
+            if (!roots[k].empty())
+            {
+                gsMatrix<T> e;
+                m_loops[l].eval_into(gsAsMatrix<T>(roots[k], 1, roots[k].size()), e);
+                for (index_t r = 0; r != e.cols(); ++r)
+                    if (e(1,r) > u(1,i))
+                        ++count;
+            }
+            if ( (0 == l) == (0 == count % 2) )
+                result[i] = 0;
+        }
+    }
+}
+
+} // namespace gismo
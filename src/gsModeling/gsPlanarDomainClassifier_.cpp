@@ -0,0 +1,11 @@
+#include <gsCore/gsTemplateTools.h>
+
+#include <gsModeling/gsPlanarDomainClassifier.h>
+#include <gsModeling/gsPlanarDomainClassifier.hpp>
+
+namespace gismo
+{
+
+CLASS_TEMPLATE_INST gsPlanarDomainClassifier<real_t> ;
+
+}
@@ -21,6 +21,11 @@ namespace gismo
 /**
    \brief Computes a parametrization based on the spring patch
    technique, given a set of boundary geometries.
+
+   The spring system is symmetric positive definite and depends only
+   on the sizes of the tensor-product basis of the patch. Its
+   Cholesky factorization is kept and reused as long as subsequent
+   patches have the same basis sizes.
 */
 template <typename T>
 class gsSpringPatch : public gsPatchGenerator<T>
@@ -42,6 +47,9 @@ public:
     gsSpringPatch(const gsMultiPatch<T> & boundary): Base(boundary)
     { }
 
+    /// Empty constructor, the boundaries are given to compute(boundary)
+    gsSpringPatch() { }
+
 public:
 
     /// \brief Main routine that performs the computation
@@ -57,6 +65,12 @@ protected:
    
     using Base::m_result;
 
+    /// Basis sizes of the currently factorized spring system
+    gsVector<index_t> m_sizes;
+
+    /// Cholesky factorization of the spring system
+    typename gsSparseSolver<T>::SimplicialLDLT m_solver;
+
 }; // gsSpringPatch
 
 
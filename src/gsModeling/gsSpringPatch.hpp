@@ -67,6 +67,15 @@ void gsSpringPatch<T>::compute_impl()
         return;
     }
 
+    // The spring system depends only on the basis sizes, it is
+    // assembled and factorized only if these differ from the sizes of
+    // the previous patch
+    const bool newSystem = ( m_sizes.size() != static_cast<index_t>(d) ||
+                             m_sizes != stride );
+    if ( newSystem )
+        m_sizes.resize(0); // invalidated until the factorization succeeds
+    const gsVector<index_t,d> sizes = stride;
+
     // Compute the tensor strides
     resultBasis.stride_cwise(stride);
 
@@ -79,10 +88,13 @@ void gsSpringPatch<T>::compute_impl()
     mapper.finalize();
 
     // Sparse system
-    gsSparseMatrix<T> A(mapper.freeSize(), mapper.freeSize() );
+    gsSparseMatrix<T> A;
     gsMatrix<T> b(mapper.freeSize(), coefs.cols() );
-    A.reserve( gsVector<int>::Constant(A.cols(), 2*d) );
-    A.setZero();
+    if ( newSystem )
+    {
+        A.resize(mapper.freeSize(), mapper.freeSize() );
+        A.reserve( gsVector<int>::Constant(A.cols(), 2*d) );
+    }
     b.setZero();
 
     const T dd = 2*d;
@@ -96,7 +108,8 @@ void gsSpringPatch<T>::compute_impl()
         if ( !mapper.is_free_index(ii))
             continue;
 
-        A(ii,ii) = dd;
+        if ( newSystem )
+            A(ii,ii) = dd;
 
         for ( unsigned k = 0; k<d; k++ ) // for all neighbors
         {
@@ -106,18 +119,28 @@ void gsSpringPatch<T>::compute_impl()
                 const index_t jj = mapper.index(j,0);// get j-index in the matrix
 
                 if ( mapper.is_free_index(jj) ) // interior node ?
-                    A(ii,jj) = -1;
+                {
+                    if ( newSystem )
+                        A(ii,jj) = -1;
+                }
                 else // boundary node
                     b.row(ii) += coefs.row(j);
             }
         }
     }
 
-    A.makeCompressed();
+    // Factorize the (SPD) system
+    if ( newSystem )
+    {
+        A.makeCompressed();
+        m_solver.compute(A);
+        GISMO_ENSURE(m_solver.info() == Eigen::Success,
+                     "Factorization of the spring system failed.");
+        m_sizes = sizes;
+    }
 
     // Solve system
-    typename gsSparseSolver<T>::QR  solver(A);
-    gsMatrix<T> solution = solver.solve ( b );
+    gsMatrix<T> solution = m_solver.solve ( b );
 
     // Fill in interior coefficients
     for ( int i = 0; i<sz; i++ )
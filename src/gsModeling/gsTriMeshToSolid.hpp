@@ -26,43 +26,41 @@ namespace gismo
 template <class T>
 void gsTriMeshToSolid<T>::calcPatchNumbers()
 {
-    // determine which faces form a big face
-    std::vector<int> added;
-    for (std::vector<int>::size_type i=0;i!=face.size();i++)
-        added.push_back(0);
+    // determine which faces form a big face: faces which share an
+    // edge that is not sharp are joined (union-find with path halving,
+    // the root of each set is its face of smallest index)
+    const index_t nf = face.size();
+    std::vector<index_t> root(nf);
+    for (index_t i=0;i<nf;i++)
+        root[i]=i;
+
+    for(typename std::vector<Edge>::iterator iter(edge.begin());iter!=edge.end();++iter)
+    {
+        if(iter->nFaces.size()!=2 || iter->sharp!=0)
+            continue;
+        index_t a=iter->nFaces[0]->getId(), b=iter->nFaces[1]->getId();
+        while(root[a]!=a) { root[a]=root[root[a]]; a=root[a]; }
+        while(root[b]!=b) { root[b]=root[root[b]]; b=root[b]; }
+        if(a<b)      root[b]=a;
+        else if(b<a) root[a]=b;
+    }
+
+    // number the big faces in the order of their first face
+    std::vector<int> number(nf,0);
     numBigFaces=0;
-    std::stack<FaceHandle> faceCollect;
-    FaceHandle tempFace;
-    for( typename std::vector<FaceHandle >::iterator it(face.begin());it!=face.end();++it)
+    for(index_t i=0;i<nf;i++)
     {
-        if (added[(**it).getId()]==0&&
-                *((**it).vertices[0])!=*((**it).vertices[1])&&
-                *((**it).vertices[2])!=*((**it).vertices[1])&&
-                *((**it).vertices[0])!=*((**it).vertices[2]))
+        FaceHandle f=face[i];
+        if (*(f->vertices[0])!=*(f->vertices[1])&&
+            *(f->vertices[2])!=*(f->vertices[1])&&
+            *(f->vertices[0])!=*(f->vertices[2]))
         {
-            numBigFaces++;
-            faceCollect.push(*it);
-            while(!faceCollect.empty())
-            {
-                (*(faceCollect.top())).faceIdentity=numBigFaces;
-                added[(*(faceCollect.top())).getId()]=1;
-                tempFace=faceCollect.top();
-                faceCollect.pop();
-
-                for (size_t i =0;i<(*tempFace).nFaces.size();i++)
-                {
-                    if(added[tempFace->nFaces[i]->getId()]==0)
-                    {
-                        int k=0;
-                        while((*(tempFace->nFaces[i])!=*(edge[tempFace->nEdges[k]->getId()].nFaces[0])&&
-                               ((edge[tempFace->nEdges[k]->getId()].nFaces.size()==1)||
-                              *(tempFace->nFaces[i])!=*(edge[tempFace->nEdges[k]->getId()].nFaces[1]))))
-                            k++;
-                        if (edge[tempFace->nEdges[k]->getId()].sharp==0)
-                            faceCollect.push((*tempFace).nFaces[i]);
-                    }
-                }
-            }
+            index_t r=f->getId();
+            while(root[r]!=r)
+                r=root[r];
+            if(number[r]==0)
+                number[r]=++numBigFaces;
+            f->faceIdentity=number[r];
         }
     }
 }
@@ -86,15 +84,16 @@ void gsTriMeshToSolid<T>::getFeatures(T angleGrad,bool& bWarnNonManifold,bool& b
             if (*p0!=*p1)
             {
                 if ( Xless<T>(p0,p1) ) std::swap(p0,p1);
-                //Edge tempEdge;
-                //tempEdge=Edge(p0,p1);
-                //insertObject<Edge >(tempEdge,edge);
-                edge.push_sorted_unique( Edge(p0,p1) );
+                edge.push_unsorted( Edge(p0,p1) );
             }
             else
                 gsWarn<<"face "<<it<<" has 2 common vertices"<<"\n"<<*p0<<*p1<<"\n";
         }
     }
+    // sort once and keep the first of the equal edges
+    std::stable_sort(edge.begin(),edge.end());
+    edge.erase(std::unique(edge.begin(),edge.end()),edge.end());
+    edge.SetSorted(true);
 
     numEdges=edge.size();
     //number the edges
@@ -130,30 +129,19 @@ void gsTriMeshToSolid<T>::getFeatures(T angleGrad,bool& bWarnNonManifold,bool& b
     }
 
     // Extract those edges whose adjacent triangles form a large angle
-    for(typename std::vector<Edge>::iterator iter(edge.begin());iter!=edge.end();++iter)
+    const index_t ne=edge.size();
+#   pragma omp parallel for
+    for(index_t j=0;j<ne;j++)
     {
-        std::vector<FaceHandle > vT;
-        for (size_t i=0;i<iter->nFaces.size();i++)
-        {
-            vT.push_back(iter->nFaces[i]);
-        }
-        if(vT.size()==1)
+        Edge & e=edge[j];
+        if(e.nFaces.size()!=2)
         {
-            bWarnBorders=true;
-            iter->sharp=1;
-            continue;
-        }
-        if(vT.size()>2)
-        {
-            bWarnNonManifold=true;
-            gsWarn<<"non manifold edge"<<"\n";
-            iter->sharp=1;
+            e.sharp=1;
             continue;
         }
-        GISMO_ASSERT(vT.size()==2, "Edge must belong to two triangles, got "<<vT.size() );
-        gsVector3d<T> nv0((*vT[0]).orthogonalVector());
+        gsVector3d<T> nv0(e.nFaces[0]->orthogonalVector());
         nv0 = nv0/(math::sqrt(nv0.squaredNorm()));
-        gsVector3d<T> nv1((*vT[1]).orthogonalVector());
+        gsVector3d<T> nv1(e.nFaces[1]->orthogonalVector());
         nv1 = nv1/(math::sqrt(nv1.squaredNorm()));
         T cosPhi( nv0.dot(nv1) );
         // Numerical robustness
@@ -163,9 +151,27 @@ void gsTriMeshToSolid<T>::getFeatures(T angleGrad,bool& bWarnNonManifold,bool& b
         const T PI_(3.14159);
         T phiGrad(math::acos(cosPhi)/PI_*180);
         if(phiGrad>=angleGrad)
-            iter->sharp=1;
+            e.sharp=1;
         else
-            iter->sharp=0;
+            e.sharp=0;
+    }
+
+    // store the neighboring faces
+    for(typename std::vector<Edge>::iterator iter(edge.begin());iter!=edge.end();++iter)
+    {
+        const std::vector<FaceHandle > & vT = iter->nFaces;
+        if(vT.size()==1)
+        {
+            bWarnBorders=true;
+            continue;
+        }
+        if(vT.size()>2)
+        {
+            bWarnNonManifold=true;
+            gsWarn<<"non manifold edge"<<"\n";
+            continue;
+        }
+        GISMO_ASSERT(vT.size()==2, "Edge must belong to two triangles, got "<<vT.size() );
 
         (*face[(*vT[0]).getId()]).nFaces.push_back(face[(*vT[1]).getId()]);
         (*face[(*vT[1]).getId()]).nFaces.push_back(face[(*vT[0]).getId()]);
@@ -193,14 +199,29 @@ void gsTriMeshToSolid<T>::setSharpEdges(std::vector< gsEdge<T> > & featEdges, in
                 edge[i].sharp=0;
             }
         }
+        // the edges sorted by the x-coordinate of their source, an
+        // edge can only be approximately equal to a feature edge if
+        // the sources are closer than the tolerance in x-direction
+        // (the search window is taken twice as large, to be safe from
+        // round-off)
+        std::vector<std::pair<T,size_t> > xsorted;
+        xsorted.reserve(edge.size());
+        for(size_t j=0;j<edge.size();j++)
+            xsorted.push_back(std::make_pair(edge[j].source->x(),j));
+        std::sort(xsorted.begin(),xsorted.end());
+
         for(size_t i=0;i<featEdges.size();i++)
         {
             bool foundEdge=0;
-            for(size_t j=0;j<edge.size();j++)
+            const T epsilon= calcDist(featEdges[i].source, featEdges[i].target ) * 0.01 ;
+            const T x=featEdges[i].source->x();
+            for(typename std::vector<std::pair<T,size_t> >::const_iterator it=
+                    std::lower_bound(xsorted.begin(),xsorted.end(),std::make_pair(x-2*epsilon,(size_t)0));
+                it!=xsorted.end() && it->first<x+2*epsilon;++it)
             {
-                if(approxEqual(featEdges[i],edge[j])==1)
+                if(approxEqual(featEdges[i],edge[it->second])==1)
                 {
-                    edge[j].sharp=1;
+                    edge[it->second].sharp=1;
                     foundEdge=1;
                 }
             }
@@ -222,14 +243,19 @@ template <class T>
 void gsTriMeshToSolid<T>::storeNeighboringFaces()
 {
     //store information about the neighboring faces of each edge in the edges
-    for (typename std::vector<Edge >::iterator it(edge.begin());it!=edge.end();++it)
+    const index_t ne=edge.size();
+#   pragma omp parallel for
+    for (index_t j=0;j<ne;j++)
     {
-        if ((*it).nFaces[0]->faceIdentity==(*it).nFaces[1]->faceIdentity)
-            (*it).numPatches.push_back((*it).nFaces[0]->faceIdentity);
+        Edge & e=edge[j];
+        if (e.nFaces.empty())
+            continue;
+        if (e.nFaces.size()==1 || e.nFaces[0]->faceIdentity==e.nFaces[1]->faceIdentity)
+            e.numPatches.push_back(e.nFaces[0]->faceIdentity);
         else
         {
-            (*it).numPatches.push_back((*it).nFaces[0]->faceIdentity);
-            (*it).numPatches.push_back((*it).nFaces[1]->faceIdentity);
+            e.numPatches.push_back(e.nFaces[0]->faceIdentity);
+            e.numPatches.push_back(e.nFaces[1]->faceIdentity);
         }
     }
 }
@@ -239,13 +265,19 @@ template <class T>
 void gsTriMeshToSolid<T>::divideAndMergePatches(T innerAngle, T patchAreaWeight, T mergeSmallPatches)
 {
     //calculate areas of the patches
+    const index_t nf=face.size();
+    std::vector<T > faceAreas(nf);
+#   pragma omp parallel for
+    for (index_t i=0;i<nf;i++)
+        faceAreas[i]=calcArea(face[i]);
+
     std::vector<T > areas;
     for (int i=0;i<numBigFaces;i++)
         areas.push_back(0);
-    for (size_t i=0;i<face.size();i++)
+    for (index_t i=0;i<nf;i++)
     {
         if(face[i]->faceIdentity>0&&face[i]->faceIdentity<=numBigFaces)
-            areas[face[i]->faceIdentity-1]+=calcArea(face[i]);
+            areas[face[i]->faceIdentity-1]+=faceAreas[i];
     }
     T totalArea=0;
     for(size_t i=0;i<areas.size();i++)
@@ -254,9 +286,11 @@ void gsTriMeshToSolid<T>::divideAndMergePatches(T innerAngle, T patchAreaWeight,
         totalArea+=areas[i];
     }
     T averageArea=totalArea/areas.size();
-    for(size_t j=0;j<edge.size();j++)
+    const index_t ne=edge.size();
+#   pragma omp parallel for
+    for(index_t j=0;j<ne;j++)
     {
-        if(edge[j].numPatches.size()==1)
+        if(edge[j].numPatches.size()==1 && edge[j].nFaces.size()==2)
         {
 
             if(areas[edge[j].numPatches[0]-1]>averageArea*patchAreaWeight)
@@ -289,7 +323,8 @@ void gsTriMeshToSolid<T>::divideAndMergePatches(T innerAngle, T patchAreaWeight,
     gsDebug<<"Feature lines after dividing patches: "<<i2<<"\n";
     if(mergeSmallPatches!=0)
     {
-        for(size_t j=0;j<edge.size();j++)
+#       pragma omp parallel for
+        for(index_t j=0;j<ne;j++)
         {
             if(edge[j].numPatches.size()==2)
             {
@@ -633,13 +668,19 @@ void gsTriMeshToSolid<T>::toSolid(gsSolid<T> & sl, std::vector<std::vector<Verte
     }
     gsDebug<<"generated loops"<<'\n';
     // calculate areas of the Patches - in case we need to add extra points
+    const index_t nf=face.size();
+    std::vector<T > faceAreas(nf);
+#   pragma omp parallel for
+    for (index_t i=0;i<nf;i++)
+        faceAreas[i]=calcArea(face[i]);
+
     std::vector<T > areas;
     for (int i=0;i<numBigFaces;i++)
         areas.push_back(0);
-    for (size_t i=0;i<face.size();i++)
+    for (index_t i=0;i<nf;i++)
     {
         if(face[i]->faceIdentity>0&&face[i]->faceIdentity<=numBigFaces)
-            areas[face[i]->faceIdentity-1]+=calcArea(face[i]);
+            areas[face[i]->faceIdentity-1]+=faceAreas[i];
     }
 
     T maxArea=0;
@@ -236,14 +236,15 @@ template <class T>
 memory::unique_ptr<gsMesh<T> > gsTrimSurface<T>::toMesh(int npoints) const
 {
     typename gsMesh<T>::uPtr msh = m_domain->toMesh(npoints);
-    gsMatrix<T> tmp;
-
-    // For all vertices of the msh, push forward the value by m_surface
-    for (size_t i = 0; i!= msh->numVertices(); ++i)
-    {
-        m_surface->eval_into( msh->vertex(i).topRows(2), tmp );
-        msh->vertex(i).topRows(m_surface->geoDim() ) = tmp;
-    }
+    const index_t nv = msh->numVertices();
+    gsMatrix<T> uv(2, nv), tmp;
+
+    // Push forward all the vertices of the msh by m_surface at once
+    for (index_t i = 0; i!= nv; ++i)
+        uv.col(i) = msh->vertex(i).topRows(2);
+    m_surface->eval_into( uv, tmp );
+    for (index_t i = 0; i!= nv; ++i)
+        msh->vertex(i).topRows(m_surface->geoDim() ) = tmp.col(i);
 
     return msh;
 }
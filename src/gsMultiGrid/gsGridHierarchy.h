@@ -38,7 +38,8 @@ public:
     ///
     /// @param mBasis                    The gsMultiBasis to be refined (initial basis)
     /// @param boundaryConditions        The boundary conditions
-    /// @param assemblerOptions          A gsOptionList defining a "DirichletStrategy" and a "InterfaceStrategy"
+    /// @param assemblerOptions          A gsOptionList defining a "DirichletStrategy", a "InterfaceStrategy"
+    ///                                  and optionally a "DofOrdering"
     /// @param levels                    The number of levels
     /// @param numberOfKnotsToBeInserted The number of knots to be inserted, defaulted to 1
     /// @param multiplicityOfKnotsToBeInserted The multiplicity of the knots to be inserted, defaulted to 1
@@ -81,7 +82,8 @@ public:
     ///
     /// @param mBasis                    The gsMultiBasis to be coarsened (initial basis)
     /// @param boundaryConditions        The boundary conditions
-    /// @param assemblerOptions          A gsOptionList defining a "DirichletStrategy" and a "InterfaceStrategy"
+    /// @param assemblerOptions          A gsOptionList defining a "DirichletStrategy", a "InterfaceStrategy"
+    ///                                  and optionally a "DofOrdering"
     /// @param levels                    The maximum number of levels
     /// @param degreesOfFreedom          Number of dofs in the coarsest grid in the grid hierarchy
     ///
@@ -123,6 +125,7 @@ public:
         gsOptionList opt;
         opt.addInt( "DirichletStrategy", "Method for enforcement of Dirichlet BCs [11..14]", 11 );
         opt.addInt( "InterfaceStrategy", "Method of treatment of patch interfaces [0..3]", 1  );
+        opt.addInt( "DofOrdering", "Ordering of the free DoFs (0: natural, 1: reverse Cuthill-McKee, 2: space-filling curve)", 0 );
         opt.addInt( "Levels", "Number of levels to be constructed in the grid hierarchy", 3 );
         opt.addInt( "DegreesOfFreedom",   "Number of dofs in the coarsest grid in the grid hierarchy (only buildByCoarsening)", 0 );
         opt.addInt( "NumberOfKnotsToBeInserted", "The number of knots to be inserted (only buildByRefinement)", 1 );
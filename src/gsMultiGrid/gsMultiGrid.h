@@ -16,6 +16,7 @@
 #include <gsCore/gsForwardDeclarations.h>
 #include <gsSolver/gsPreconditioner.h>
 #include <gsIO/gsOptionList.h>
+#include <gsUtils/gsProfiler.h>
 
 namespace gismo
 {
@@ -151,7 +152,10 @@ public:
     void multiGridStep(index_t level, const gsMatrix<T>& rhs, gsMatrix<T>& x) const;
 
     void step(const gsMatrix<T>& rhs, gsMatrix<T>& x) const
-    { multiGridStep(finestLevel(), rhs, x); }
+    {
+        GISMO_PROFILE("gsMultiGridOp::step");
+        multiGridStep(finestLevel(), rhs, x);
+    }
 
     void stepT(const gsMatrix<T>& rhs, gsMatrix<T>& x) const
     {
@@ -147,6 +147,7 @@ void gsMultiGridOp<T>::multiGridStep(index_t level, const gsMatrix<T>& rhs, gsMa
 
     if (level == 0)
     {
+        GISMO_PROFILE("coarseSolve");
         solveCoarse(rhs, x);
     }
     else
@@ -18,4 +18,8 @@ namespace gismo
 
 CLASS_TEMPLATE_INST gsMultiGridOp<real_t>;
 
+#ifdef GISMO_FLOAT_INSTANCES
+CLASS_TEMPLATE_INST gsMultiGridOp<float>;
+#endif
+
 }
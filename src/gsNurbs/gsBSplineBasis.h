@@ -209,6 +209,11 @@ public:
     // Look at gsBasis class for a description
     void active_into(const gsMatrix<T> & u, gsMatrix<index_t>& result) const;
 
+    /// @brief Same as active_into, for the points given as a (possibly
+    /// strided) row view, eg. a row of a matrix of d-dimensional points,
+    /// which is not copied
+    void activeRow_into(typename gsMatrix<T>::constRowRef & u, gsMatrix<index_t>& result) const;
+
     // Look at gsBasis class for a description
     bool isActive(const index_t i, const gsVector<T> & u) const;
 
@@ -238,6 +243,10 @@ public:
     // Look at gsBasis class for a description
     virtual void eval_into(const gsMatrix<T> & u, gsMatrix<T>& result) const;
 
+    /// @brief Same as eval_into, for the points given as a (possibly
+    /// strided) row view, which is not copied
+    void evalRow_into(typename gsMatrix<T>::constRowRef & u, gsMatrix<T>& result) const;
+
     // Look at gsBasis class for a description
     virtual void evalSingle_into(index_t i, const gsMatrix<T> & u, gsMatrix<T>& result) const;
 
@@ -247,6 +256,10 @@ public:
     // Look at gsBasis class for a description
     void deriv_into(const gsMatrix<T> & u, gsMatrix<T>& result ) const ;
 
+    /// @brief Same as deriv_into, for the points given as a (possibly
+    /// strided) row view, which is not copied
+    void derivRow_into(typename gsMatrix<T>::constRowRef & u, gsMatrix<T>& result ) const ;
+
     // Look at gsBasis class for a description
     void derivSingle_into(index_t i, const gsMatrix<T> & u, gsMatrix<T>& result ) const ;
 
@@ -302,6 +315,11 @@ public:
     virtual void evalAllDers_into(const gsMatrix<T> & u, int n,
                                   std::vector<gsMatrix<T> >& result) const;
 
+    /// @brief Same as evalAllDers_into, for the points given as a
+    /// (possibly strided) row view, which is not copied
+    void evalAllDersRow_into(typename gsMatrix<T>::constRowRef & u, int n,
+                             std::vector<gsMatrix<T> >& result) const;
+
     // Look at gsBasis class for a description
     virtual void evalAllDersSingle_into(index_t i, const gsMatrix<T> & u,
                                         int n, gsMatrix<T>& result) const;
@@ -103,6 +103,13 @@ void gsTensorBSplineBasis<1,T>::matchWith(const boundaryInterface & bi,
 template <class T>
 void gsTensorBSplineBasis<1,T>::active_into(const gsMatrix<T>& u,
                                             gsMatrix<index_t>& result ) const
+{
+    activeRow_into(u.row(0), result);
+}
+
+template <class T>
+void gsTensorBSplineBasis<1,T>::activeRow_into(typename gsMatrix<T>::constRowRef & u,
+                                               gsMatrix<index_t>& result ) const
 {
     result.resize(m_p+1, u.cols());
 
@@ -235,6 +242,13 @@ index_t gsTensorBSplineBasis<1,T>::twin(index_t i) const
 
 template <class T>
 void gsTensorBSplineBasis<1,T>::eval_into(const gsMatrix<T> & u, gsMatrix<T>& result) const
+{
+    evalRow_into(u.row(0), result);
+}
+
+template <class T>
+void gsTensorBSplineBasis<1,T>::evalRow_into(typename gsMatrix<T>::constRowRef & u,
+                                             gsMatrix<T>& result) const
 {
     result.resize(m_p+1, u.cols() );
 
@@ -572,7 +586,13 @@ template <class T> inline
 void gsTensorBSplineBasis<1,T>::deriv_into(const gsMatrix<T> & u, gsMatrix<T>& result ) const
 {
     GISMO_ASSERT( u.rows() == 1 , "gsBSplineBasis accepts points with one coordinate.");
+    derivRow_into(u.row(0), result);
+}
 
+template <class T>
+void gsTensorBSplineBasis<1,T>::derivRow_into(typename gsMatrix<T>::constRowRef & u,
+                                              gsMatrix<T>& result ) const
+{
     const int pk = m_p-1 ;
     const int p1 = m_p + 1;       // degree plus one
     STACK_ARRAY(T, ndu  , m_p);
@@ -867,11 +887,19 @@ template <class T>
 void gsTensorBSplineBasis<1,T>::
 evalAllDers_into(const gsMatrix<T> & u, int n,
                  std::vector<gsMatrix<T> >& result) const
+{
+    GISMO_ASSERT( u.rows() == 1 , "gsBSplineBasis accepts points with one coordinate.");
+    evalAllDersRow_into(u.row(0), n, result);
+}
+
+template <class T>
+void gsTensorBSplineBasis<1,T>::
+evalAllDersRow_into(typename gsMatrix<T>::constRowRef & u, int n,
+                    std::vector<gsMatrix<T> >& result) const
 {
     // TO DO : Use less memory proportionally to n
     // Only last n+1 columns and last n rows of ndu are needed
     // Also a's size is proportional to n
-    GISMO_ASSERT( u.rows() == 1 , "gsBSplineBasis accepts points with one coordinate.");
 
     const int p1 = m_p + 1;       // degree plus one
 
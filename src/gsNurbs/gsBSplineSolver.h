@@ -151,6 +151,24 @@ public:
         //gsLog<< "gsBSplineSolver: found "<< result.size() <<" roots.\n  ";
     }
 
+    /// \brief Computes all the roots of the equations bsp(coord) = tr[i],
+    /// for many level values \a tr at once; result[i] holds the roots
+    /// for the value tr[i]. The levels are processed in parallel, every
+    /// thread using its own solver (the state of this solver is not
+    /// used).
+    void allRoots (gsBSpline<T> const & bsp, std::vector<std::vector<T> > & result,
+                   int const & coord, std::vector<T> const & tr,
+                   T const & tol = 1e-7, unsigned const & N=100);
+
+    /// \brief Computes all the roots of the equations curves[i](coord) = tr,
+    /// for many curves at once; result[i] holds the roots of
+    /// curves[i]. The curves are processed in parallel, every thread
+    /// using its own solver (the state of this solver is not used).
+    void allRoots (std::vector<const gsBSpline<T>*> const & curves,
+                   std::vector<std::vector<T> > & result,
+                   int const & coord = 0, T const & tr = 0,
+                   T const & tol = 1e-7, unsigned const & N=100);
+
 private:
     /// Initialize the solver with B-spline data
     void initSolver(gsBSpline<T> const & bsp , int const & coord, 
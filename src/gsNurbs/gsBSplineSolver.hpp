@@ -28,8 +28,10 @@ int gsBSplineSolver<T>::insertKnot(int mu)
 
     while ( x>=m_t[mu+1]) mu++;
 
-    // make room for one coefficient at position mu
-    m_c.insert(m_c.begin()+mu,0);
+    // make room for one coefficient at position mu (the old
+    // coefficient mu is needed by the update below)
+    const T cmu = m_c[mu];
+    m_c.insert(m_c.begin()+mu,cmu);
     //for ( int i=m_n; i>mu; i--) m_c[i] = m_c[i-1];
 
     // Compute new coefficients
@@ -127,6 +129,44 @@ bool gsBSplineSolver<T>::nextRoot()
     return true;
 }
 
+template<class T>
+void gsBSplineSolver<T>::allRoots(gsBSpline<T> const & bsp,
+                                  std::vector<std::vector<T> > & result,
+                                  int const & coord, std::vector<T> const & tr,
+                                  T const & tol, unsigned const & N)
+{
+    const index_t nl = tr.size();
+    result.resize(nl);
+
+#pragma omp parallel
+    {
+        gsBSplineSolver<T> slv; // thread-private solver state
+
+#pragma omp for schedule(dynamic)
+        for ( index_t i = 0; i < nl; ++i )
+            slv.allRoots(bsp, result[i], coord, tr[i], tol, N);
+    }//omp parallel
+}
+
+template<class T>
+void gsBSplineSolver<T>::allRoots(std::vector<const gsBSpline<T>*> const & curves,
+                                  std::vector<std::vector<T> > & result,
+                                  int const & coord, T const & tr,
+                                  T const & tol, unsigned const & N)
+{
+    const index_t nc = curves.size();
+    result.resize(nc);
+
+#pragma omp parallel
+    {
+        gsBSplineSolver<T> slv; // thread-private solver state
+
+#pragma omp for schedule(dynamic)
+        for ( index_t i = 0; i < nc; ++i )
+            slv.allRoots(*curves[i], result[i], coord, tr, tol, N);
+    }//omp parallel
+}
+
 enum Position
 {
     // new scheme
@@ -221,7 +221,7 @@ public:
     /// \param u evaluation points
     /// \param low lower left corner of the box
     /// \param upp upper right corner of the box
-    void active_cwise(const gsMatrix<T> & u, gsVector<index_t,d>& low,
+    void active_cwise(typename gsMatrix<T>::constRef & u, gsVector<index_t,d>& low,
                       gsVector<index_t,d>& upp ) const;
 
     /// Prints the object as a string.
@@ -479,6 +479,18 @@ private:
         }
     }
 
+protected:
+
+    // Look at gsTensorBasis class for a description
+    void evalCwise_into(short_t k, const gsMatrix<T> & u,
+                        gsMatrix<T> & result) const
+    { component(k).evalRow_into(u.row(k), result); }
+
+    // Look at gsTensorBasis class for a description
+    void evalAllDersCwise_into(short_t k, const gsMatrix<T> & u, int n,
+                               std::vector<gsMatrix<T> > & result) const
+    { component(k).evalAllDersRow_into(u.row(k), n, result); }
+
 protected:
 
     /// Coordinate direction, where the basis is periodic (when equal
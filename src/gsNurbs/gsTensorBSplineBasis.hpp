@@ -29,7 +29,7 @@ namespace gismo
 
 template<short_t d, class T>
 void gsTensorBSplineBasis<d,T>::
-active_cwise(const gsMatrix<T> & u, 
+active_cwise(typename gsMatrix<T>::constRef & u,
              gsVector<index_t,d>& low,
              gsVector<index_t,d>& upp ) const
 {
@@ -31,9 +31,9 @@ struct point_load
                int _patch = 0, 
                bool _parametric = true)
     :
-    patch(_patch), value(_value), point(1), parametric(_parametric)
+    patch(_patch), value(1), point(_point), parametric(_parametric)
     { 
-        point[0] = _value;
+        value[0] = _value;
     }
 
     point_load(const gsVector<T> & _point, 
@@ -96,7 +96,7 @@ public:
         m_pointLoads.clear();
     }
 
-    inline pLoad   operator [] (size_t i) const { return m_pointLoads[i]; }
+    inline const pLoad & operator [] (size_t i) const { return m_pointLoads[i]; }
     inline pLoad & operator [] (size_t i) { return m_pointLoads[i]; }
 
     void addLoad(const gsVector<T> & _point, 
@@ -117,6 +117,9 @@ public:
 
     size_t numLoads() const { return  m_pointLoads.size(); }
 
+    const_iterator begin() const { return m_pointLoads.begin(); }
+    const_iterator end()   const { return m_pointLoads.end(); }
+
 private:
 
     plContainer  m_pointLoads; ///< List of Point loads
@@ -16,6 +16,7 @@
 #include <gsCore/gsLinearAlgebra.h>
 #include <gsSolver/gsMatrixOp.h>
 #include <gsIO/gsOptionList.h>
+#include <gsUtils/gsProfiler.h>
 
 namespace gismo
 {
@@ -113,6 +114,7 @@ public:
     /// @param[in,out] x        starting value; the solution is stored in here
     void solve( const VectorType& rhs, VectorType& x )
     {
+        GISMO_PROFILE("gsIterativeSolver::solve");
         if (initIteration(rhs, x)) return;
 
         while (m_num_iter < m_max_iters)
@@ -133,6 +135,7 @@ public:
     /// @param[out]    error_history    the error history is stored here
     void solveDetailed( const VectorType& rhs, VectorType& x, VectorType& error_history )
     {
+        GISMO_PROFILE("gsIterativeSolver::solve");
         if (initIteration(rhs, x))
         {
             error_history.resize(1,1); //VectorType is actually gsMatrix
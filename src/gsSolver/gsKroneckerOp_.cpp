@@ -7,4 +7,8 @@ namespace gismo
 CLASS_TEMPLATE_INST gsKroneckerOp<real_t>;
 CLASS_TEMPLATE_INST gsKroneckerOp<index_t>;
 
+#ifdef GISMO_FLOAT_INSTANCES
+CLASS_TEMPLATE_INST gsKroneckerOp<float>;
+#endif
+
 }
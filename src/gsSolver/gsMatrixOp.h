@@ -14,6 +14,7 @@
 
 #include <gsCore/gsLinearAlgebra.h>
 #include <gsSolver/gsLinearOperator.h>
+#include <gsUtils/gsProfiler.h>
 
 namespace gismo
 {
@@ -72,7 +73,10 @@ public:
     { return uPtr( new gsMatrixOp(give(mat)) ); }
 
     void apply(const gsMatrix<T> & input, gsMatrix<T> & x) const
-    { x.noalias() = m_expr * input; }
+    {
+        GISMO_PROFILE_COUNT(spmv, input.cols());
+        x.noalias() = m_expr * input;
+    }
 
     index_t rows() const
     { return m_expr.rows(); }
@@ -0,0 +1,120 @@
+/** @file gsMixedPrecisionOp.h
+
+    @brief Allows operators of lower precision (eg. float) to be used
+    in solvers of higher precision (eg. double).
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#pragma once
+
+#include <gsSolver/gsMatrixOp.h>
+
+namespace gismo
+{
+
+/** @brief Uses an operator of precision \a LowT as an operator of
+    precision \a T.
+
+    The input is rounded to \a LowT, the wrapped operator is applied,
+    and the result is converted back to \a T. This allows to apply a
+    preconditioner (eg. a multigrid cycle, a fast diagonalization or
+    a sparse factorization) in single precision, which halves the
+    memory traffic, while the outer iteration runs in double
+    precision:
+
+    \code
+    std::vector< gsSparseMatrix<float,RowMajor> > transferF;
+    for (size_t i = 0; i != transfer.size(); ++i)
+        transferF.push_back( transfer[i].cast<float>() );
+    gsMultiGridOp<float>::Ptr mg = gsMultiGridOp<float>::make(A.cast<float>(), transferF);
+    gsConjugateGradient<> cg(A, gsMixedPrecisionOp<real_t,float>::make(mg));
+    cg.solve(rhs, x);
+    \endcode
+
+    The operator is exact up to the precision of \a LowT. Iterative
+    refinement, ie. the gradient method with step size one,
+    \code
+    gsGradientMethod<> ir(A, makeMixedPrecisionSparseLUSolver<float>(A), 1);
+    ir.solve(rhs, x);
+    \endcode
+    recovers the full accuracy of \a T, as long as the factorization
+    in \a LowT is stable.
+
+    \tparam T    precision of the operator
+    \tparam LowT precision of the wrapped operator
+
+    @ingroup Solver
+*/
+template<class T, class LowT = float>
+class gsMixedPrecisionOp GISMO_FINAL : public gsLinearOperator<T>
+{
+public:
+
+    typedef typename gsLinearOperator<LowT>::Ptr LowOpPtr;
+
+    /// Shared pointer for gsMixedPrecisionOp
+    typedef memory::shared_ptr<gsMixedPrecisionOp> Ptr;
+
+    /// Unique pointer for gsMixedPrecisionOp
+    typedef memory::unique_ptr<gsMixedPrecisionOp> uPtr;
+
+    /// Constructor taking the operator of lower precision
+    explicit gsMixedPrecisionOp(LowOpPtr op) : m_op(give(op)) { }
+
+    /// Make function returning a smart pointer
+    static uPtr make(LowOpPtr op) { return uPtr( new gsMixedPrecisionOp(give(op)) ); }
+
+    void apply(const gsMatrix<T> & input, gsMatrix<T> & x) const
+    {
+        const gsMatrix<LowT> in = input.template cast<LowT>();
+        gsMatrix<LowT> out;
+        m_op->apply(in, out);
+        x = out.template cast<T>();
+    }
+
+    index_t rows() const { return m_op->rows(); }
+
+    index_t cols() const { return m_op->cols(); }
+
+    /// Access the operator of lower precision
+    const LowOpPtr & lowPrecisionOp() const { return m_op; }
+
+private:
+    LowOpPtr m_op;
+};
+
+/// @brief Convenience function to create a sparse LU solver which
+/// factorizes and solves in precision \a LowT, as a gsLinearOperator
+/// of precision \a T.
+///
+/// Use as a preconditioner or for iterative refinement, see
+/// gsMixedPrecisionOp.
+///
+/// \ingroup Solver
+template <typename LowT, typename T, int _Opt, typename _Index>
+typename gsMixedPrecisionOp<T,LowT>::uPtr makeMixedPrecisionSparseLUSolver(const gsSparseMatrix<T,_Opt,_Index> & mat)
+{
+    const gsSparseMatrix<LowT,_Opt,_Index> lowMat = mat.template cast<LowT>();
+    return gsMixedPrecisionOp<T,LowT>::make( makeSparseLUSolver(lowMat) );
+}
+
+/// @brief Convenience function to create a sparse Cholesky
+/// (simplicial LDL^T) solver which factorizes and solves in precision
+/// \a LowT, as a gsLinearOperator of precision \a T.
+///
+/// @note Works only on sparse, symmetric (stored in lower half) and
+/// positive definite matrices.
+///
+/// \ingroup Solver
+template <typename LowT, typename T, int _Opt, typename _Index>
+typename gsMixedPrecisionOp<T,LowT>::uPtr makeMixedPrecisionSparseCholeskySolver(const gsSparseMatrix<T,_Opt,_Index> & mat)
+{
+    const gsSparseMatrix<LowT,_Opt,_Index> lowMat = mat.template cast<LowT>();
+    return gsMixedPrecisionOp<T,LowT>::make( makeSparseCholeskySolver(lowMat) );
+}
+
+} // namespace gismo
@@ -118,6 +118,25 @@ public:
         T beta = 1
     );
 
+    /// Same as fastDiagonalizationOp(), but the operator is applied in
+    /// single precision, see gsMixedPrecisionOp
+    ///
+    /// The eigenvalue problems are solved in precision \a T. Applying
+    /// the operator moves half the data. It is meant as a
+    /// preconditioner for a conjugate gradient solver in precision \a T.
+    ///
+    /// \param basis  A tensor basis
+    /// \param bc     Boundary conditions
+    /// \param opt    Assembler options
+    /// \param alpha  Scaling parameter (see fastDiagonalizationOp())
+    static OpUPtr            fastDiagonalizationOpSinglePrecision(
+        const gsBasis<T>& basis,
+        const gsBoundaryConditions<T>& bc = gsBoundaryConditions<T>(),
+        const gsOptionList& opt = gsAssembler<T>::defaultOptions(),
+        T alpha = 0,
+        T beta = 1
+    );
+
     /// Provides \a gsLinearOperator representing the subspace corrected mass smoother
     /// on the parameter domain (SIAM J. on Numerical Analysis. 55 (4). p. 2004 - 2024, 2017)
     ///
@@ -16,6 +16,7 @@
 #include <gsSolver/gsProductOp.h>
 #include <gsSolver/gsKroneckerOp.h>
 #include <gsSolver/gsMatrixOp.h>
+#include <gsSolver/gsMixedPrecisionOp.h>
 #include <gsAssembler/gsExprAssembler.h>
 #include <gsNurbs/gsTensorBSplineBasis.h>
 
@@ -260,22 +261,21 @@ typename gsPatchPreconditionersCreator<T>::OpUPtr gsPatchPreconditionersCreator<
     return K;
 }
 
-template<typename T>
-typename gsPatchPreconditionersCreator<T>::OpUPtr gsPatchPreconditionersCreator<T>::fastDiagonalizationOp(
-    const gsBasis<T>& basis,
-    const gsBoundaryConditions<T>& bc,
-    const gsOptionList& opt,
+namespace {
+
+// Sets up the fast diagonalization operator, with the operators in
+// precision LowT, from the univariate stiffness and mass matrices
+template<typename T, typename LowT>
+typename gsLinearOperator<LowT>::uPtr fastDiagonalization(
+    std::vector< gsSparseMatrix<T> > & local_stiff,
+    const std::vector< gsSparseMatrix<T> > & local_mass,
     T alpha,
     T beta
     )
 {
-    GISMO_ASSERT ( beta != 0, "gsPatchPreconditionersCreator<T>::fastDiagonalizationOp() does not work for beta==0." );
-
-    const index_t d = basis.dim();
+    typedef typename gsLinearOperator<LowT>::Ptr LowOpPtr;
 
-    // Assemble univariate
-    std::vector< gsSparseMatrix<T> > local_stiff = assembleTensorStiffness(basis, bc, opt);
-    std::vector< gsSparseMatrix<T> > local_mass  = assembleTensorMass(basis, bc, opt);
+    const index_t d = local_stiff.size();
 
     if (beta!=0)
     {
@@ -295,13 +295,11 @@ typename gsPatchPreconditionersCreator<T>::OpUPtr gsPatchPreconditionersCreator<
     index_t glob = sz; // Indexing value for setting up the Kronecker product
 
     typedef typename gsMatrix<T>::GenSelfAdjEigenSolver EVSolver;
-    typedef typename EVSolver::EigenvectorsType evMatrix;
     typedef typename EVSolver::RealVectorType evVector;
     EVSolver ges;
 
-    std::vector<OpPtr> Qop(d);
-    std::vector<OpPtr> QTop(d);
-    gsMatrix<T> ev;
+    std::vector<LowOpPtr> Qop(d);
+    std::vector<LowOpPtr> QTop(d);
 
     // Now, setup the Q's and update the D's
     for ( index_t i=0; i<d; ++i )
@@ -323,11 +321,11 @@ typename gsPatchPreconditionersCreator<T>::OpUPtr gsPatchPreconditionersCreator<
                 for ( index_t n=0; n<glob2; ++n )
                     diag( m + l*glob + n*loc*glob, 0 ) += D(l,0);
 
-        // Finally, we store the eigenvectors
-        ev.swap(const_cast<evMatrix&>(ges.eigenvectors()));
+        // Finally, we store the eigenvectors (rounded to LowT)
+        memory::unique_ptr< gsMatrix<LowT> > ev( new gsMatrix<LowT>(ges.eigenvectors().template cast<LowT>()) );
 
         // These are the operators representing the eigenvectors
-        typename gsMatrixOp< gsMatrix<T> >::Ptr matrOp = makeMatrixOp( ev.moveToPtr() );
+        typename gsMatrixOp< gsMatrix<LowT> >::Ptr matrOp = makeMatrixOp( give(ev) );
         Qop [i] = matrOp;
         // Here we are safe as long as we do not want to apply QTop after Qop got destroyed.
         QTop[i] = makeMatrixOp( matrOp->matrix().transpose() );
@@ -338,15 +336,56 @@ typename gsPatchPreconditionersCreator<T>::OpUPtr gsPatchPreconditionersCreator<
     for ( index_t l=0; l<sz; ++l )
         diag( l, 0 ) = 1/diag( l, 0 );
 
-    memory::unique_ptr< Eigen::DiagonalMatrix<T,Dynamic> > diag_mat( new Eigen::DiagonalMatrix<T,Dynamic>( give(diag) ) );
+    memory::unique_ptr< Eigen::DiagonalMatrix<LowT,Dynamic> > diag_mat(
+        new Eigen::DiagonalMatrix<LowT,Dynamic>( diag.template cast<LowT>() ) );
 
-    return gsProductOp<T>::make(
-        gsKroneckerOp<T>::make(QTop),
+    return gsProductOp<LowT>::make(
+        gsKroneckerOp<LowT>::make(QTop),
         makeMatrixOp(give(diag_mat)),
-        gsKroneckerOp<T>::make(Qop)
+        gsKroneckerOp<LowT>::make(Qop)
         );
 }
 
+} // anonymous namespace
+
+template<typename T>
+typename gsPatchPreconditionersCreator<T>::OpUPtr gsPatchPreconditionersCreator<T>::fastDiagonalizationOp(
+    const gsBasis<T>& basis,
+    const gsBoundaryConditions<T>& bc,
+    const gsOptionList& opt,
+    T alpha,
+    T beta
+    )
+{
+    GISMO_ASSERT ( beta != 0, "gsPatchPreconditionersCreator<T>::fastDiagonalizationOp() does not work for beta==0." );
+
+    // Assemble univariate
+    std::vector< gsSparseMatrix<T> > local_stiff = assembleTensorStiffness(basis, bc, opt);
+    std::vector< gsSparseMatrix<T> > local_mass  = assembleTensorMass(basis, bc, opt);
+
+    return fastDiagonalization<T,T>(local_stiff, local_mass, alpha, beta);
+}
+
+template<typename T>
+typename gsPatchPreconditionersCreator<T>::OpUPtr gsPatchPreconditionersCreator<T>::fastDiagonalizationOpSinglePrecision(
+    const gsBasis<T>& basis,
+    const gsBoundaryConditions<T>& bc,
+    const gsOptionList& opt,
+    T alpha,
+    T beta
+    )
+{
+    GISMO_ASSERT ( beta != 0, "gsPatchPreconditionersCreator<T>::fastDiagonalizationOpSinglePrecision() does not work for beta==0." );
+
+    // Assemble univariate
+    std::vector< gsSparseMatrix<T> > local_stiff = assembleTensorStiffness(basis, bc, opt);
+    std::vector< gsSparseMatrix<T> > local_mass  = assembleTensorMass(basis, bc, opt);
+
+    // The eigenvalue problems are solved in precision T
+    return gsMixedPrecisionOp<T,float>::make(
+        fastDiagonalization<T,float>(local_stiff, local_mass, alpha, beta) );
+}
+
 namespace {
 
 // Get the tilde basis
@@ -10,6 +10,11 @@ namespace internal
 TEMPLATE_INST void gaussSeidelSweep(const gsSparseMatrix<real_t> & A, gsMatrix<real_t>& x, const gsMatrix<real_t>& f);
 TEMPLATE_INST void reverseGaussSeidelSweep(const gsSparseMatrix<real_t> & A, gsMatrix<real_t>& x, const gsMatrix<real_t>& f);
 
+#ifdef GISMO_FLOAT_INSTANCES
+TEMPLATE_INST void gaussSeidelSweep(const gsSparseMatrix<float> & A, gsMatrix<float>& x, const gsMatrix<float>& f);
+TEMPLATE_INST void reverseGaussSeidelSweep(const gsSparseMatrix<float> & A, gsMatrix<float>& x, const gsMatrix<float>& f);
+#endif
+
 } // namespace internal
 
 } // namespace gismo
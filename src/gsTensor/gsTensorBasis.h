@@ -19,6 +19,8 @@
 namespace gismo
 {
 
+template<short_t d, class T> class gsTensorBasisEvaluator;
+
 /** 
  *  @brief Abstract base class for tensor product bases.
  *
@@ -207,7 +209,7 @@ public:
     /// \param u evaluation points
     /// \param low lower left corner of the box
     /// \param upp upper right corner of the box
-    void active_cwise(const gsMatrix<T> & u, gsVector<index_t,d>& low,
+    void active_cwise(typename gsMatrix<T>::constRef & u, gsVector<index_t,d>& low,
                       gsVector<index_t,d>& upp ) const;
 
     // Look at gsBasis class for documentation 
@@ -301,15 +303,40 @@ public:
                 );
     }
 
+    // Look at gsBasis class for documentation
+    typename gsBasisEvaluator<T>::uPtr makeEvaluator() const
+    { return typename gsBasisEvaluator<T>::uPtr(new gsTensorBasisEvaluator<d,T>(*this)); }
+
     // Look at gsBasis class for documentation 
     virtual typename gsGeometry<T>::uPtr interpolateAtAnchors(gsMatrix<T> const& vals) const;
 
+    /// Applies interpolation given the parameter values \a pts and
+    /// values \a vals. If the points form a tensor-grid (ordered as
+    /// the tensor-basis coefficients) the computation is delegated to
+    /// interpolateGrid, otherwise the generic gsBasis version is used.
+    virtual typename gsGeometry<T>::uPtr interpolateData(gsMatrix<T> const& vals,
+                                                         gsMatrix<T> const& pts) const;
+
     /// Interpolates values on a tensor-grid of points, given in
     /// tensor form (d coordinate-wise vectors). Samples \a vals
     /// should be ordered as the tensor-basis coefficients
     typename gsGeometry<T>::uPtr interpolateGrid(gsMatrix<T> const& vals,
                                     std::vector<gsMatrix<T> >const& grid) const;
 
+    /// Computes the L2-projection of \a func onto this basis, on the
+    /// parameter domain. The mass matrix is the Kronecker product of
+    /// the coordinate-wise mass matrices, therefore only \a d
+    /// univariate systems are factorized and applied direction by
+    /// direction.
+    typename gsGeometry<T>::uPtr projectL2(gsFunction<T> const& func) const;
+
+    /// Returns true if the points \a pts form a tensor-grid ordered
+    /// as the tensor-basis coefficients (the first coordinate running
+    /// fastest). In this case \a grid contains the coordinate-wise
+    /// vectors of the grid.
+    bool isTensorGrid(gsMatrix<T> const& pts,
+                      std::vector<gsMatrix<T> > & grid) const;
+
     /// Prints the object as a string, pure virtual function of gsTensorBasis.
     virtual std::ostream &print(std::ostream &os) const = 0;
 
@@ -604,6 +631,24 @@ public:
 
     //inline int trueSize(int k) const { return m_bases[k]->trueSize(); }
 
+protected:
+
+    friend class gsTensorBasisEvaluator<d,T>;
+
+    // Evaluates the basis of direction \a k at the \a k-th
+    // coordinates of the points \a u. Derived classes which know the
+    // type of the coordinate bases override this, so that the row
+    // u.row(k) is evaluated without a copy
+    virtual void evalCwise_into(short_t k, const gsMatrix<T> & u,
+                                gsMatrix<T> & result) const
+    { m_bases[k]->eval_into(u.row(k), result); }
+
+    // Evaluates the basis of direction \a k and its derivatives up
+    // to order \a n at the \a k-th coordinates of the points \a u
+    virtual void evalAllDersCwise_into(short_t k, const gsMatrix<T> & u, int n,
+                                       std::vector<gsMatrix<T> > & result) const
+    { m_bases[k]->evalAllDers_into(u.row(k), n, result); }
+
 // Data members
 protected:
 
@@ -614,6 +659,41 @@ protected:
 
 }; // class gsTensorBasis
 
+/**
+ *  @brief Evaluator of a tensor-product basis, which keeps the
+ *  univariate values and derivatives of the coordinate bases between
+ *  calls.
+ *
+ *   \ingroup Tensor
+ */
+template<short_t d, class T>
+class gsTensorBasisEvaluator : public gsBasisEvaluator<T>
+{
+public:
+    explicit gsTensorBasisEvaluator(const gsTensorBasis<d,T> & basis)
+    : gsBasisEvaluator<T>(basis), m_tbasis(&basis)
+    { }
+
+    // Look at gsBasisEvaluator class for documentation
+    void evalAllDers_into(const gsMatrix<T> & u, int n,
+                          std::vector<gsMatrix<T> >& result)
+    { evalAllDers_into(*m_tbasis, u, n, result); }
+
+    /// @brief Same as gsBasis::evalAllDers_into for \a basis, which
+    /// is not necessarily the basis of the evaluator. This allows to
+    /// reuse the memory for several bases, eg. the levels of a
+    /// hierarchical basis.
+    void evalAllDers_into(const gsTensorBasis<d,T> & basis,
+                          const gsMatrix<T> & u, int n,
+                          std::vector<gsMatrix<T> >& result);
+
+private:
+    const gsTensorBasis<d,T> * m_tbasis;
+
+    // Values and derivatives of the coordinate bases
+    std::vector<gsMatrix<T> > m_values[d];
+};
+
 // Next line disallows instantization of gsTensorBasis<0,T>
 template<typename T> class gsTensorBasis<0,T>
 {using T::GISMO_ERROR_gsTensorBasis_cannot_have_dimension_zero;};
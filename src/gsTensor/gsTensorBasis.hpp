@@ -20,6 +20,10 @@
 #include <gsCore/gsBoundary.h>
 #include <gsUtils/gsMesh/gsMesh.h>
 #include <gsCore/gsGeometry.h>
+#include <gsUtils/gsPointGrid.h>
+#include <gsAssembler/gsGaussRule.h>
+#include <gsSolver/gsKroneckerOp.h>
+#include <gsSolver/gsMatrixOp.h>
 //#include <gsUtils/gsSortedVector.h>
 
 
@@ -514,7 +518,7 @@ void gsTensorBasis<d,T>::eval_into(const gsMatrix<T> & u,
     unsigned nb = 1;
     for (short_t i = 0; i < d; ++i)
     {
-        m_bases[i]->eval_into( u.row(i), ev[i] );
+        evalCwise_into(i, u, ev[i]);
         nb *= ev[i].rows();
         size[i] = ev[i].rows();
     }
@@ -602,7 +606,7 @@ void gsTensorBasis<d,T>::deriv_into(const gsMatrix<T> & u,
     for (short_t i = 0; i < d; ++i)
     {
         // evaluate basis functions and their first derivatives
-        m_bases[i]->evalAllDers_into( u.row(i), 1, values[i]); 
+        evalAllDersCwise_into(i, u, 1, values[i]);
 
         // number of basis functions
         const index_t num_i = values[i].front().rows();
@@ -633,6 +637,15 @@ void gsTensorBasis<d,T>::deriv_into(const gsMatrix<T> & u,
 template<short_t d, class T>
 void gsTensorBasis<d,T>::evalAllDers_into(const gsMatrix<T> & u, int n,
                                           std::vector<gsMatrix<T> >& result) const
+{
+    gsTensorBasisEvaluator<d,T> ev(*this);
+    ev.evalAllDers_into(u, n, result);
+}
+
+template<short_t d, class T>
+void gsTensorBasisEvaluator<d,T>::evalAllDers_into(const gsTensorBasis<d,T> & basis,
+                                                   const gsMatrix<T> & u, int n,
+                                                   std::vector<gsMatrix<T> >& result)
 {
     GISMO_ASSERT(n>-2, "gsTensorBasis::evalAllDers() is implemented only for -2<n<=2: -1 means no value, 0 values only, ... " );
     if (n==-1)
@@ -641,7 +654,7 @@ void gsTensorBasis<d,T>::evalAllDers_into(const gsMatrix<T> & u, int n,
         return;
     }
 
-    std::vector< gsMatrix<T> >values[d];
+    std::vector< gsMatrix<T> > * values = m_values;
     gsVector<unsigned, d> v, nb_cwise;
     result.resize(n+1);
 
@@ -649,7 +662,7 @@ void gsTensorBasis<d,T>::evalAllDers_into(const gsMatrix<T> & u, int n,
     for (short_t i = 0; i < d; ++i)
     {
         // evaluate basis functions/derivatives
-        m_bases[i]->evalAllDers_into( u.row(i), n, values[i] ); 
+        basis.evalAllDersCwise_into(i, u, n, values[i]);
       
         // number of basis functions
         const index_t num_i = values[i].front().rows();
@@ -697,7 +710,7 @@ void gsTensorBasis<d,T>::evalAllDers_into(const gsMatrix<T> & u, int n,
 
     if (n>1)
     {
-        deriv2_tp( values, nb_cwise, result[2] );
+        gsTensorBasis<d,T>::deriv2_tp( values, nb_cwise, result[2] );
 
         gsVector<unsigned, d> cc;
         for (int i = 3; i <=n; ++i) // for all orders of derivation
@@ -736,7 +749,7 @@ void gsTensorBasis<d,T>::deriv2_into(const gsMatrix<T> & u,
     unsigned nb = 1;
     for (short_t i = 0; i < d; ++i)
     {
-        m_bases[i]->evalAllDers_into( u.row(i), 2, values[i]); 
+        evalAllDersCwise_into(i, u, 2, values[i]);
         const int num_i = values[i].front().rows();
         nb_cwise[i] = num_i;
         nb     *= num_i;
@@ -896,6 +909,19 @@ gsTensorBasis<d,T>::interpolateAtAnchors(gsMatrix<T> const& vals) const
 }
 
 
+template<short_t d, class T>
+typename gsGeometry<T>::uPtr
+gsTensorBasis<d,T>::interpolateData(gsMatrix<T> const& vals,
+                                    gsMatrix<T> const& pts) const
+{
+    std::vector<gsMatrix<T> > grid;
+    if ( isTensorGrid(pts, grid) )
+        return interpolateGrid(vals,grid);
+
+    return gsBasis<T>::interpolateData(vals,pts);
+}
+
+
 template<short_t d, class T>
 typename gsGeometry<T>::uPtr
 gsTensorBasis<d,T>::interpolateGrid(gsMatrix<T> const& vals,
@@ -904,31 +930,19 @@ gsTensorBasis<d,T>::interpolateGrid(gsMatrix<T> const& vals,
     GISMO_ASSERT (this->size() == vals.cols(), 
                   "Expecting as many values as the number of basis functions." );
 
-    const index_t n  = vals.rows();
-    const int sz = this->size();
-
-    // Note: algorithm relies on col-major matrices    
-    gsMatrix<T, Dynamic, Dynamic, ColMajor> q0, q1;
+    typedef typename gsSparseSolver<T>::LU Solver_t;
 
-    //Note: Sparse LU might fail for rank deficient Cmat
-    typename gsSparseSolver<T>::LU  solver;
+    // Factorize the coordinate-wise collocation matrices; note that
+    // the Kronecker operator expects the last direction first
+    std::vector<typename gsLinearOperator<T>::Ptr> ops(d);
     gsSparseMatrix<T> Cmat;
-
-    // size: sz x n
-    q0 = vals.transpose();
-
     for (short_t i = 0; i < d; ++i) // for all coordinate bases
     {
-        // Re-order right-hand sides
-        const index_t sz_i = m_bases[i]->size();
-        const index_t r_i  = sz / sz_i;
-        q0.resize(sz_i, n * r_i);
-
-        // Solve for i-th coordinate basis
+        //Note: Sparse LU might fail for rank deficient Cmat
         m_bases[i]->collocationMatrix(grid[i], Cmat);
-        solver.compute(Cmat); 
+        typename gsSolverOp<Solver_t>::Ptr solver = makeSparseLUSolver(Cmat);
         #ifndef NDEBUG
-        if ( solver.info() != Eigen::Success )
+        if ( solver->solver().info() != Eigen::Success )
         {
             gsWarn<< "Failed LU decomposition for:\n";//<< Cmat.toDense() <<"\n";
             gsWarn<< "Points:\n"<< grid[i] <<"\n";
@@ -936,16 +950,98 @@ gsTensorBasis<d,T>::interpolateGrid(gsMatrix<T> const& vals,
             return typename gsGeometry<T>::uPtr();
         }
         #endif
-        // Transpose solution component-wise
-        q1.resize(r_i, n * sz_i);
-        for ( index_t k = 0; k!=n; ++k)
-            q1.middleCols(k*sz_i, sz_i) = solver.solve(q0.middleCols(k*r_i,r_i)).transpose();
+        ops[d-1-i] = solver;
+    }
+
+    gsMatrix<T> coefs;
+    gsKroneckerOp<T>::apply(ops, vals.transpose(), coefs);
+    return this->makeGeometry( give(coefs) );
+}
+
+
+template<short_t d, class T>
+typename gsGeometry<T>::uPtr
+gsTensorBasis<d,T>::projectL2(gsFunction<T> const& func) const
+{
+    GISMO_ASSERT (d == func.domainDim(), "Wrong dimension of the function.");
+
+    // Coordinate-wise quadrature nodes, rhs operators and inverse
+    // mass matrices (last direction first, as expected by the
+    // Kronecker operator)
+    std::vector<gsVector<T> > nodes(d);
+    std::vector<typename gsLinearOperator<T>::Ptr> rhsOps(d), massInv(d);
+    std::vector<T> breaks;
+    gsMatrix<T> qNodes;
+    gsVector<T> qWeights;
+    gsSparseMatrix<T> Cmat;
+    for (short_t i = 0; i < d; ++i) // for all coordinate bases
+    {
+        const Basis_t & b = *m_bases[i];
+
+        breaks.clear();
+        typename gsBasis<T>::domainIter domIt = b.makeDomainIterator();
+        breaks.push_back( domIt->lowerCorner().value() );
+        for (; domIt->good(); domIt->next() )
+            breaks.push_back( domIt->upperCorner().value() );
+
+        gsGaussRule<T>(b.maxDegree() + 1).mapToAll(breaks, qNodes, qWeights);
+        nodes[i] = qNodes.transpose();
+
+        // Weighted collocation matrix, M_i = C_i^T W_i C_i
+        b.collocationMatrix(qNodes, Cmat);
+        typename gsSparseMatrix<T>::Ptr WC(new gsSparseMatrix<T>);
+        *WC = qWeights.asDiagonal() * Cmat;
+        const gsSparseMatrix<T> mass = Cmat.transpose() * (*WC);
+        massInv[d-1-i] = makeSparseCholeskySolver(mass);
+
+        typename gsSparseMatrix<T>::Ptr WCt(new gsSparseMatrix<T>(WC->transpose()));
+        rhsOps [d-1-i] = makeMatrixOp(WCt);
+    }
+
+    // Evaluate the function on the tensor-grid of quadrature nodes,
+    // and compute the moments against the basis functions
+    gsMatrix<T> pts, fv, rhs, coefs;
+    gsPointGrid(nodes, pts);
+    func.eval_into(pts, fv);
+    gsKroneckerOp<T>::apply(rhsOps, fv.transpose(), rhs);
+
+    // Solve with the Kronecker-structured mass matrix
+    gsKroneckerOp<T>::apply(massInv, rhs, coefs);
+    return this->makeGeometry( give(coefs) );
+}
+
 
-        q1.swap( q0 ); // move solution as next right-hand side
+template<short_t d, class T>
+bool gsTensorBasis<d,T>::isTensorGrid(gsMatrix<T> const& pts,
+                                      std::vector<gsMatrix<T> > & grid) const
+{
+    if ( pts.rows() != d || pts.cols() != this->size() )
+        return false;
+
+    gsVector<index_t,d> sz, str;
+    str[0] = 1;
+    sz [0] = m_bases[0]->size();
+    for (short_t i = 1; i < d; ++i)
+    {
+        sz [i] = m_bases[i]->size();
+        str[i] = str[i-1] * sz[i-1];
+    }
+
+    grid.resize(d);
+    for (short_t i = 0; i < d; ++i)
+    {
+        grid[i].resize(1, sz[i]);
+        for (index_t k = 0; k != sz[i]; ++k)
+            grid[i].at(k) = pts(i, k * str[i]);
     }
 
-    q0.resize(sz, n);
-    return this->makeGeometry( give(q0) );
+    // Every point must coincide with its grid counterpart
+    for (index_t c = 0; c != pts.cols(); ++c)
+        for (short_t i = 0; i < d; ++i)
+            if ( pts(i,c) != grid[i].at( (c / str[i]) % sz[i] ) )
+                return false;
+
+    return true;
 }
 
 
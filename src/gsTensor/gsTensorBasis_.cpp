@@ -14,4 +14,8 @@ CLASS_TEMPLATE_INST gsTensorBasis<2, real_t  >;
 CLASS_TEMPLATE_INST gsTensorBasis<3, real_t  >;
 CLASS_TEMPLATE_INST gsTensorBasis<4, real_t  >;
 
+CLASS_TEMPLATE_INST gsTensorBasisEvaluator<2, real_t  >;
+CLASS_TEMPLATE_INST gsTensorBasisEvaluator<3, real_t  >;
+CLASS_TEMPLATE_INST gsTensorBasisEvaluator<4, real_t  >;
+
 }
@@ -388,8 +388,9 @@ private:
          * Boundary is constructed from given halfedges.
          * First all halfedges that do not have a twin halfedge contained in the input vector are found.
          * Then the first halfedge is added to the chain.
-         * Step by step the algorithm tries to append a halfedge, non-fitting ones are stored in a queue temporary, until a suitable halfedge is found.
-         * All halfedges are put back together and this procedure repeats until the chain is closed AND all halfedges are appended.
+         * Step by step the algorithm cycles through the remaining halfedges and appends the first one that fits at the end or at the beginning of the chain,
+         * until the chain is closed AND all halfedges are appended. The fitting halfedges are looked up by their vertex indices,
+         * so that the construction takes O(n log n) time for n halfedges.
          *
          * Otherwise a error message is printed, input is not suitable.
          *
@@ -474,6 +475,7 @@ private:
          * @brief Finds halfedges without twin halfedge
          *
          * This private method takes a vector of unordered halfedges and finds the halfedges that do not have a twin halfedge contained in the same vector.
+         * The halfedges are paired with their twins in the order of the input, using a sorted list of their vertex indices.
          *
          * @param[in] allHalfedges const std::vector<Halfedge>& - vector of all halfedges in the mesh
          *
@@ -615,6 +617,7 @@ public:
      * @brief Returns queue of all opposite halfedges of vertex
      * The opposite halfedge of a point in a triangle is meant to be the halfedge lying opposite of the point, e. g. the halfedge in the triangle not containing the point.
      * Therefore all halfedges of triangles containing the vertex are stored in the return queue.
+     * Only the triangles around the vertex are visited, using the vertex-triangle incidence computed in the constructor.
      * Usually the function is used for inner points. By using the second optional input bool value to 0 it can be used for boundary points too.
      * A warning is printed if the vertex is a boundary vertex although the optional bool value was not set to 0.
      * An error message is printed if the vertex index > number of vertices.
@@ -702,6 +705,11 @@ private:
     std::vector<index_t> m_sorting; ///< vector that stores the internVertexIndices s. t. m_sorting[vertexIndex-1] = internVertexIndex
     T m_precision;
 
+    std::vector<size_t> m_vertexGroup;     ///< m_vertexGroup[internVertexIndex] is the group of the vertices with the same coordinates
+    std::vector<size_t> m_triangleStart;   ///< the triangles around the vertices of group g are m_vertexTriangles[m_triangleStart[g]],...,m_vertexTriangles[m_triangleStart[g+1]-1]
+    std::vector<size_t> m_vertexTriangles; ///< indices of the triangles around each group of vertices (compressed, in increasing order)
+    std::vector<bool> m_isBoundary;        ///< m_isBoundary[internVertexIndex] tells whether the vertex is a boundary vertex
+
 
 };//class gsHalfEdgeMesh
 
@@ -48,6 +48,35 @@ gsHalfEdgeMesh<T>::gsHalfEdgeMesh(const gsMesh<T> &mesh, T precision)
         m_halfedges.push_back(getInternHalfedge(this->m_face[i], 3));
     }
 
+    // Vertices with equal coordinates are treated as one vertex when
+    // looking for the triangles around a vertex (cf. isTriangleVertex)
+    const size_t nv = this->m_vertex.size();
+    std::vector<typename gsMesh<T>::gsVertexHandle> byCoords(this->m_vertex.begin(), this->m_vertex.end());
+    std::sort(byCoords.begin(), byCoords.end(), lexCompareVHandle<T>());
+    m_vertexGroup.resize(nv);
+    size_t ng = 0;
+    for (size_t k = 0; k < nv; k++)
+    {
+        if (k > 0 && !(*byCoords[k] == *byCoords[k-1]))
+            ++ng;
+        m_vertexGroup[byCoords[k]->getId()] = ng;
+    }
+    if (nv > 0)
+        ++ng;
+
+    // triangles around each group, in compressed row storage
+    m_triangleStart.assign(ng + 1, 0);
+    for (size_t i = 0; i < this->m_face.size(); i++)
+        for (size_t j = 0; j < 3; j++)
+            ++m_triangleStart[m_vertexGroup[this->m_face[i]->vertices[j]->getId()] + 1];
+    for (size_t g = 0; g < ng; g++)
+        m_triangleStart[g + 1] += m_triangleStart[g];
+    m_vertexTriangles.resize(m_triangleStart[ng]);
+    std::vector<size_t> pos(m_triangleStart.begin(), m_triangleStart.end() - 1);
+    for (size_t i = 0; i < this->m_face.size(); i++)
+        for (size_t j = 0; j < 3; j++)
+            m_vertexTriangles[pos[m_vertexGroup[this->m_face[i]->vertices[j]->getId()]]++] = i;
+
     m_boundary = Boundary(m_halfedges);
     m_n = this->m_vertex.size() - m_boundary.getNumberOfVertices();
     sortVertices();
@@ -195,8 +224,12 @@ gsHalfEdgeMesh<T>::getOppositeHalfedges(const size_t vertexIndex, const bool inn
     }
 
     size_t v1, v2, v3;
-    for (size_t i = 0; i < getNumberOfTriangles(); i++)
+    const size_t group = m_vertexGroup[m_sorting[vertexIndex - 1]];
+    for (size_t t = m_triangleStart[group]; t < m_triangleStart[group + 1]; t++)
     {
+        const size_t i = m_vertexTriangles[t];
+        if (t > m_triangleStart[group] && i == m_vertexTriangles[t - 1])
+            continue; // triangle with coincident vertices
         switch (isTriangleVertex(vertexIndex, i))
         {
             case 1:
@@ -232,7 +265,7 @@ bool gsHalfEdgeMesh<T>::isBoundaryVertex(const size_t internVertexIndex) const
         return false;
     }
     else
-        return m_boundary.isVertexContained(internVertexIndex);
+        return m_isBoundary[internVertexIndex];
 }
 
 template<class T>
@@ -284,6 +317,11 @@ void gsHalfEdgeMesh<T>::sortVertices()
     m_sorting.resize(this->m_vertex.size(), 0);
     m_inverseSorting.resize(this->m_vertex.size(), 0);
 
+    std::list<size_t> boundaryVertices = m_boundary.getVertexIndices();
+    m_isBoundary.assign(this->m_vertex.size(), false);
+    for (std::list<size_t>::const_iterator it = boundaryVertices.begin(); it != boundaryVertices.end(); ++it)
+        m_isBoundary[*it] = true;
+
     for (size_t i = 0; i != this->m_vertex.size(); ++i)
     {
         if (!isBoundaryVertex(i))
@@ -294,7 +332,6 @@ void gsHalfEdgeMesh<T>::sortVertices()
         }
     }
 
-    std::list<size_t> boundaryVertices = m_boundary.getVertexIndices();
     for (size_t i = 0; i < getNumberOfBoundaryVertices(); i++)
     {
         m_sorting[m_n + i] = boundaryVertices.front();
@@ -308,37 +345,65 @@ void gsHalfEdgeMesh<T>::sortVertices()
 template<class T>
 gsHalfEdgeMesh<T>::Boundary::Boundary(const std::vector<typename gsHalfEdgeMesh<T>::Halfedge> &halfedges)
 {
-    std::list<Halfedge> unsortedNonTwinHalfedges = findNonTwinHalfedges(halfedges);
-    m_boundary.appendNextHalfedge(unsortedNonTwinHalfedges.front());
-    unsortedNonTwinHalfedges.pop_front();
-    std::queue<Halfedge> nonFittingHalfedges;
-    while (!unsortedNonTwinHalfedges.empty())
-    {
-        if (m_boundary.isAppendableAsNext(unsortedNonTwinHalfedges.front()))
-        {
-            m_boundary.appendNextHalfedge(unsortedNonTwinHalfedges.front());
-            unsortedNonTwinHalfedges.pop_front();
-            while (!nonFittingHalfedges.empty())
+    std::list<Halfedge> nonTwin = findNonTwinHalfedges(halfedges);
+    const std::vector<Halfedge> unsorted(nonTwin.begin(), nonTwin.end());
+    const size_t m = unsorted.size();
+    if (m == 0)
+        return;
+
+    // the halfedges by origin and by end, to look up the fitting ones
+    std::vector<std::pair<size_t, size_t> > byOrigin, byEnd;
+    byOrigin.reserve(m);
+    byEnd.reserve(m);
+    for (size_t k = 0; k < m; ++k)
+    {
+        byOrigin.push_back(std::make_pair(unsorted[k].getOrigin(), k));
+        byEnd.push_back(std::make_pair(unsorted[k].getEnd(), k));
+    }
+    std::sort(byOrigin.begin(), byOrigin.end());
+    std::sort(byEnd.begin(), byEnd.end());
+
+    // The remaining halfedges are visited cyclically, starting after
+    // the last appended one, and the first one that fits (at the end
+    // or at the beginning of the chain) is appended
+    std::vector<bool> appended(m, false);
+    m_boundary.appendNextHalfedge(unsorted[0]);
+    appended[0] = true;
+    size_t current = 1 % m;
+    typename std::vector<std::pair<size_t, size_t> >::const_iterator it;
+    for (size_t count = 1; count < m; ++count)
+    {
+        const size_t last = m_boundary.getLastHalfedge().getEnd();
+        const size_t first = m_boundary.getFirstHalfedge().getOrigin();
+        size_t best = m, bestDist = m;
+        bool next = true;
+        for (it = std::lower_bound(byOrigin.begin(), byOrigin.end(), std::make_pair(last, (size_t)0));
+             it != byOrigin.end() && it->first == last; ++it)
+            if (!appended[it->second] && (it->second + m - current) % m < bestDist)
             {
-                unsortedNonTwinHalfedges.push_back(nonFittingHalfedges.front());
-                nonFittingHalfedges.pop();
+                best = it->second;
+                bestDist = (best + m - current) % m;
             }
-        }
-        else if (m_boundary.isAppendableAsPrev(unsortedNonTwinHalfedges.front()))
-        {
-            m_boundary.appendPrevHalfedge(unsortedNonTwinHalfedges.front());
-            unsortedNonTwinHalfedges.pop_front();
-            while (!nonFittingHalfedges.empty())
+        for (it = std::lower_bound(byEnd.begin(), byEnd.end(), std::make_pair(first, (size_t)0));
+             it != byEnd.end() && it->first == first; ++it)
+            if (!appended[it->second] && (it->second + m - current) % m < bestDist)
             {
-                unsortedNonTwinHalfedges.push_back(nonFittingHalfedges.front());
-                nonFittingHalfedges.pop();
+                best = it->second;
+                bestDist = (best + m - current) % m;
+                next = false;
             }
-        }
-        else
+        if (best == m)
         {
-            nonFittingHalfedges.push(unsortedNonTwinHalfedges.front());
-            unsortedNonTwinHalfedges.pop_front();
+            gsWarn << "gsHalfEdgeMesh::Boundary::Boundary: " << m - count
+                   << " boundary halfedges do not fit to the boundary chain.\n";
+            break;
         }
+        if (next)
+            m_boundary.appendNextHalfedge(unsorted[best]);
+        else
+            m_boundary.appendPrevHalfedge(unsorted[best]);
+        appended[best] = true;
+        current = (best + 1) % m;
     }
     if (!m_boundary.isClosed())
         gsWarn << "gsHalfEdgeMesh::Boundary::Boundary: Boundary is not closed although it should be. End points are:\n"
@@ -351,64 +416,30 @@ gsHalfEdgeMesh<T>::Boundary::Boundary(const std::vector<typename gsHalfEdgeMesh<
 template<class T>
 const std::list<typename gsHalfEdgeMesh<T>::Halfedge> gsHalfEdgeMesh<T>::Boundary::findNonTwinHalfedges(const std::vector<typename gsHalfEdgeMesh<T>::Halfedge> &allHalfedges)
 {
-    std::queue<Halfedge> queue0;
-    std::queue<Halfedge> queue1;
-    bool actualQueue = 0;
+    // The halfedges are processed in their order, each one is removed
+    // together with the first unprocessed twin, if there is one
+    const size_t m = allHalfedges.size();
+    std::vector<std::pair<std::pair<size_t, size_t>, size_t> > sorted;
+    sorted.reserve(m);
+    for (size_t i = 0; i < m; ++i)
+        sorted.push_back(std::make_pair(std::make_pair(allHalfedges[i].getOrigin(), allHalfedges[i].getEnd()), i));
+    std::sort(sorted.begin(), sorted.end());
+
     std::list<Halfedge> nonTwinHalfedges;
-    for (size_t i = 0; i < allHalfedges.size(); ++i)
-    {
-        queue0.push(allHalfedges[i]);
-    }
-    while (!(queue0.empty() && queue1.empty()))
-    {
-        if (actualQueue == 0)
-        {
-            nonTwinHalfedges.push_back(queue0.front());
-            queue0.pop();
-            while (!queue0.empty())
-            {
-                if (nonTwinHalfedges.back().isTwin(queue0.front()))
-                {
-                    queue0.pop();
-                    nonTwinHalfedges.pop_back();
-                    while (!queue0.empty())
-                    {
-                        queue1.push(queue0.front());
-                        queue0.pop();
-                    }
-                }
-                else
-                {
-                    queue1.push(queue0.front());
-                    queue0.pop();
-                }
-            }
-            actualQueue = 1;
-        }
-        else if (actualQueue == 1)
-        {
-            nonTwinHalfedges.push_back(queue1.front());
-            queue1.pop();
-            while (!queue1.empty())
-            {
-                if (nonTwinHalfedges.back().isTwin(queue1.front()))
-                {
-                    queue1.pop();
-                    nonTwinHalfedges.pop_back();
-                    while (!queue1.empty())
-                    {
-                        queue0.push(queue1.front());
-                        queue1.pop();
-                    }
-                }
-                else
-                {
-                    queue0.push(queue1.front());
-                    queue1.pop();
-                }
-            }
-            actualQueue = 0;
-        }
+    std::vector<bool> processed(m, false);
+    typename std::vector<std::pair<std::pair<size_t, size_t>, size_t> >::const_iterator it;
+    for (size_t i = 0; i < m; ++i)
+    {
+        if (processed[i])
+            continue;
+        processed[i] = true;
+        const std::pair<size_t, size_t> twin(allHalfedges[i].getEnd(), allHalfedges[i].getOrigin());
+        for (it = std::lower_bound(sorted.begin(), sorted.end(), std::make_pair(twin, (size_t)0));
+             it != sorted.end() && it->first == twin && processed[it->second]; ++it) ;
+        if (it != sorted.end() && it->first == twin)
+            processed[it->second] = true;
+        else
+            nonTwinHalfedges.push_back(allHalfedges[i]);
     }
     return nonTwinHalfedges;
 }
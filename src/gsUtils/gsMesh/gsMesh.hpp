@@ -264,21 +264,21 @@ gsMesh<T>& gsMesh<T>::cleanMesh()
     }
     gsDebug << "----------------------------------------\n";*/
 
-    // build up the unique map
-    std::vector<size_t> uniquemap;
-    uniquemap.reserve(m_vertex.size());
+    // build up the unique map: the vertices are sorted by their
+    // coordinates (and index), so that each vertex is mapped to the
+    // first vertex having the same coordinates in O(n*log(n))
+    std::vector<size_t> uniquemap(m_vertex.size());
+    std::vector<std::pair<VertexHandle,size_t> > sorted;
+    sorted.reserve(m_vertex.size());
     for(size_t i = 0; i < m_vertex.size(); i++)
+        sorted.push_back(std::make_pair(m_vertex[i], i));
+    std::sort(sorted.begin(), sorted.end(), lexCompareVHandleIndex<T>());
+    for(size_t i = 0; i < sorted.size(); i++)
     {
-        size_t buddy = i;
-        for(size_t j = 0; j < i; j++)
-        {
-            if(*(m_vertex[i]) == *(m_vertex[j])) // overload compares coords
-            {
-                buddy = j;
-                break;
-            }
-        }
-        uniquemap.push_back(buddy);
+        if (i != 0 && *sorted[i].first == *sorted[i-1].first) // overload compares coords
+            uniquemap[sorted[i].second] = uniquemap[sorted[i-1].second];
+        else
+            uniquemap[sorted[i].second] = sorted[i].second;
     }
 
     for(size_t i = 0; i < m_face.size(); i++)
@@ -147,6 +147,20 @@ struct lexCompareVHandle
       || ( lhs->x()==rhs->x() && lhs->y()==rhs->y() && lhs->z()<rhs->z()); }
 };
 
+/// Compares vertex handles lexicographically by their coordinates,
+/// ties are resolved by the attached index
+template<class T>
+struct lexCompareVHandleIndex
+{
+    typedef std::pair<typename gsVertex<T>::gsVertexHandle,size_t> value_type;
+    bool operator() (value_type const & lhs, value_type const & rhs) const
+    {
+        if ( Xless<T>(lhs.first, rhs.first) ) return true;
+        if ( Xless<T>(rhs.first, lhs.first) ) return false;
+        return lhs.second < rhs.second;
+    }
+};
+
 template<class T>
 T length(gsVertex<T> const & vert)
 {
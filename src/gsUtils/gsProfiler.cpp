@@ -0,0 +1,172 @@
+/** @file gsProfiler.cpp
+
+    @brief Scoped timers and counters for the hot paths of the library.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gsUtils/gsProfiler.h>
+#include <gsCore/gsDebug.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace gismo
+{
+
+gsProfiler & gsProfiler::get()
+{
+    static gsProfiler reg;
+    return reg;
+}
+
+void gsProfiler::clear()
+{
+    m_dropped = 0;
+    m_data.clear();
+#ifdef _OPENMP
+    m_data.resize(omp_get_max_threads());
+#else
+    m_data.resize(1);
+#endif
+}
+
+gsProfiler::threadData * gsProfiler::thread()
+{
+#ifdef _OPENMP
+    const size_t tid = omp_get_thread_num();
+#else
+    const size_t tid = 0;
+#endif
+    // The slots are only resized by clear(), outside parallel regions
+    if (tid < m_data.size())
+        return &m_data[tid];
+#   pragma omp atomic
+    ++m_dropped;
+    return NULL;
+}
+
+const std::string & gsProfiler::enter(const char * name)
+{
+    static const std::string none;
+    threadData * td = thread();
+    if (!td) return none;
+    std::vector<std::string> & st = td->stack;
+    if (st.empty())
+        st.push_back(name);
+    else
+        st.push_back(st.back() + "/" + name);
+    return st.back();
+}
+
+void gsProfiler::leave(const double wall, const double cpu)
+{
+    threadData * td = thread();
+    if (!td) return;
+    GISMO_ASSERT(!td->stack.empty(), "gsProfiler: leave() without enter()");
+    entry & e = td->entries[td->stack.back()];
+    ++e.calls;
+    e.wall += wall;
+    e.cpu  += cpu;
+    td->stack.pop_back();
+}
+
+std::map<std::string,gsProfiler::entry> gsProfiler::merged() const
+{
+    std::map<std::string,entry> res;
+    for (size_t t = 0; t != m_data.size(); ++t)
+        for (std::map<std::string,entry>::const_iterator it = m_data[t].entries.begin();
+             it != m_data[t].entries.end(); ++it)
+        {
+            entry & e = res[it->first];
+            e.calls += it->second.calls;
+            e.wall  += it->second.wall;
+            e.cpu   += it->second.cpu;
+        }
+    return res;
+}
+
+gsProfiler::entry gsProfiler::timing(const std::string & name) const
+{
+    const std::map<std::string,entry> all = merged();
+    std::map<std::string,entry>::const_iterator it = all.find(name);
+    return it == all.end() ? entry() : it->second;
+}
+
+long long gsProfiler::total(const counter c) const
+{
+    long long res = 0;
+    for (size_t t = 0; t != m_data.size(); ++t)
+        res += m_data[t].counters[c];
+    return res;
+}
+
+const char * gsProfiler::counterName(const counter c)
+{
+    static const char * names[numCounters] =
+        {"elements", "quPoints", "spmv", "allocations"};
+    return names[c];
+}
+
+std::ostream & gsProfiler::print(std::ostream & os) const
+{
+    const std::map<std::string,entry> all = merged();
+    os << "Timings (calls, wall, cpu):\n";
+    for (std::map<std::string,entry>::const_iterator it = all.begin();
+         it != all.end(); ++it)
+    {
+        // indent by the depth of the hierarchical name
+        const size_t d = std::count(it->first.begin(), it->first.end(), '/');
+        const size_t p = it->first.rfind('/');
+        os << std::string(2*d+2, ' ')
+           << (p == std::string::npos ? it->first : it->first.substr(p+1))
+           << ": " << it->second.calls << ", ";
+        formatTime(os, it->second.wall) << ", ";
+        formatTime(os, it->second.cpu ) << "\n";
+    }
+    os << "Counters (total, per thread):\n";
+    for (index_t c = 0; c != numCounters; ++c)
+    {
+        os << "  " << counterName((counter)c) << ": "
+           << total((counter)c) << " (";
+        for (size_t t = 0; t != m_data.size(); ++t)
+            os << (t ? " " : "") << m_data[t].counters[c];
+        os << ")\n";
+    }
+    if (m_dropped)
+        os << "Dropped samples of threads without a slot: " << m_dropped << "\n";
+    return os;
+}
+
+std::ostream & gsProfiler::printJson(std::ostream & os) const
+{
+    const std::map<std::string,entry> all = merged();
+    os << "{\n  \"timings\": {";
+    for (std::map<std::string,entry>::const_iterator it = all.begin();
+         it != all.end(); ++it)
+    {
+        os << (it == all.begin() ? "\n" : ",\n")
+           << "    \"" << it->first << "\": {\"calls\": " << it->second.calls
+           << ", \"wall\": " << it->second.wall
+           << ", \"cpu\": "  << it->second.cpu << "}";
+    }
+    os << "\n  },\n  \"counters\": {";
+    for (index_t c = 0; c != numCounters; ++c)
+    {
+        os << (c ? ",\n" : "\n")
+           << "    \"" << counterName((counter)c) << "\": {\"total\": "
+           << total((counter)c) << ", \"threads\": [";
+        for (size_t t = 0; t != m_data.size(); ++t)
+            os << (t ? ", " : "") << m_data[t].counters[c];
+        os << "]}";
+    }
+    os << "\n  }\n}\n";
+    return os;
+}
+
+} // namespace gismo
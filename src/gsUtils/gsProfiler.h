@@ -0,0 +1,201 @@
+/** @file gsProfiler.h
+
+    @brief Scoped timers and counters for the hot paths of the library.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsCore/gsExport.h>
+#include <gsUtils/gsStopwatch.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace gismo
+{
+
+/** @brief Registry of timings and counters of instrumented code.
+
+    Timings are recorded by the scoped timers created with the macro
+    GISMO_PROFILE(name). A timer nested in another timer of the same
+    thread is recorded under the hierarchical name "outer/inner". For
+    every name the number of calls, the wall time and the (process)
+    CPU time are accumulated.
+
+    Counters (elements, quadrature points, sparse matrix-vector
+    products, allocations) are incremented with
+    GISMO_PROFILE_COUNT(counter, n).
+
+    Every thread records into its own slot, so no synchronization is
+    needed. The slots are merged by the report functions print() and
+    printJson(), which must be called outside parallel regions. The
+    slots are created by clear(), for the maximum number of threads
+    at that time. Samples of threads without a slot (eg. after
+    increasing the number of threads) are dropped and counted, see
+    numDropped().
+
+    The macros expand to nothing unless G+Smo is configured with
+    GISMO_WITH_PROFILING=ON, so instrumented code has no overhead in
+    the default build.
+
+    Example:
+    \code
+    gsProfiler::get().clear();
+    assembler.assemble();
+    solver.solve(rhs, x);
+    gsProfiler::get().print(gsInfo);
+    \endcode
+
+    \ingroup Utils
+*/
+class GISMO_EXPORT gsProfiler
+{
+public:
+
+    /// The counters that are kept per thread
+    enum counter
+    {
+        elements     = 0, ///< Visited elements
+        quPoints     = 1, ///< Visited quadrature points
+        spmv         = 2, ///< Sparse matrix-vector products
+        allocations  = 3, ///< Allocations of global systems
+        numCounters  = 4
+    };
+
+    /// Accumulated data of one timer name
+    struct entry
+    {
+        entry() : calls(0), wall(0), cpu(0) { }
+        index_t calls; ///< Number of calls
+        double  wall;  ///< Wall time in seconds
+        double  cpu;   ///< CPU time in seconds
+    };
+
+public:
+
+    /// Returns the global registry
+    static gsProfiler & get();
+
+    /// Clears all timings and counters, and sets the number of
+    /// thread slots to the current maximum number of threads
+    void clear();
+
+    /// Enters the scope \a name in the calling thread, returns the
+    /// hierarchical name of the scope
+    const std::string & enter(const char * name);
+
+    /// Leaves the current scope of the calling thread and records the
+    /// times \a wall and \a cpu for it
+    void leave(const double wall, const double cpu);
+
+    /// Increments the counter \a c of the calling thread by \a n
+    void count(const counter c, const index_t n = 1)
+    {
+        threadData * td = thread();
+        if (td) td->counters[c] += n;
+    }
+
+    /// Returns the accumulated data of the hierarchical name \a name
+    /// over all threads
+    entry timing(const std::string & name) const;
+
+    /// Returns the value of counter \a c summed over all threads
+    long long total(const counter c) const;
+
+    /// Returns the value of counter \a c of thread \a tid
+    long long counterValue(const counter c, const index_t tid) const
+    { return m_data[tid].counters[c]; }
+
+    /// Returns the number of thread slots
+    index_t numThreads() const { return m_data.size(); }
+
+    /// Returns the number of samples (scopes and counter increments)
+    /// dropped since the last clear(), since their thread had no slot
+    long long numDropped() const { return m_dropped; }
+
+    /// Prints a report of the timings and counters as text
+    std::ostream & print(std::ostream & os) const;
+
+    /// Prints a report of the timings and counters as a JSON object
+    std::ostream & printJson(std::ostream & os) const;
+
+    /// Returns the name of counter \a c
+    static const char * counterName(const counter c);
+
+private:
+
+    gsProfiler() { clear(); }
+    gsProfiler(const gsProfiler &);
+    gsProfiler & operator=(const gsProfiler &);
+
+    struct threadData
+    {
+        threadData() { std::fill(counters, counters+numCounters, 0LL); }
+        std::vector<std::string> stack;
+        std::map<std::string,entry> entries;
+        long long counters[numCounters];
+    };
+
+    /// Returns the slot of the calling thread, or NULL (and counts a
+    /// dropped sample) if it has none
+    threadData * thread();
+
+    std::map<std::string,entry> merged() const;
+
+private:
+
+    std::vector<threadData> m_data;
+    long long m_dropped;
+};
+
+/** @brief Scoped timer of gsProfiler, records the wall and CPU time
+    from its construction to its destruction. Usually created by the
+    macro GISMO_PROFILE(name).
+
+    \ingroup Utils
+*/
+class gsProfilerScope
+{
+public:
+    explicit gsProfilerScope(const char * name)
+    {
+        gsProfiler::get().enter(name);
+        m_cpu.restart();
+        m_wall.restart();
+    }
+
+    ~gsProfilerScope()
+    { gsProfiler::get().leave(m_wall.stop(), m_cpu.stop()); }
+
+private:
+    gsProfilerScope(const gsProfilerScope &);
+    gsProfilerScope & operator=(const gsProfilerScope &);
+
+    gsStopwatch    m_wall;
+    gsCPUStopwatch m_cpu;
+};
+
+} // namespace gismo
+
+#define GISMO_PROFILE_CAT_(a,b) a##b
+#define GISMO_PROFILE_CAT(a,b)  GISMO_PROFILE_CAT_(a,b)
+
+#ifdef GISMO_WITH_PROFILING
+/// Times the rest of the enclosing scope under \a name
+#  define GISMO_PROFILE(name) \
+    gismo::gsProfilerScope GISMO_PROFILE_CAT(gsProfilerScope_,__LINE__)(name)
+/// Increments the profiling counter \a c (eg. elements) by \a n
+#  define GISMO_PROFILE_COUNT(c, n) \
+    gismo::gsProfiler::get().count(gismo::gsProfiler::c, n)
+#else
+#  define GISMO_PROFILE(name)       ((void)0)
+#  define GISMO_PROFILE_COUNT(c, n) ((void)0)
+#endif
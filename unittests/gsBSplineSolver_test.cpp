@@ -0,0 +1,86 @@
+/** @file gsBSplineSolver_test.cpp
+
+    @brief Tests the root finding for B-spline curves
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "gismo_unittest.h"
+
+SUITE(gsBSplineSolver_test)
+{
+    // A closed, wavy curve around the origin
+    gsBSpline<> wavyCurve(real_t r)
+    {
+        gsKnotVector<> kv(0, 1, 9, 4);
+        gsBSplineBasis<> basis(kv);
+        const index_t n = basis.size();
+        gsMatrix<> c(n, 2);
+        for (index_t i = 0; i != n; ++i)
+        {
+            const real_t a = 2 * EIGEN_PI * i / (n-1);
+            const real_t ri = r * (1 + (i%2 ? 0.2 : 0) );
+            c(i,0) = ri * math::cos(a);
+            c(i,1) = ri * math::sin(a);
+        }
+        c.row(n-1) = c.row(0);
+        return gsBSpline<>(basis, c);
+    }
+
+    TEST(BatchedLevels)
+    {
+        gsBSpline<> curve = wavyCurve(1);
+        std::vector<real_t> levels;
+        for (index_t i = 0; i != 17; ++i)
+            levels.push_back(-0.8 + 0.1 * i);
+
+        gsBSplineSolver<real_t> slv;
+        std::vector<std::vector<real_t> > batch;
+        slv.allRoots(curve, batch, 1, levels);
+        CHECK_EQUAL( levels.size(), batch.size() );
+
+        std::vector<real_t> roots;
+        gsMatrix<> e;
+        for (size_t i = 0; i != levels.size(); ++i)
+        {
+            slv.allRoots(curve, roots, 1, levels[i]);
+            CHECK_EQUAL( roots.size(), batch[i].size() );
+            CHECK( ! roots.empty() );
+            for (size_t k = 0; k != roots.size(); ++k)
+                CHECK_EQUAL( roots[k], batch[i][k] );
+
+            // The roots lie on the level set
+            gsAsMatrix<> xx(batch[i]);
+            curve.eval_into(xx, e);
+            CHECK( (e.row(1).array() - levels[i]).abs().maxCoeff() < 1e-5 );
+        }
+    }
+
+    TEST(BatchedCurves)
+    {
+        std::vector<gsBSpline<> > curves;
+        for (index_t i = 0; i != 5; ++i)
+            curves.push_back( wavyCurve(1 + 0.5 * i) );
+        std::vector<const gsBSpline<>*> ptrs;
+        for (size_t i = 0; i != curves.size(); ++i)
+            ptrs.push_back( &curves[i] );
+
+        gsBSplineSolver<real_t> slv;
+        std::vector<std::vector<real_t> > batch;
+        slv.allRoots(ptrs, batch, 0, 0.5);
+        CHECK_EQUAL( curves.size(), batch.size() );
+
+        std::vector<real_t> roots;
+        for (size_t i = 0; i != curves.size(); ++i)
+        {
+            slv.allRoots(curves[i], roots, 0, 0.5);
+            CHECK_EQUAL( roots.size(), batch[i].size() );
+            for (size_t k = 0; k != roots.size(); ++k)
+                CHECK_EQUAL( roots[k], batch[i][k] );
+        }
+    }
+}
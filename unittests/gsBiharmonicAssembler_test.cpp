@@ -0,0 +1,162 @@
+/** @file gsBiharmonicAssembler_test.cpp
+
+    @brief Tests the assembly of the biharmonic equation.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+**/
+
+#include "gismo_unittest.h"
+#include <gsAssembler/gsBiharmonicAssembler.h>
+
+SUITE(gsBiharmonicAssembler_test)
+{
+
+struct BiharmonicFixture
+{
+    BiharmonicFixture()
+    : mp(*gsNurbsCreator<>::BSplineFatQuarterAnnulus()), mb(mp),
+      source("256*pi^4*(4*cos(4*pi*x)*cos(4*pi*y) - cos(4*pi*x) - cos(4*pi*y))", 2),
+      laplace("-16*pi^2*(2*cos(4*pi*x)*cos(4*pi*y) - cos(4*pi*x) - cos(4*pi*y))", 2),
+      solVal("(cos(4*pi*x) - 1) * (cos(4*pi*y) - 1)", 2)
+    {
+        mb.degreeElevate(1,0);
+        mb.degreeElevate();
+        mb.uniformRefine();
+        for (gsMultiPatch<>::const_biterator it = mp.bBegin(); it != mp.bEnd(); ++it)
+        {
+            bc .addCondition(*it, condition_type::dirichlet, &solVal);
+            bc2.addCondition(*it, condition_type::neumann  , &laplace);
+        }
+    }
+
+    real_t l2error(gsBiharmonicAssembler<real_t> & A) const
+    {
+        gsSparseSolver<>::LU solver(A.matrix());
+        gsMultiPatch<> mpsol;
+        A.constructSolution(solver.solve(A.rhs()), mpsol);
+        const gsField<> solField(A.patches(), mpsol);
+        return solField.distanceL2(solVal);
+    }
+
+    gsMultiPatch<> mp;
+    gsMultiBasis<> mb;
+    gsFunctionExpr<> source, laplace, solVal;
+    gsBoundaryConditions<> bc, bc2;
+};
+
+TEST_FIXTURE(BiharmonicFixture, ReuseGeometry)
+{
+    gsBiharmonicAssembler<real_t> A(mp, mb, bc, bc2, source, dirichlet::elimination);
+    A.assemble();
+    const gsMatrix<> K = A.matrix().toDense();
+    const gsMatrix<> f = A.rhs();
+
+    // second assembly with the cached geometric data
+    A.refresh();
+    A.assemble();
+    CHECK( (A.matrix().toDense() - K).norm() <= 1e-10 * K.norm() );
+    CHECK( (A.rhs() - f).norm() <= 1e-10 * f.norm() );
+
+    // the cached data of the coarse elements does not survive refinement
+    A.multiBasis().uniformRefine();
+    A.refresh();
+    A.assemble();
+    mb.uniformRefine();
+    gsBiharmonicAssembler<real_t> B(mp, mb, bc, bc2, source, dirichlet::elimination);
+    B.assemble();
+    const gsMatrix<> KB = B.matrix().toDense();
+    CHECK( (A.matrix().toDense() - KB).norm() <= 1e-10 * KB.norm() );
+    CHECK( (A.rhs() - B.rhs()).norm() <= 1e-10 * B.rhs().norm() );
+}
+
+TEST_FIXTURE(BiharmonicFixture, NewGeometry)
+{
+    gsBiharmonicAssembler<real_t> A(mp, mb, bc, bc2, source, dirichlet::elimination);
+    A.assemble();
+
+    // A different geometry with the same knots, the cached data of
+    // the first geometry is not used
+    gsMultiPatch<> mp2(mp);
+    mp2.patch(0).coefs().col(0) *= 2;
+    gsBiharmonicPde<real_t> pde2(mp2, bc, bc2, source);
+    A.initialize(pde2, mb, A.options());
+    A.assemble();
+    gsBiharmonicAssembler<real_t> B(mp2, mb, bc, bc2, source, dirichlet::elimination);
+    B.assemble();
+    const gsMatrix<> KB = B.matrix().toDense();
+    CHECK( (A.matrix().toDense() - KB).norm() <= 1e-10 * KB.norm() );
+    CHECK( (A.rhs() - B.rhs()).norm() <= 1e-10 * B.rhs().norm() );
+
+    // The same patch with moved control points
+    pde2.patches().patch(0).coefs().col(1) *= 0.5;
+    A.refresh();
+    A.assemble();
+    gsBiharmonicAssembler<real_t> C(pde2.patches(), mb, bc, bc2, source, dirichlet::elimination);
+    C.assemble();
+    const gsMatrix<> KC = C.matrix().toDense();
+    CHECK( (A.matrix().toDense() - KC).norm() <= 1e-10 * KC.norm() );
+    CHECK( (A.rhs() - C.rhs()).norm() <= 1e-10 * C.rhs().norm() );
+}
+
+// A visitor without geometry cache
+class plainVisitorBiharmonic
+{
+public:
+    plainVisitorBiharmonic(const gsPde<real_t> & pde) : m_visitor(pde) { }
+
+    template <class Bases>
+    void initialize(const Bases & basis, const index_t patchIndex,
+                    const gsOptionList & options, gsQuadRule<real_t> & rule)
+    { m_visitor.initialize(basis, patchIndex, options, rule); }
+
+    template <class Bases>
+    void evaluate(const Bases & basis, const gsGeometry<real_t> & geo, gsMatrix<real_t> & quNodes)
+    { m_visitor.evaluate(basis, geo, quNodes); }
+
+    void assemble(gsDomainIterator<real_t> & element, const gsVector<real_t> & quWeights)
+    { m_visitor.assemble(element, quWeights); }
+
+    void localToGlobal(const index_t patchIndex, const std::vector<gsMatrix<real_t> > & eliminatedDofs,
+                       gsSparseSystem<real_t> & system)
+    { m_visitor.localToGlobal(patchIndex, eliminatedDofs, system); }
+
+private:
+    gsVisitorBiharmonic<real_t> m_visitor;
+};
+
+TEST_FIXTURE(BiharmonicFixture, VisitorWithoutCache)
+{
+    CHECK( (internal::has_setGeometryCache<gsVisitorBiharmonic<real_t>, real_t>::value) );
+    CHECK( !(internal::has_setGeometryCache<plainVisitorBiharmonic, real_t>::value) );
+
+    gsBiharmonicAssembler<real_t> A(mp, mb, bc, bc2, source, dirichlet::elimination);
+    A.assemble();
+    gsBiharmonicAssembler<real_t, plainVisitorBiharmonic> B(mp, mb, bc, bc2, source, dirichlet::elimination);
+    B.assemble();
+    const gsMatrix<> KA = A.matrix().toDense();
+    CHECK( (B.matrix().toDense() - KA).norm() <= 1e-10 * KA.norm() );
+    CHECK( (B.rhs() - A.rhs()).norm() <= 1e-10 * A.rhs().norm() );
+}
+
+TEST_FIXTURE(BiharmonicFixture, Convergence)
+{
+    // cubic splines on a curved domain, the L2 error is O(h^4)
+    mb.uniformRefine();
+    mb.uniformRefine();
+    mb.uniformRefine();
+    gsBiharmonicAssembler<real_t> A(mp, mb, bc, bc2, source, dirichlet::elimination);
+    A.assemble();
+    const real_t e0 = l2error(A);
+
+    A.multiBasis().uniformRefine();
+    A.refresh();
+    A.assemble();
+    const real_t e1 = l2error(A);
+    CHECK( e1 < e0 / 8 );
+}
+
+}
@@ -0,0 +1,101 @@
+/** @file gsCurvatureSmoothing_test.cpp
+
+    @brief Tests the curvature smoothing of closed B-spline curves
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "gismo_unittest.h"
+#include <gsModeling/gsCurvatureSmoothing.h>
+
+SUITE(gsCurvatureSmoothing_test)
+{
+    // A closed cubic curve with noisy coefficients around the unit circle
+    gsBSpline<> noisyCircle(index_t n)
+    {
+        gsKnotVector<> kv(0, 1, n, 4);
+        gsBSplineBasis<> basis(kv);
+        const index_t nc = basis.size(), nr = nc - 3;
+        gsMatrix<> c(nc, 2);
+        for (index_t i = 0; i != nr; ++i)
+        {
+            const real_t a = 2 * EIGEN_PI * i / nr;
+            const real_t r = 1 + 0.05 * ((i*7)%5 - 2);
+            c(i,0) = r * math::cos(a);
+            c(i,1) = r * math::sin(a);
+        }
+        for (index_t k = 0; k != 3; ++k)
+            c.row(nr+k) = c.row(k);
+        return gsBSpline<>(basis, c);
+    }
+
+    TEST(TotalVariation)
+    {
+        gsBSpline<> curve = noisyCircle(40);
+        gsMatrix<> u(200, 1), pts, e;
+        for (index_t i = 0; i != u.rows(); ++i)
+            u(i,0) = (i + 0.5) / u.rows();
+        curve.eval_into(u.transpose(), e);
+        pts = e.transpose();
+
+        gsCurvatureSmoothing<> cs(curve, u, pts);
+        real_t err0, err1, approx;
+        cs.computeCurvatureError(err0);
+        cs.smoothTotalVariation(0.01, 1, 0.01, 0.5, 10);
+        cs.computeCurvatureError(err1);
+        cs.computeApproxErrorLMax(approx);
+        CHECK( err1 < err0 );
+        CHECK( approx < 0.1 );
+
+        // the curve is still closed
+        const gsMatrix<> & c = cs.curveSmooth().coefs();
+        CHECK( (c.topRows(3) - c.bottomRows(3)).isZero(1e-12) );
+    }
+
+    TEST(Hadenfeld)
+    {
+        gsBSpline<> curve = noisyCircle(60);
+        gsMatrix<> u(1, 1), pts(1, 2);
+        gsCurvatureSmoothing<> cs(curve, u, pts);
+        gsVector<index_t> iterated;
+        const real_t delta = 0.02;
+        cs.smoothHadenfeld(3, delta, 5, 200, iterated);
+        CHECK_EQUAL( 200, iterated.sum() );
+        CHECK( iterated.maxCoeff() <= 5 );
+
+        // reference: greedy smoothing of the coefficient with the largest change
+        const real_t m[4] = {17.0/25, -4.0/25, -1.0/25, 1.0/50};
+        const index_t nr = curve.coefs().rows() - 3;
+        gsMatrix<> c = curve.coefs().topRows(nr), c0 = c, s(nr, 2);
+        gsVector<index_t> it(nr);
+        it.setZero();
+        for (index_t j = 0; j != 200; ++j)
+        {
+            index_t best = 0;
+            real_t bestDist = -1;
+            for (index_t i = 0; i != nr; ++i)
+            {
+                s.row(i).setZero();
+                for (index_t l = 1; l <= 4; ++l)
+                    s.row(i) += m[l-1] * c.row((i-l+nr)%nr) + m[l-1] * c.row((i+l)%nr);
+                const real_t d = (s.row(i) - c.row(i)).norm();
+                if (it[i] < 5 && d > bestDist)
+                {
+                    bestDist = d;
+                    best = i;
+                }
+            }
+            ++it[best];
+            const real_t d = (s.row(best) - c0.row(best)).norm();
+            c.row(best) = d > delta ?
+                gsMatrix<>(c0.row(best) + (delta/d) * (s.row(best) - c0.row(best))) :
+                gsMatrix<>(s.row(best));
+        }
+        CHECK( it == iterated );
+        CHECK( (c - cs.curveSmooth().coefs().topRows(nr)).isZero(1e-12) );
+    }
+}
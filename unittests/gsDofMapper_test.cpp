@@ -0,0 +1,136 @@
+/** @file gsDofMapper_test.cpp
+
+    @brief Tests the orderings of the free dofs of gsDofMapper.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+**/
+
+#include "gismo_unittest.h"
+
+SUITE(gsDofMapper_test)
+{
+
+TEST(orderings)
+{
+    gsMultiPatch<> mp = gsNurbsCreator<>::BSplineSquareGrid(2, 2, 0.5);
+    gsMultiBasis<> mb(mp);
+    mb.degreeElevate();
+    mb.uniformRefine();
+    mb.uniformRefine();
+
+    gsFunctionExpr<> f("2*pi^2*sin(pi*x)*sin(pi*y)", 2);
+    gsFunctionExpr<> g("sin(pi*x)*sin(pi*y)", 2);
+    gsBoundaryConditions<> bc;
+    for (gsMultiPatch<>::const_biterator it = mp.bBegin(); it != mp.bEnd(); ++it)
+        bc.addCondition(*it, condition_type::dirichlet, &g);
+
+    gsDofMapper natural;
+    mb.getMapper(dirichlet::elimination, iFace::glue, bc, natural, 0);
+    const index_t nFree = natural.freeSize();
+
+    gsMatrix<> sol0;
+    for (index_t o = dofOrdering::natural; o <= dofOrdering::sfc; ++o)
+    {
+        gsDofMapper mapper;
+        mb.getMapper(dirichlet::elimination, iFace::glue, bc, mapper, 0, false);
+        mapper.finalize(mb, static_cast<dofOrdering::type>(o));
+        CHECK_EQUAL(nFree, mapper.freeSize());
+        CHECK_EQUAL(natural.coupledSize(), mapper.coupledSize());
+        CHECK_EQUAL(natural.boundarySize(), mapper.boundarySize());
+
+        // The free dofs are permuted, the interface dofs stay last
+        std::vector<index_t> seen(nFree, 0);
+        for (size_t k = 0; k != mb.nBases(); ++k)
+            for (index_t i = 0; i != mb[k].size(); ++i)
+            {
+                CHECK_EQUAL(natural.is_free(i, k), mapper.is_free(i, k));
+                if ( !mapper.is_free(i, k) )
+                {
+                    CHECK_EQUAL(natural.bindex(i, k), mapper.bindex(i, k));
+                    continue;
+                }
+                CHECK_EQUAL(natural.is_coupled(i, k), mapper.is_coupled(i, k));
+                seen[mapper.index(i, k)] = 1;
+            }
+        CHECK_EQUAL(nFree, std::count(seen.begin(), seen.end(), 1));
+
+        // The same solution with every ordering
+        gsPoissonAssembler<> assembler(mp, mb, bc, f);
+        assembler.options().setInt("DofOrdering", o);
+        assembler.refresh();
+        assembler.assemble();
+        gsSparseSolver<>::SimplicialLDLT solver(assembler.matrix());
+        const gsMatrix<> x = solver.solve(assembler.rhs());
+        gsMultiPatch<> uh;
+        assembler.constructSolution(x, uh);
+        gsMatrix<> sol(0, 1);
+        for (size_t k = 0; k != uh.nPatches(); ++k)
+        {
+            sol.conservativeResize(sol.rows() + uh.patch(k).coefs().rows(), 1);
+            sol.bottomRows(uh.patch(k).coefs().rows()) = uh.patch(k).coefs();
+        }
+        if ( dofOrdering::natural == o )
+            sol0 = sol;
+        else
+            CHECK( (sol - sol0).norm() <= 1e-10 * sol0.norm() );
+    }
+}
+
+TEST(orderings_transfer)
+{
+    gsMultiPatch<> mp = gsNurbsCreator<>::BSplineSquareGrid(2, 2, 0.5);
+    gsMultiBasis<> mb(mp);
+    mb.degreeElevate();
+    mb.uniformRefine();
+
+    gsFunctionExpr<> g("0", 2);
+    gsBoundaryConditions<> bc;
+    for (gsMultiPatch<>::const_biterator it = mp.bBegin(); it != mp.bEnd(); ++it)
+        bc.addCondition(*it, condition_type::dirichlet, &g);
+
+    gsOptionList opt = gsGridHierarchy<>::defaultOptions();
+    opt.setInt("DirichletStrategy", dirichlet::elimination);
+    opt.setInt("InterfaceStrategy", iFace::glue);
+    opt.setInt("Levels", 2);
+    const gsSparseMatrix<real_t, RowMajor> P0 =
+        gsGridHierarchy<>::buildByRefinement(mb, bc, opt).getTransferMatrices().front();
+
+    for (index_t o = dofOrdering::rcm; o <= dofOrdering::sfc; ++o)
+    {
+        opt.setInt("DofOrdering", o);
+        const gsGridHierarchy<> gh = gsGridHierarchy<>::buildByRefinement(mb, bc, opt);
+        const gsSparseMatrix<real_t, RowMajor> & P = gh.getTransferMatrices().front();
+
+        // The transfer matrix is numbered as the assembler on each
+        // level, ie. a permutation of the natural one
+        std::vector<gsMatrix<index_t> > perm(2);
+        for (size_t l = 0; l != 2; ++l)
+        {
+            const gsMultiBasis<> & b = gh.getMultiBases()[l];
+            gsDofMapper natural, mapper;
+            b.getMapper(dirichlet::elimination, iFace::glue, bc, natural, 0);
+            b.getMapper(dirichlet::elimination, iFace::glue, bc, mapper, 0, false);
+            mapper.finalize(b, static_cast<dofOrdering::type>(o));
+            perm[l].setZero(natural.freeSize(), 1);
+            for (size_t k = 0; k != b.nBases(); ++k)
+                for (index_t i = 0; i != b[k].size(); ++i)
+                    if ( natural.is_free(i, k) )
+                        perm[l](natural.index(i, k)) = mapper.index(i, k);
+        }
+
+        CHECK_EQUAL(P0.rows(), P.rows());
+        CHECK_EQUAL(P0.cols(), P.cols());
+        real_t diff = 0;
+        for (index_t r = 0; r != P0.outerSize(); ++r)
+            for (gsSparseMatrix<real_t, RowMajor>::InnerIterator it(P0, r); it; ++it)
+                diff += math::abs(it.value() - P.coeff(perm[1](r), perm[0](it.col())));
+        CHECK( diff <= 1e-12 );
+        CHECK_CLOSE( P0.sum(), P.sum(), 1e-10 );
+    }
+}
+
+}
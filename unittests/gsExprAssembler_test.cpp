@@ -41,4 +41,145 @@ SUITE(gsExprAssembler_test)
                     const real_t v = ev.value();
                     CHECK( v*v < 1e-10 );
                 }
+
+    TEST(ElementWiseOrder)
+    {
+        gsMultiPatch<> patches( *gsNurbsCreator<>::BSplineSquare(1.0) );
+        gsMultiBasis<> mb(patches);
+        mb.uniformRefine(3); // 4 x 4 elements
+        mb.basis(0).component(0).uniformRefine(); // 8 x 4 elements
+
+        gsExprEvaluator<> ev;
+        ev.setIntegrationElements(mb);
+        gsExprEvaluator<>::geometryMap G = ev.getMap(patches);
+        gsFunctionExpr<> ff("x*y", 2);
+        gsExprEvaluator<>::variable f = ev.getVariable(ff, G);
+        gsExprEvaluator<>::element e = ev.getElement();
+
+        // the element values come in element order, whatever the
+        // number of threads
+        const real_t v = ev.integralElWise(f * meas(G));
+        CHECK_CLOSE( 0.25, v, 1e-12 );
+        const std::vector<real_t> vals = ev.elementwise();
+        ev.maxElWise(e.diam());
+        const std::vector<real_t> diam = ev.elementwise();
+
+        gsBasis<>::domainIter domIt = mb.basis(0).makeDomainIterator();
+        CHECK_EQUAL( domIt->numElements(), vals.size() );
+        real_t sum = 0;
+        for (size_t i = 0; domIt->good(); domIt->next(), ++i)
+        {
+            const gsVector<> & a = domIt->lowerCorner(), & b = domIt->upperCorner();
+            const real_t exact = (b[0]*b[0]-a[0]*a[0]) * (b[1]*b[1]-a[1]*a[1]) / 4;
+            CHECK_CLOSE( exact, vals[i], 1e-12 );
+            CHECK_EQUAL( domIt->getCellSize(), diam[i] );
+            sum += vals[i];
+        }
+        CHECK_EQUAL( sum, v );
+
+        // boundary integral: the perimeter of the square
+        CHECK_CLOSE( 4, ev.integralBdr(nv(G).norm()), 1e-12 );
+    }
+
+    TEST(UserParallelRegion)
+    {
+        gsMultiPatch<> patches( *gsNurbsCreator<>::BSplineSquare(1.0) );
+        gsMultiBasis<> mb(patches);
+        mb.uniformRefine(3);
+        gsFunctionExpr<> ff("x*y", 2);
+
+        // Every thread of the caller evaluates with its own evaluator
+        // and assembler
+        index_t numWrong = 0;
+#       pragma omp parallel reduction(+:numWrong)
+        {
+            gsExprEvaluator<> ev;
+            ev.setIntegrationElements(mb);
+            gsExprEvaluator<>::geometryMap G = ev.getMap(patches);
+            gsExprEvaluator<>::variable f = ev.getVariable(ff, G);
+            if ( math::abs(ev.integral(f * meas(G)) - 0.25) > 1e-12 )
+                ++numWrong;
+            if ( math::abs(ev.integralElWise(f * meas(G)) - 0.25) > 1e-12 )
+                ++numWrong;
+
+            gsExprAssembler<> A(1,1);
+            A.setIntegrationElements(mb);
+            gsExprAssembler<>::geometryMap GA = A.getMap(patches);
+            gsExprAssembler<>::space u = A.getSpace(mb);
+            A.initSystem();
+            A.assemble(u * u.tr() * meas(GA));
+            // the mass matrix of a partition of unity sums to the area
+            if ( math::abs(A.matrix().toDense().sum() - 1) > 1e-12 )
+                ++numWrong;
         }
+        CHECK_EQUAL( 0, numWrong );
+    }
+
+    TEST(CommonSubexpressions)
+    {
+        gsMultiPatch<> mp( *gsNurbsCreator<>::BSplineFatQuarterAnnulus() );
+        gsMultiBasis<> mb(mp);
+        mb.uniformRefine(2);
+
+        gsExprAssembler<> A(1,1);
+        A.setIntegrationElements(mb);
+        gsExprAssembler<>::geometryMap G = A.getMap(mp);
+        gsExprAssembler<>::space u = A.getSpace(mb);
+        A.initSystem();
+
+        // igrad(u,G) is computed once per quadrature point
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G) );
+        const gsSparseMatrix<> K1 = A.matrix();
+        const index_t numEvals = G.cache().numEvaluations();
+        CHECK( numEvals > 0 );
+        CHECK_EQUAL( numEvals, G.cache().numHits() );
+
+        A.initSystem();
+        A.assemble( (grad(u)*jac(G).ginv()) * (grad(u)*jac(G).ginv()).tr() * meas(G) );
+        const gsSparseMatrix<> K2 = A.matrix();
+
+        CHECK( K1.nonZeros() > 0 );
+        CHECK( (K1.toDense() - K2.toDense()).norm() <= 1e-12 * K2.toDense().norm() );
+
+        // the same value in a norm, with the sub-expression in two terms
+        gsExprEvaluator<> ev(A);
+        gsFunctionExpr<> ff("x*x*y", 2);
+        gsExprEvaluator<>::variable f = ev.getVariable(ff, G);
+        const real_t v1 = ev.integral( (igrad(f, G) - igrad(f, G)*2).sqNorm() * meas(G) );
+        // the same points as above, and a hit for the second occurrence
+        CHECK_EQUAL( numEvals, G.cache().numEvaluations() );
+        CHECK_EQUAL( numEvals, G.cache().numHits() );
+        const real_t v2 = ev.integral( (grad(f)*jac(G).ginv()).sqNorm() * meas(G) );
+        CHECK_CLOSE( v2, v1, 1e-12 * v2 );
+    }
+
+    TEST(BatchedIntegration)
+    {
+        gsMultiPatch<> mp( *gsNurbsCreator<>::BSplineFatQuarterAnnulus() );
+        gsMultiBasis<> mb(mp);
+        mb.uniformRefine(1);
+
+        gsExprAssembler<> A(1,1);
+        A.setIntegrationElements(mb);
+        gsExprAssembler<>::geometryMap G = A.getMap(mp);
+        gsExprAssembler<>::space u = A.getSpace(mb);
+        gsFunctionExpr<> ff("x*y+1", 2);
+        gsExprAssembler<>::variable f = A.getCoeff(ff, G);
+
+        // fused products over all quadrature points
+        A.initSystem();
+        A.assemble( (igrad(u, G) * igrad(u, G).tr() + 2 * u * u.tr()) * meas(G),
+                    u * f * meas(G) );
+        const gsMatrix<> K1 = A.matrix().toDense(), b1 = A.rhs();
+
+        // point-by-point evaluation, temp() is not batched
+        A.initSystem();
+        A.assemble( ((igrad(u, G) * igrad(u, G).tr() + 2 * u * u.tr()) * meas(G)).temp(),
+                    (u * f * meas(G)).temp() );
+        const gsMatrix<> K2 = A.matrix().toDense(), b2 = A.rhs();
+
+        CHECK( K1.norm() > 0 );
+        CHECK( (K1 - K2).norm() <= 1e-12 * K2.norm() );
+        CHECK( (b1 - b2).norm() <= 1e-12 * b2.norm() );
+    }
+}
@@ -0,0 +1,144 @@
+/** @file gsHFitting_test.cpp
+
+    @brief Tests hierarchical fitting of point clouds, in memory and
+    streamed from files
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "gismo_unittest.h"
+
+SUITE(gsHFitting_test)
+{
+    // Samples a surface on a grid, parameters in [0,1]^2
+    void samplePoints(gsMatrix<> & params, gsMatrix<> & points)
+    {
+        gsMatrix<> ab(2,2);
+        ab << 0, 1, 0, 1;
+        params = gsPointGrid(ab, 900);
+        gsFunctionExpr<> f("x", "y", "sin(3*x)*cos(2*y)+x*y", 2);
+        f.eval_into(params, points);
+    }
+
+    TEST(PointCloudReader)
+    {
+        gsMatrix<> params, points, p, q;
+        samplePoints(params, points);
+
+        const std::string fn = gsFileManager::getTempPath() + "gsHFitting_test.csv";
+        std::ofstream file(fn.c_str());
+        file << "# u, v, x, y, z\n" << std::setprecision(REAL_DIG+2);
+        for (index_t k = 0; k != params.cols(); ++k)
+            file << params(0,k) <<", "<< params(1,k) <<", "<< points(0,k)
+                 <<", "<< points(1,k) <<", "<< points(2,k) <<"\n";
+        file.close();
+
+        gsPointCloudReader<> reader(fn, 2, 3, 256);
+        index_t n = 0;
+        while ( reader.next(p, q) )
+        {
+            CHECK( p.cols() <= 256 );
+            CHECK( (p - params.middleCols(n, p.cols())).isZero(1e-10) );
+            CHECK( (q - points.middleCols(n, q.cols())).isZero(1e-10) );
+            n += p.cols();
+        }
+        CHECK_EQUAL( params.cols(), n );
+        std::remove(fn.c_str());
+    }
+
+    TEST(StreamedFitting)
+    {
+        gsMatrix<> params, points;
+        samplePoints(params, points);
+
+        const std::string fn = gsFileManager::getTempPath() + "gsHFitting_test.bin";
+        std::ofstream file(fn.c_str(), std::ios::binary);
+        gsMatrix<> rec(5, params.cols());
+        rec << params, points;
+        file.write(reinterpret_cast<const char*>(rec.data()), rec.size()*sizeof(real_t));
+        file.close();
+
+        gsKnotVector<> kv(0, 1, 3, 3);
+        gsTensorBSplineBasis<2> tbasis(kv, kv);
+        std::vector<unsigned> ext(2, 2);
+
+        gsTHBSplineBasis<2> thb(tbasis);
+        gsHFitting<2, real_t> ref(params, points, thb, 0.1, ext);
+        ref.iterativeRefine(2, 1e-6, 1e-4);
+
+        gsTHBSplineBasis<2> thbStream(tbasis);
+        gsHFitting<2, real_t> fit(thbStream, 0.1, ext);
+        gsPointCloudReader<> reader(fn, 2, 3, 100, true);
+        fit.iterativeRefine(reader, 2, 1e-6, 1e-4);
+        std::remove(fn.c_str());
+
+        // Same refinement decisions and fitted result
+        CHECK_EQUAL( thb.size(), thbStream.size() );
+        CHECK( (ref.result()->coefs() - fit.result()->coefs()).isZero(1e-8) );
+        CHECK_CLOSE( ref.maxPointError(), fit.maxPointError(), 1e-10 );
+
+        index_t numPoints = 0;
+        real_t maxErr = 0;
+        typedef gsHFitting<2, real_t>::cellErrorMap::const_iterator cIter;
+        for (cIter it = fit.cellErrors().begin(); it != fit.cellErrors().end(); ++it)
+        {
+            numPoints += it->second.numPoints;
+            maxErr = math::max(maxErr, it->second.maxErr);
+        }
+        CHECK_EQUAL( params.cols(), numPoints );
+        CHECK_CLOSE( fit.maxPointError(), maxErr, 1e-12 );
+    }
+
+    TEST(ElementErrors)
+    {
+        gsMatrix<> params, points;
+        samplePoints(params, points);
+
+        gsKnotVector<> kv(0, 1, 3, 3);
+        gsTensorBSplineBasis<2> tbasis(kv, kv);
+        gsTHBSplineBasis<2> thb(tbasis);
+        std::vector<unsigned> ext(2, 1);
+        gsHFitting<2, real_t> fit(params, points, thb, 0.2, ext);
+        fit.iterativeRefine(1, 1e-6);
+
+        // The element-wise statistics aggregate the point-wise errors
+        const std::vector<real_t> & pErr = fit.pointWiseErrors();
+        CHECK_EQUAL( params.cols(), (index_t)pErr.size() );
+        real_t sqErr = 0;
+        for (size_t k = 0; k != pErr.size(); ++k)
+            sqErr += pErr[k] * pErr[k];
+
+        index_t numPoints = 0;
+        real_t maxErr = 0, cellSqErr = 0;
+        typedef gsHFitting<2, real_t>::cellErrorMap::const_iterator cIter;
+        for (cIter it = fit.cellErrors().begin(); it != fit.cellErrors().end(); ++it)
+        {
+            numPoints += it->second.numPoints;
+            cellSqErr += it->second.sqErr;
+            maxErr = math::max(maxErr, it->second.maxErr);
+        }
+        CHECK_EQUAL( params.cols(), numPoints );
+        CHECK_CLOSE( fit.maxPointError(), maxErr, 1e-12 );
+        CHECK_CLOSE( sqErr, cellSqErr, 1e-10 );
+
+        real_t approxErr = 0;
+        fit.computeApproxError(approxErr, 0);
+        CHECK_CLOSE( sqErr, approxErr, 1e-10 );
+
+        // Through the base class the statistics are computed as well
+        gsTHBSplineBasis<2> thb2(tbasis);
+        gsHFitting<2, real_t> fit2(params, points, thb2, 0.2, ext);
+        fit2.compute();
+        CHECK( fit2.cellErrors().empty() );
+        gsFitting<> & base = fit2;
+        base.computeErrors();
+        numPoints = 0;
+        for (cIter it = fit2.cellErrors().begin(); it != fit2.cellErrors().end(); ++it)
+            numPoints += it->second.numPoints;
+        CHECK_EQUAL( params.cols(), numPoints );
+    }
+}
@@ -0,0 +1,102 @@
+/** @file gsHeatTimeStepper_test.cpp
+
+    @brief Tests the time integration schemes of gsHeatTimeStepper.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+**/
+
+#include "gismo_unittest.h"
+
+SUITE(gsHeatTimeStepper_test)
+{
+
+struct HeatFixture
+{
+    HeatFixture()
+    : mp(*gsNurbsCreator<>::BSplineSquare(1.0, 0.0, 0.0)), mb(mp),
+      f("1", 2), zero("0", 2)
+    {
+        mb.degreeElevate();
+        mb.uniformRefine();
+        mb.uniformRefine();
+        mb.uniformRefine();
+        for (gsMultiPatch<>::const_biterator it = mp.bBegin(); it != mp.bEnd(); ++it)
+            bc.addCondition(*it, condition_type::dirichlet, &zero);
+    }
+
+    // Semi-discrete solution at time t, by the eigenvectors of
+    // K v = lambda M v, starting from zero
+    gsMatrix<> exact(const gsHeatEquation<real_t> & heat, const real_t t) const
+    {
+        const gsMatrix<> K = heat.stationaryMatrix().toDense();
+        const gsMatrix<> M = heat.mass().toDense();
+        gsMatrix<>::GenSelfAdjEigenSolver ges(K, M);
+        const gsMatrix<> us = K.partialPivLu().solve(heat.stationaryRhs());
+        const gsMatrix<> & V = ges.eigenvectors();
+        const gsMatrix<> e = (-t * ges.eigenvalues().array()).exp().matrix();
+        return us - V * e.asDiagonal() * V.transpose() * M * us;
+    }
+
+    gsMultiPatch<> mp;
+    gsMultiBasis<> mb;
+    gsFunctionExpr<> f, zero;
+    gsBoundaryConditions<> bc;
+};
+
+TEST_FIXTURE(HeatFixture, second_order)
+{
+    gsPoissonAssembler<> stationary(mp, mb, bc, f, dirichlet::elimination, iFace::glue);
+    gsHeatEquation<real_t> heat(stationary);
+    heat.assemble();
+    const real_t endTime = 0.1;
+    const gsMatrix<> ex = exact(heat, endTime);
+
+    gsHeatTimeStepper<real_t> stepper(heat);
+    for (index_t s = gsHeatTimeStepper<real_t>::theta; s <= gsHeatTimeStepper<real_t>::sdirk2; ++s)
+    {
+        stepper.options().setInt("Scheme", s);
+        real_t err[2];
+        for (index_t k = 0; k != 2; ++k)
+        {
+            stepper.reset();
+            gsMatrix<> u = gsMatrix<>::Zero(heat.numDofs(), 1);
+            const index_t n = 10 << k;
+            CHECK_EQUAL(n, stepper.integrate(u, 0, endTime, endTime / n));
+            err[k] = (u - ex).norm() / ex.norm();
+
+            // One matrix for the fixed step, and one for the first
+            // (SDIRK2) step of BDF2
+            CHECK_EQUAL(gsHeatTimeStepper<real_t>::bdf2 == s ? 2 : 1,
+                        stepper.numFactorizations());
+        }
+        CHECK( err[1] < 1e-2 );
+        CHECK( err[0] / err[1] > 3 );
+    }
+}
+
+TEST_FIXTURE(HeatFixture, adaptive)
+{
+    gsPoissonAssembler<> stationary(mp, mb, bc, f, dirichlet::elimination, iFace::glue);
+    gsHeatEquation<real_t> heat(stationary);
+    heat.assemble();
+    const real_t endTime = 0.5;
+    const gsMatrix<> ex = exact(heat, endTime);
+
+    gsHeatTimeStepper<real_t> stepper(heat);
+    stepper.options().setSwitch("Adaptive", true);
+    stepper.options().setReal("Tolerance", 1e-5);
+    gsMatrix<> u = gsMatrix<>::Zero(heat.numDofs(), 1);
+    const index_t steps = stepper.integrate(u, 0, endTime, 1e-3);
+    CHECK( (u - ex).norm() <= 1e-3 * ex.norm() );
+
+    // The steps grow as the solution becomes stationary, and the
+    // factorizations are shared by the steps of the same size
+    CHECK( steps < 500 );
+    CHECK( stepper.numFactorizations() < steps );
+}
+
+}
@@ -97,4 +97,38 @@ SUITE(gsKronecker_test)
         CHECK_EQUAL ( sB.toDense(), sC.toDense() );
     }
 
+
+    TEST(TensorInterpolation)
+    {
+        gsKnotVector<> kv(0,1,4,3), kw(0,1,2,4);
+        gsTensorBSplineBasis<3> tb(kv,kw,kv);
+        gsFunctionExpr<> f("x^2*y+z+x*z*y", 3);
+
+        // Points on a tensor-grid are interpolated coordinate-wise
+        gsMatrix<> anc = tb.anchors();
+        gsMatrix<> val = f.eval(anc);
+        gsGeometry<>::uPtr g1 = tb.interpolateData(val, anc);
+        gsGeometry<>::uPtr g2 = tb.gsBasis<>::interpolateData(val, anc);
+        CHECK( (g1->coefs()-g2->coefs()).isZero(1e-10) );
+
+        std::vector<gsMatrix<> > grid;
+        CHECK( tb.isTensorGrid(anc, grid) );
+        anc(0,1) += 0.001;
+        CHECK( !tb.isTensorGrid(anc, grid) );
+    }
+
+    TEST(TensorL2Projection)
+    {
+        gsKnotVector<> kv(0,1,4,4), kw(0,1,2,3);
+        gsTensorBSplineBasis<2> tb(kv,kw);
+        gsFunctionExpr<> f("x^3*y+x*y^2+1","x-y", 2);
+
+        // f lies in the spline space, hence it is reproduced
+        gsGeometry<>::uPtr g = tb.projectL2(f);
+        gsMatrix<> ab(2,2);
+        ab << 0, 1, 0, 1;
+        gsMatrix<> pts = gsPointGrid(ab, 25);
+        CHECK( (g->eval(pts)-f.eval(pts)).isZero(1e-10) );
+    }
+
 }
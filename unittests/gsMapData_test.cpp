@@ -0,0 +1,89 @@
+/** @file gsMapData_test.cpp
+
+    @brief Tests the geometric quantities of gsMapData and the
+    transformation of gradients.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+**/
+
+#include "gismo_unittest.h"
+
+SUITE(gsMapData_test)
+{
+
+TEST(planar_gradients)
+{
+    gsTensorBSpline<2,real_t>::uPtr geo = gsNurbsCreator<>::BSplineFatQuarterAnnulus();
+    gsMatrix<> pts(2,3);
+    pts << 0.1, 0.5, 0.9,
+           0.2, 0.7, 0.3;
+    gsMatrix<> grads;
+    geo->basis().deriv_into(pts, grads);
+
+    // With and without the transformation matrices of computeMap
+    gsMapData<> md1(NEED_GRAD_TRANSFORM), md2(NEED_DERIV);
+    md1.points = md2.points = pts;
+    geo->computeMap(md1);
+    geo->computeMap(md2);
+
+    gsMatrix<> phys1, phys2, expected;
+    const index_t numGrads = grads.rows() / 2;
+    for (index_t k = 0; k != pts.cols(); ++k)
+    {
+        transformGradients(md1, k, grads, phys1);
+        transformGradients(md2, k, grads, phys2);
+        expected = md2.jacobian(k).transpose().inverse() *
+            gsAsConstMatrix<>(grads.col(k).data(), 2, numGrads);
+        CHECK( (expected - phys1).norm() <= 1e-10 );
+        CHECK( (expected - phys2).norm() <= 1e-10 );
+    }
+}
+
+TEST(surface_gradients)
+{
+    // A curved surface in 3D
+    gsKnotVector<> kv(0, 1, 0, 3);
+    gsTensorBSplineBasis<2,real_t> basis(kv, kv);
+    gsMatrix<> coefs(9,3);
+    coefs << 0, 0, 0,  0.5, 0, 0.2,  1, 0, 0,
+             0, 0.5, 0.3,  0.5, 0.5, 0.8,  1, 0.5, 0.1,
+             0, 1, 0,  0.5, 1, 0.4,  1, 1, 0;
+    gsTensorBSpline<2,real_t> geo(basis, coefs);
+
+    gsMatrix<> pts(2,2);
+    pts << 0.3, 0.8,
+           0.6, 0.1;
+    gsMatrix<> grads;
+    basis.deriv_into(pts, grads);
+
+    gsMapData<> md1(NEED_GRAD_TRANSFORM|NEED_NORMAL), md2(NEED_DERIV);
+    md1.points = md2.points = pts;
+    geo.computeMap(md1);
+    geo.computeMap(md2);
+
+    gsMatrix<> phys1, phys2;
+    gsVector<> nv;
+    const index_t numGrads = grads.rows() / 2;
+    for (index_t k = 0; k != pts.cols(); ++k)
+    {
+        transformGradients(md1, k, grads, phys1);
+        transformGradients(md2, k, grads, phys2);
+        CHECK_EQUAL(3, phys1.rows());
+        CHECK( (phys1 - phys2).norm() <= 1e-10 );
+
+        // Tangential gradients: they recover the parametric
+        // derivatives and are orthogonal to the normal
+        const gsMatrix<> jac = md2.jacobian(k);
+        CHECK( (gsAsConstMatrix<>(grads.col(k).data(), 2, numGrads)
+                - jac.transpose() * phys1).norm() <= 1e-10 );
+        normal(md1, k, nv);
+        CHECK( (md1.normal(k) - nv).norm() <= 1e-12 );
+        CHECK( (nv.transpose() * phys1).norm() <= 1e-10 );
+    }
+}
+
+}
@@ -0,0 +1,66 @@
+/** @file gsParametrization_test.cpp
+
+    @brief Tests the parametrization of triangle meshes
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "gismo_unittest.h"
+
+SUITE(gsParametrization_test)
+{
+    // A bump over the unit square, each cell split into two triangles
+    gsMesh<> * bumpMesh(index_t n)
+    {
+        gsMesh<> * mesh = new gsMesh<>();
+        std::vector<gsMesh<>::VertexHandle> v;
+        for (index_t j = 0; j <= n; ++j)
+            for (index_t i = 0; i <= n; ++i)
+            {
+                const real_t x = (real_t)i / n, y = (real_t)j / n;
+                v.push_back(mesh->addVertex(x, y, x * (1-x) * y * (1-y)));
+            }
+        for (index_t j = 0; j != n; ++j)
+            for (index_t i = 0; i != n; ++i)
+            {
+                const index_t k = j * (n+1) + i;
+                mesh->addFace(v[k], v[k+n+1], v[k+1]);
+                mesh->addFace(v[k+1], v[k+n+1], v[k+n+2]);
+            }
+        return mesh;
+    }
+
+    TEST(Bump)
+    {
+        const index_t n = 12;
+        gsMesh<>::uPtr mesh( bumpMesh(n) );
+
+        for (index_t method = 1; method <= 3; ++method)
+        {
+            gsOptionList opt = gsParametrization<real_t>::defaultOptions();
+            opt.setInt("parametrizationMethod", method);
+            gsParametrization<real_t> pm(*mesh, opt);
+            pm.compute();
+            gsMatrix<> uv = pm.createUVmatrix();
+            CHECK_EQUAL( (index_t)((n+1)*(n+1)), uv.cols() );
+
+            // the inner points are convex combinations of their
+            // neighbours, hence inside the square, the boundary
+            // points are on its boundary
+            index_t onBoundary = 0;
+            for (index_t i = 0; i != uv.cols(); ++i)
+            {
+                CHECK( uv.col(i).minCoeff() >= -1e-12 );
+                CHECK( uv.col(i).maxCoeff() <= 1 + 1e-12 );
+                const real_t dist = math::min( uv.col(i).minCoeff(), 1 - uv.col(i).maxCoeff() );
+                if (dist < 1e-12)
+                    ++onBoundary;
+            }
+            CHECK_EQUAL( 4*n, onBoundary );
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/** @file gsPatchGenerator_test.cpp
+
+    @brief Tests the batched computation of patches from boundaries
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "gismo_unittest.h"
+
+SUITE(gsPatchGenerator_test)
+{
+    // Boundary curves of the square [0,s]^2, with a bumped bottom side
+    gsMultiPatch<> squareBoundary(index_t n, real_t s, real_t bump)
+    {
+        gsKnotVector<> kv(0, 1, n, 3);
+        gsBSplineBasis<> basis(kv);
+        gsMatrix<> g;
+        kv.greville_into(g);
+        g = g.transpose() * s;
+        const index_t nc = g.rows();
+        gsMatrix<> c(nc, 2);
+        gsMultiPatch<> bnd;
+
+        c.col(0) = g;
+        c.col(1).setZero();
+        c.col(1).segment(1, nc-2).setConstant(bump);
+        bnd.addPatch( gsBSpline<>(basis, c) );// bottom
+        c.col(1).setConstant(s);
+        bnd.addPatch( gsBSpline<>(basis, c) );// top
+        c.col(0).setZero();
+        c.col(1) = g;
+        bnd.addPatch( gsBSpline<>(basis, c) );// left
+        c.col(0).setConstant(s);
+        bnd.addPatch( gsBSpline<>(basis, c) );// right
+        return bnd;
+    }
+
+    TEST(BatchedSpringPatch)
+    {
+        std::vector< gsMultiPatch<> > boundaries;
+        for (index_t i = 0; i != 6; ++i)
+            boundaries.push_back( squareBoundary(2 + i%2, 1 + i, 0.1 * i) );
+
+        gsMultiPatch<> result = computePatches< gsSpringPatch<real_t> >(boundaries);
+        CHECK_EQUAL( boundaries.size(), result.nPatches() );
+
+        // Same patches as computed one by one
+        for (size_t i = 0; i != boundaries.size(); ++i)
+        {
+            gsSpringPatch<real_t> spring(boundaries[i]);
+            const gsGeometry<> & patch = spring.compute();
+            CHECK_EQUAL( patch.coefs().rows(), result.patch(i).coefs().rows() );
+            CHECK( (patch.coefs() - result.patch(i).coefs()).isZero(1e-10) );
+        }
+    }
+
+    TEST(BatchedCoonsPatch)
+    {
+        std::vector< gsMultiPatch<> > boundaries;
+        for (index_t i = 0; i != 4; ++i)
+            boundaries.push_back( squareBoundary(3, 2, 0.2 * i) );
+
+        gsMultiPatch<> result = computePatches< gsCoonsPatch<real_t> >(boundaries);
+        CHECK_EQUAL( boundaries.size(), result.nPatches() );
+        for (size_t i = 0; i != boundaries.size(); ++i)
+        {
+            gsCoonsPatch<real_t> coons(boundaries[i]);
+            CHECK( (coons.compute().coefs() - result.patch(i).coefs()).isZero(1e-12) );
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/** @file gsPlanarDomain_test.cpp
+
+    @brief Tests the triangulation of planar domains
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "gismo_unittest.h"
+
+SUITE(gsPlanarDomain_test)
+{
+    // Closed polygon through the rows of c, as a linear B-spline
+    gsCurve<> * polygon(gsMatrix<> const & c)
+    {
+        gsMatrix<> cc(c.rows()+1, 2);
+        cc << c, c.row(0);
+        gsKnotVector<> kv(0, 1, c.rows()-1, 2);
+        return new gsBSpline<>(gsBSplineBasis<>(kv), cc);
+    }
+
+    // Signed area of the triangles of a mesh, and the smallest one
+    real_t meshArea(gsMesh<> const & mesh, real_t & minArea)
+    {
+        real_t area = 0;
+        minArea = std::numeric_limits<real_t>::max();
+        for (size_t f = 0; f != mesh.numFaces(); ++f)
+        {
+            const std::vector<gsVertex<real_t>*> & v = mesh.faces()[f]->vertices;
+            const real_t a = ( (v[1]->x()-v[0]->x()) * (v[2]->y()-v[0]->y())
+                             - (v[1]->y()-v[0]->y()) * (v[2]->x()-v[0]->x()) ) / 2;
+            area += a;
+            minArea = math::min(minArea, a);
+        }
+        return area;
+    }
+
+    TEST(ConstrainedDelaunay)
+    {
+        // Square with a square hole, sampled with 8 points per side
+        gsMatrix<> outer(2, 32), hole(2, 32);
+        for (index_t i = 0; i != 8; ++i)
+        {
+            const real_t s = i / 8.0;
+            outer.col(i   ) << s, 0;
+            outer.col(i+ 8) << 1, s;
+            outer.col(i+16) << 1-s, 1;
+            outer.col(i+24) << 0, 1-s;
+        }
+        hole = outer.array() / 2 + 0.25;
+
+        gsConstrainedDelaunay<real_t> cdt;
+        cdt.addLoop(outer);
+        cdt.addLoop(hole);
+        for (index_t i = 1; i != 16; ++i) // lattice, partly in the hole
+            for (index_t j = 1; j != 16; ++j)
+                cdt.addPoint(i / 16.0 + 0.01, j / 16.0 + 0.02);
+        cdt.compute();
+
+        gsMesh<>::uPtr mesh = cdt.toMesh();
+        real_t minArea;
+        CHECK_CLOSE( 0.75, meshArea(*mesh, minArea), 1e-12 );
+        CHECK( minArea > 0 );
+        CHECK_EQUAL( cdt.numTriangles(), (index_t)mesh->numFaces() );
+    }
+
+    TEST(Classifier)
+    {
+        // Cubic closed curve around the origin with a square hole
+        const index_t n = 16;
+        gsKnotVector<> kv(0, 1, n-4, 4);
+        gsMatrix<> c(n, 2);
+        for (index_t i = 0; i != n-1; ++i)
+        {
+            const real_t a = 2 * EIGEN_PI * i / (n-1);
+            c.row(i) << (1 + 0.2 * math::cos(3*a)) * math::cos(a),
+                        (1 + 0.2 * math::cos(3*a)) * math::sin(a);
+        }
+        c.row(n-1) = c.row(0);
+        gsMatrix<> h(4,2);
+        h << -0.3, -0.3,  -0.3, 0.3,  0.3, 0.3,  0.3, -0.3; // clockwise
+
+        std::vector<gsCurveLoop<>*> loops;
+        loops.push_back( new gsCurveLoop<>( new gsBSpline<>(kv, c) ) );
+        loops.push_back( new gsCurveLoop<>( polygon(h) ) );
+        gsPlanarDomain<> domain(loops);
+
+        gsPlanarDomainClassifier<real_t> pdc(domain, 1e-3);
+        CHECK( pdc.numSegments() > n );
+
+        gsMatrix<> u(2, 60*60);
+        for (index_t i = 0; i != 60; ++i)
+            for (index_t j = 0; j != 60; ++j)
+                u.col(60*i+j) << -1.4 + 2.8 * (i + 0.3) / 60, -1.4 + 2.8 * (j + 0.6) / 60;
+        gsVector<index_t> inside;
+        const index_t exact = pdc.inDomain_into(u, inside);
+        CHECK( exact > 0 && exact < u.cols() / 10 );
+
+        // same result as the exact test, point by point
+        index_t wrong = 0, count = 0;
+        for (index_t k = 0; k != u.cols(); ++k)
+        {
+            count += inside[k];
+            if ( (1 == inside[k]) != domain.inDomain(u.col(k)) )
+                ++wrong;
+        }
+        CHECK_EQUAL( 0, wrong );
+        CHECK( count > 0 );
+    }
+
+    TEST(PlanarDomainMesh)
+    {
+        gsMatrix<> c(4,2);
+        c << 0, 0,  2, 0,  2, 1,  0, 1;
+        gsMatrix<> h(4,2);
+        h << 0.5, 0.25,  0.5, 0.75,  1, 0.75,  1, 0.25; // clockwise
+
+        std::vector<gsCurveLoop<>*> loops;
+        loops.push_back( new gsCurveLoop<>( polygon(c) ) );
+        loops.push_back( new gsCurveLoop<>( polygon(h) ) );
+        gsPlanarDomain<> domain(loops);
+
+        gsMesh<>::uPtr mesh = domain.toMesh(20);
+        real_t minArea;
+        CHECK_CLOSE( 1.75, meshArea(*mesh, minArea), 1e-10 );
+        CHECK( minArea > 0 );
+        CHECK( mesh->numVertices() > 20 * 20 );
+    }
+}
@@ -160,6 +160,150 @@ SUITE(gsPoissonSolver_test)
     {
         runPoissonSolverTest(dirichlet::nitsche, iFace::dg);
     }
+
+    // Poisson assembler with access to the factorization of the
+    // L2 projection of the Dirichlet values
+    class ddofPoissonAssembler : public gsPoissonAssembler<real_t>
+    {
+    public:
+        ddofPoissonAssembler(const gsPoissonPde<real_t> & pde, const gsMultiBasis<real_t> & bases)
+        : gsPoissonAssembler<real_t>(pde, bases) { }
+
+        const void * ddofSolver() const
+        { return m_ddofSolver.empty() ? NULL : m_ddofSolver.front().get(); }
+    };
+
+    TEST(DirichletValues_test)
+    {
+        // A bilinear function is represented exactly, hence the L2
+        // projection and the interpolation give the same values
+        gsFunctionExpr<> f("0",2), g("x*y+2*x-y",2);
+        gsMultiPatch<> patches = gsNurbsCreator<>::BSplineSquareGrid(2, 2, 0.5);
+        gsBoundaryConditions<> bcInfo;
+        for (gsMultiPatch<>::const_biterator it = patches.bBegin(); it != patches.bEnd(); ++it)
+            bcInfo.addCondition(*it, condition_type::dirichlet, &g);
+        gsPoissonPde<> pde(patches, bcInfo, f);
+        gsMultiBasis<> bases(patches);
+        bases.degreeElevate();
+        bases.uniformRefine();
+
+        for (index_t r = 0; r != 2; ++r)
+        {
+            ddofPoissonAssembler poisson(pde, bases);
+            poisson.options().setInt("DirichletValues", dirichlet::interpolation);
+            poisson.computeDirichletDofs();
+            const gsMatrix<> intpl = poisson.fixedDofs();
+            CHECK( NULL == poisson.ddofSolver() );
+
+            poisson.options().setInt("DirichletValues", dirichlet::l2Projection);
+            poisson.computeDirichletDofs();
+            CHECK( (poisson.fixedDofs() - intpl).norm() < 1e-10 * intpl.norm() );
+            const void * solver = poisson.ddofSolver();
+            CHECK( NULL != solver );
+
+            // Second computation reuses the boundary mass factorization
+            poisson.computeDirichletDofs();
+            CHECK( (poisson.fixedDofs() - intpl).norm() < 1e-10 * intpl.norm() );
+            CHECK( solver == poisson.ddofSolver() );
+
+            // New Dirichlet values with the same factorization give
+            // the values of a new assembler
+            g = gsFunctionExpr<>("2*(x*y+2*x-y)",2);
+            poisson.computeDirichletDofs();
+            CHECK( solver == poisson.ddofSolver() );
+            ddofPoissonAssembler fresh(pde, bases);
+            fresh.options().setInt("DirichletValues", dirichlet::l2Projection);
+            fresh.computeDirichletDofs();
+            CHECK( solver != fresh.ddofSolver() );
+            CHECK( (poisson.fixedDofs() - fresh.fixedDofs()).norm() < 1e-10 * intpl.norm() );
+            CHECK( (poisson.fixedDofs() - 2 * intpl).norm() < 1e-10 * intpl.norm() );
+            g = gsFunctionExpr<>("x*y+2*x-y",2);
+
+            // A refresh or a new geometry drops the factorization
+            poisson.refresh();
+            CHECK( NULL == poisson.ddofSolver() );
+            poisson.computeDirichletDofs();
+            CHECK( (poisson.fixedDofs() - intpl).norm() < 1e-10 * intpl.norm() );
+            CHECK( NULL != poisson.ddofSolver() );
+
+            gsMultiPatch<> patches2(patches);
+            patches2.patch(0).coefs() *= 2;
+            gsPoissonPde<> pde2(patches2, bcInfo, f);
+            poisson.initialize(pde2, bases, poisson.options());
+            CHECK( NULL == poisson.ddofSolver() );
+            poisson.computeDirichletDofs();
+            ddofPoissonAssembler fresh2(pde2, bases);
+            fresh2.options().setInt("DirichletValues", dirichlet::l2Projection);
+            fresh2.computeDirichletDofs();
+            CHECK( (poisson.fixedDofs() - fresh2.fixedDofs()).norm() < 1e-10 * intpl.norm() );
+
+            bases.uniformRefine();
+        }
+    }
+
+    TEST(PointLoads_test)
+    {
+        gsFunctionExpr<> f("1",2), g("0",2);
+        gsMultiPatch<> patches = gsNurbsCreator<>::BSplineSquareGrid(2, 2, 0.5);
+        gsBoundaryConditions<> bcInfo;
+        for (gsMultiPatch<>::const_biterator it = patches.bBegin(); it != patches.bEnd(); ++it)
+            bcInfo.addCondition(*it, condition_type::dirichlet, &g);
+        gsMultiBasis<> bases(patches);
+        bases.degreeElevate();
+        bases.uniformRefine();
+        bases.uniformRefine();
+        gsPoissonAssembler<> poisson(patches, bases, bcInfo, f);
+        poisson.assemble();
+        const gsMatrix<> rhs0 = poisson.rhs();
+
+        // Random loads on all patches, half of them in physical coordinates
+        const index_t n = 1000;
+        gsMatrix<> u = 0.5 * (gsMatrix<>::Random(2, n).array() + 1).matrix();
+        gsMatrix<> expected = gsMatrix<>::Zero(rhs0.rows(), 1);
+        gsPointLoads<real_t> pLoads;
+        gsMatrix<> bVals;
+        gsMatrix<index_t> act;
+        const gsDofMapper & mapper = poisson.system().rowMapper(0);
+        for (index_t j = 0; j != n; ++j)
+        {
+            const index_t k = j % 4;
+            const real_t val = 1 + j % 7;
+            gsVector<> pt = u.col(j);
+            if ( j % 2 )
+                pLoads.addLoad(pt, val, k);
+            else
+                pLoads.addLoad(patches.patch(k).eval(pt), val, k, false);
+
+            bases[k].eval_into(pt, bVals);
+            bases[k].active_into(pt, act);
+            for (index_t i = 0; i != act.rows(); ++i)
+            {
+                const index_t ii = mapper.index(act(i,0), k);
+                if ( mapper.is_free_index(ii) )
+                    expected(ii,0) += val * bVals(i,0);
+            }
+        }
+
+        poisson.assemblePointLoads(pLoads);
+        CHECK( (poisson.rhs() - rhs0 - expected).norm() < 1e-8 * expected.norm() );
+
+        // Probes of the solution at physical points, compared to
+        // the evaluation on the parameter domain of each patch
+        const gsMatrix<> sol = poisson.matrix().toDense().fullPivLu().solve(poisson.rhs());
+        const gsField<> field = poisson.constructSolution(sol);
+        gsMatrix<> x(2, n), vals;
+        for (index_t j = 0; j != n; ++j)
+            x.col(j) = patches.patch(j % 4).eval(u.col(j));
+        gsVector<index_t> pids;
+        gsMatrix<> pr;
+        field.probe_into(x, vals, &pids);
+        for (index_t j = 0; j != n; ++j)
+        {
+            CHECK( pids[j] >= 0 );
+            patches.patch(pids[j]).invertPoints(x.col(j), pr);
+            CHECK_CLOSE( field.value(pr, pids[j])(0,0), vals(0,j), 1e-8 );
+        }
+    }
     
 }
 
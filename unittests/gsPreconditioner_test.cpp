@@ -87,6 +87,25 @@ void runPreconditionerTest( index_t testcase )
         solver.solve(rhs,sol);
         CHECK ( solver.error() <= solver.tolerance() );
     }
+    else if (testcase==4)
+    {
+        // Preconditioner in single precision, full accuracy by CG
+        gsConjugateGradient<> solver(mat, gsPatchPreconditionersCreator<>::fastDiagonalizationOpSinglePrecision(mb[0],bc));
+        solver.setTolerance( 1.e-10 );
+        solver.setMaxIterations( 50 );
+        solver.solve(rhs,sol);
+        CHECK ( solver.error() <= solver.tolerance() );
+    }
+    else if (testcase==5)
+    {
+        // Iterative refinement of a factorization in single precision
+        gsGradientMethod<> solver(mat, makeMixedPrecisionSparseCholeskySolver<float>(mat), 1);
+        solver.setTolerance( 1.e-12 );
+        solver.setMaxIterations( 20 );
+        solver.solve(rhs,sol);
+        CHECK ( solver.error() <= solver.tolerance() );
+        CHECK ( (mat*sol-rhs).norm() <= 1.e-11 * rhs.norm() );
+    }
 }
 
 
@@ -109,6 +128,14 @@ SUITE(gsPreconditioner_test)
     {
         runPreconditionerTest(3);
     }
+    TEST(gsMixedPrecisionFastDiagonalization_test)
+    {
+        runPreconditionerTest(4);
+    }
+    TEST(gsMixedPrecisionRefinement_test)
+    {
+        runPreconditionerTest(5);
+    }
 
     TEST(gsPatchPreconditioner_stiff_test)
     {
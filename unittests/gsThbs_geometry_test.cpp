@@ -208,4 +208,79 @@ SUITE(gsThbs_geometry_test)
 
     }
 
+    TEST(many_points)
+    {
+        // Evaluation on many points at once agrees with the evaluation
+        // on every point alone
+        gsKnotVector<> kv(0, 1, 3, 3);
+        gsTensorBSplineBasis<2> tbasis(kv, kv);
+        gsTHBSplineBasis<2> THB(tbasis);
+        gsMatrix<> box(2,2);
+        box << 0, 0.5, 0, 0.5;
+        THB.refine(box);
+
+        const gsMatrix<> para = THB.support();
+        const gsVector<> c0 = para.col(0), c1 = para.col(1);
+        const gsMatrix<> pts = uniformPointGrid(c0, c1, 25);
+        gsMatrix<index_t> act, act1;
+        gsMatrix<> ev, ev1;
+        THB.active_into(pts, act);
+        for (index_t i = 0; i != pts.cols(); ++i)
+        {
+            THB.active_into(pts.col(i), act1);
+            CHECK( act1 == act.col(i).topRows(act1.rows()) );
+            CHECK( (act.col(i).bottomRows(act.rows()-act1.rows()).array()==0).all() );
+        }
+
+        // A row of the points is evaluated without a copy
+        const gsBSplineBasis<> & b1 = tbasis.component(1);
+        b1.eval_into(pts.row(1), ev1);
+        b1.evalRow_into(pts.row(1), ev);
+        CHECK( ev == ev1 );
+    }
+
+    TEST(evaluator)
+    {
+        gsKnotVector<> kv(0, 1, 3, 4);
+        gsTensorBSplineBasis<2> tbasis(kv, kv);
+        gsTHBSplineBasis<2> THB(tbasis);
+        gsMatrix<> box(2,2);
+        box << 0, 0.5, 0, 0.5;
+        THB.refine(box);
+        box << 0, 0.25, 0.25, 0.5;
+        THB.refine(box);
+
+        const gsMatrix<> para = THB.support();
+        const gsVector<> c0 = para.col(0), c1 = para.col(1);
+        const gsMatrix<> pts = uniformPointGrid(c0, c1, 30);
+
+        // Values and derivatives agree with the single evaluations
+        std::vector<gsMatrix<> > all;
+        gsMatrix<> ev, der, der2;
+        gsBasisEvaluator<real_t>::uPtr eval = THB.makeEvaluator();
+        for (int i = 0; i != 2; ++i) // the second call reuses the memory
+        {
+            eval->evalAllDers_into(pts, 2, all);
+            THB.eval_into  (pts, ev);
+            THB.deriv_into (pts, der);
+            THB.deriv2_into(pts, der2);
+            CHECK( (all[0] - ev  ).cwiseAbs().maxCoeff() < 1e-12 );
+            CHECK( (all[1] - der ).cwiseAbs().maxCoeff() < 1e-10 );
+            CHECK( (all[2] - der2).cwiseAbs().maxCoeff() < 1e-8  );
+        }
+
+        // The evaluator follows the refinement of the basis
+        box << 0.5, 1, 0.5, 1;
+        THB.refine(box);
+        eval->evalAllDers_into(pts, 1, all);
+        THB.eval_into  (pts, ev);
+        CHECK( (all[0] - ev).cwiseAbs().maxCoeff() < 1e-12 );
+
+        // Same for a tensor-product basis
+        gsBasisEvaluator<real_t>::uPtr teval = tbasis.makeEvaluator();
+        teval->evalAllDers_into(pts, 1, all);
+        tbasis.deriv_into(pts, der);
+        CHECK( (all[1] - der).cwiseAbs().maxCoeff() < 1e-12 );
+    }
+
 }
@@ -0,0 +1,75 @@
+/** @file gsTriMeshToSolid_test.cpp
+
+    @brief Tests the feature and patch detection of triangulated surfaces
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "gismo_unittest.h"
+
+SUITE(gsTriMeshToSolid_test)
+{
+    // The unit cube, each side split into n x n squares of two
+    // triangles. Every triangle gets its own vertices, as in an STL
+    // file.
+    gsMesh<> * cubeMesh(index_t n)
+    {
+        gsMesh<> * mesh = new gsMesh<>();
+        gsVector<> o(3), du(3), dv(3), p(3);
+        for (index_t s = 0; s != 6; ++s)
+        {
+            const index_t d = s / 2;
+            o.setZero(); du.setZero(); dv.setZero();
+            o[d] = s % 2;
+            du[(d+1)%3] = 1.0 / n;
+            dv[(d+2)%3] = 1.0 / n;
+            for (index_t i = 0; i != n; ++i)
+                for (index_t j = 0; j != n; ++j)
+                {
+                    p = o + (real_t)i * du + (real_t)j * dv;
+                    gsMesh<>::VertexHandle v0 = mesh->addVertex(p);
+                    gsMesh<>::VertexHandle v1 = mesh->addVertex(gsVector<>(p + du));
+                    gsMesh<>::VertexHandle v2 = mesh->addVertex(gsVector<>(p + du + dv));
+                    gsMesh<>::VertexHandle w0 = mesh->addVertex(p);
+                    gsMesh<>::VertexHandle w1 = mesh->addVertex(gsVector<>(p + du + dv));
+                    gsMesh<>::VertexHandle w2 = mesh->addVertex(gsVector<>(p + dv));
+                    mesh->addFace(v0, v1, v2);
+                    mesh->addFace(w0, w1, w2);
+                }
+        }
+        return mesh;
+    }
+
+    TEST(CubePatches)
+    {
+        const index_t n = 4;
+        gsMesh<>::uPtr mesh( cubeMesh(n) );
+        CHECK_EQUAL( (size_t)(36*n*n), mesh->numVertices() );
+
+        gsTriMeshToSolid<> tmts(mesh.get());
+        bool nonManifold, borders;
+        tmts.getFeatures(40, nonManifold, borders);
+        CHECK( !nonManifold );
+        CHECK( !borders );
+        // 6 sides with 3n^2 - 2n inner edges each, 12n edges on the cube edges
+        CHECK_EQUAL( 6*(3*n*n-2*n) + 12*n, tmts.numEdges );
+
+        // duplicated vertices are merged, keeping the first one
+        mesh->cleanMesh();
+        CHECK_EQUAL( (size_t)(6*n*n+2), mesh->numVertices() );
+
+        tmts.calcPatchNumbers();
+        CHECK_EQUAL( 6, tmts.numBigFaces );
+        for (size_t f = 0; f != mesh->numFaces(); ++f)
+            CHECK_EQUAL( (int)(f / (2*n*n)) + 1, mesh->faces()[f]->faceIdentity );
+
+        tmts.storeNeighboringFaces();
+        tmts.divideAndMergePatches(15, 0.2, 0);
+        tmts.calcPatchNumbers();
+        CHECK_EQUAL( 6, tmts.numBigFaces );
+    }
+}
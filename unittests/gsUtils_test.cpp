@@ -294,4 +294,50 @@ TEST(name)
         util::type<gsGenericGeometry<2> >::name());
 #endif
 }
+
+TEST(profiler)
+{
+    gsProfiler & prof = gsProfiler::get();
+    prof.clear();
+    {
+        gsProfilerScope outer("outer");
+        for (index_t i = 0; i != 3; ++i)
+        {
+            gsProfilerScope inner("inner");
+            prof.count(gsProfiler::elements, 2);
+        }
+    }
+    CHECK_EQUAL(1, prof.timing("outer").calls);
+    CHECK_EQUAL(3, prof.timing("outer/inner").calls);
+    CHECK_EQUAL(0, prof.timing("inner").calls);
+    CHECK(prof.timing("outer").wall >= prof.timing("outer/inner").wall);
+    CHECK_EQUAL(6, prof.total(gsProfiler::elements));
+    CHECK_EQUAL(0, prof.total(gsProfiler::spmv));
+
+    std::stringstream ss;
+    prof.printJson(ss);
+    CHECK(ss.str().find("\"outer/inner\": {\"calls\": 3") != std::string::npos);
+
+    prof.clear();
+    CHECK_EQUAL(0, prof.timing("outer").calls);
+
+    // more threads than slots: the samples of the extra threads
+    // (enter, count and leave) are dropped
+    index_t team = 1;
+#   pragma omp parallel num_threads(prof.numThreads() + 2)
+    {
+#       ifdef _OPENMP
+#       pragma omp single
+        team = omp_get_num_threads();
+#       endif
+        gsProfilerScope scope("parallel");
+        prof.count(gsProfiler::elements, 1);
+    }
+    const index_t used = std::min(team, prof.numThreads());
+    CHECK_EQUAL(used, prof.timing("parallel").calls);
+    CHECK_EQUAL(used, prof.total(gsProfiler::elements));
+    CHECK_EQUAL(3 * (team - used), prof.numDropped());
+    prof.clear();
+    CHECK_EQUAL(0, prof.numDropped());
+}
 }
@@ -0,0 +1,205 @@
+/** @file gsWorkspace_test.cpp
+
+    @brief Tests the scratch memory of element loops.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+**/
+
+#include "gismo_unittest.h"
+
+// Heap allocations are counted by replacing malloc, which serves both
+// operator new and the Eigen allocations. This is only done on glibc
+// and not under a sanitizer, which replaces malloc itself.
+#if defined(__has_feature)
+#  if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer) || __has_feature(thread_sanitizer)
+#    define GS_NO_MALLOC_COUNT
+#  endif
+#endif
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__) && !defined(GS_NO_MALLOC_COUNT)
+#  define GS_MALLOC_COUNT
+#endif
+
+namespace {
+long numMallocs = 0;   // allocations counted so far
+int  countMallocs = 0; // the calling thread counts its allocations
+#ifdef _OPENMP
+#pragma omp threadprivate(countMallocs)
+#endif
+}
+
+#ifdef GS_MALLOC_COUNT
+extern "C" void * __libc_malloc(size_t size);
+extern "C" void * malloc(size_t size)
+{
+    if (countMallocs)
+    {
+#       pragma omp atomic
+        ++numMallocs;
+    }
+    return __libc_malloc(size);
+}
+#endif
+
+SUITE(gsWorkspace_test)
+{
+
+// Poisson visitor which counts the heap allocations of its assemble()
+// and localToGlobal() steps
+class countingVisitorPoisson : public gsVisitorPoisson<real_t>
+{
+    typedef gsVisitorPoisson<real_t> Base;
+public:
+    countingVisitorPoisson(const gsPde<real_t> & pde) : Base(pde) { }
+
+    void assemble(gsDomainIterator<real_t> & element, const gsVector<real_t> & quWeights)
+    {
+        countMallocs = 1;
+        Base::assemble(element, quWeights);
+        countMallocs = 0;
+    }
+
+    void localToGlobal(const index_t patchIndex,
+                       const std::vector<gsMatrix<real_t> > & eliminatedDofs,
+                       gsSparseSystem<real_t> & system)
+    {
+        countMallocs = 1;
+        Base::localToGlobal(patchIndex, eliminatedDofs, system);
+        countMallocs = 0;
+    }
+};
+
+// Poisson assembler with an element loop of the counting visitor
+class countingPoissonAssembler : public gsPoissonAssembler<real_t>
+{
+public:
+    countingPoissonAssembler(const gsMultiPatch<real_t> & mp, const gsMultiBasis<real_t> & mb,
+                             const gsBoundaryConditions<real_t> & bc, const gsFunction<real_t> & f)
+    : gsPoissonAssembler<real_t>(mp, mb, bc, f) { }
+
+    // Runs the element loop again, returns the number of heap
+    // allocations of the counted visitor steps
+    long countedPass()
+    {
+        countingVisitorPoisson visitor(*m_pde_ptr);
+        numMallocs = 0;
+        for (size_t np = 0; np < m_pde_ptr->domain().nPatches(); ++np)
+            Base::apply(visitor, np);
+        return numMallocs;
+    }
+};
+
+// Binds the temporaries of a Poisson-like visitor on every element
+// of \a basis, returns the total number of active functions
+index_t elementLoop(const gsBasis<real_t> & basis, gsWorkspace<real_t> & ws)
+{
+    gsMatrix<index_t> actives;
+    gsAsMatrix<real_t> localMat(NULL, 0, 0), localRhs(NULL, 0, 0), physGrad(NULL, 0, 0);
+    index_t result = 0;
+
+    gsBasis<real_t>::domainIter domIt = basis.makeDomainIterator();
+    for (; domIt->good(); domIt->next() )
+    {
+        basis.active_into(domIt->centerPoint(), actives);
+        const index_t numActive = actives.rows();
+
+        ws.reset();
+        ws.bind(physGrad, basis.dim(), numActive);
+        ws.bind(localMat, numActive, numActive);
+        ws.bind(localRhs, numActive, 1);
+        localMat.setIdentity();
+        localRhs.setZero();
+        physGrad.setZero();
+        result += static_cast<index_t>(localMat.trace());
+    }
+    return result;
+}
+
+TEST(steady_state)
+{
+    gsTensorBSplineBasis<2> tbasis(gsKnotVector<>(0, 1, 3, 3), gsKnotVector<>(0, 1, 3, 3));
+    gsTHBSplineBasis<2> basis(tbasis);
+    gsMatrix<> box(2,2);
+    box << 0, 0.25, 0, 0.25;
+    basis.refine(box);
+    box << 0, 0.125, 0, 0.125;
+    basis.refine(box);
+
+    // The number of active functions varies over the elements
+    gsWorkspace<real_t> ws;
+    const index_t sum = elementLoop(basis, ws);
+    CHECK(ws.allocations() > 0);
+    CHECK(ws.capacity() > 0);
+
+    // After the first loop no more allocations take place
+    const index_t allocs = ws.allocations();
+    CHECK_EQUAL(sum, elementLoop(basis, ws));
+    CHECK_EQUAL(allocs, ws.allocations());
+    CHECK_EQUAL(sum, elementLoop(basis, ws));
+    CHECK_EQUAL(allocs, ws.allocations());
+}
+
+TEST(poisson_assembly)
+{
+    gsFunctionExpr<> f("2*pi^2*sin(pi*x)*sin(pi*y)", 2), g("0", 2);
+
+    for (short_t p = 1; p <= 3; ++p)
+    {
+        gsMultiPatch<> mp(*gsNurbsCreator<>::BSplineSquareDeg(p));
+        gsMultiBasis<> mb(mp);
+        mb.uniformRefine();
+        mb.uniformRefine();
+        gsBoundaryConditions<> bc;
+        for (gsMultiPatch<>::const_biterator it = mp.bBegin(); it != mp.bEnd(); ++it)
+            bc.addCondition(*it, condition_type::dirichlet, &g);
+
+        countingPoissonAssembler A(mp, mb, bc, f);
+        A.assemble();
+        const gsSparseMatrix<> K = A.matrix();
+        const gsMatrix<> rhs = A.rhs();
+
+        // The second pass adds to the existing entries of the system
+        const long count = A.countedPass();
+        CHECK( (A.matrix() - 2*K).norm() <= 1e-12 * K.norm() );
+        CHECK( (A.rhs() - 2*rhs).norm() <= 1e-12 * rhs.norm() );
+
+#ifdef GS_MALLOC_COUNT
+        // No heap allocations take place in the steady state
+        CHECK_EQUAL(0, count);
+#else
+        GISMO_UNUSED(count);
+#endif
+    }
+
+#ifdef GS_MALLOC_COUNT
+    // The counter sees a heap allocation
+    numMallocs = 0;
+    countMallocs = 1;
+    gsMatrix<> tmp(10, 10);
+    countMallocs = 0;
+    tmp.setZero();
+    CHECK(numMallocs > 0);
+#endif
+}
+
+TEST(copy)
+{
+    gsWorkspace<real_t> ws;
+    gsAsMatrix<real_t> m = ws.matrix(3, 4);
+    m.setOnes();
+    CHECK_EQUAL(1, ws.allocations());
+
+    // Copies own their memory and start empty
+    gsWorkspace<real_t> ws2(ws);
+    CHECK_EQUAL(0, ws2.allocations());
+    CHECK_EQUAL(0u, ws2.capacity());
+    gsAsMatrix<real_t> m2 = ws2.matrix(3, 4);
+    m2.setZero();
+    CHECK(m2.data() != m.data());
+    CHECK_EQUAL(12, m.sum());
+}
+
+}